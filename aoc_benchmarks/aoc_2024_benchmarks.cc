@@ -1,27 +0,0 @@
-#include "aoc_benchmarks.h"
-
-AOC_BENCHMARK(2024, 1);
-AOC_BENCHMARK(2024, 2);
-AOC_BENCHMARK(2024, 3);
-AOC_BENCHMARK(2024, 4);
-AOC_BENCHMARK(2024, 5);
-AOC_BENCHMARK(2024, 6);
-AOC_BENCHMARK(2024, 7);
-AOC_BENCHMARK(2024, 8);
-AOC_BENCHMARK(2024, 9);
-AOC_BENCHMARK(2024, 10);
-AOC_BENCHMARK(2024, 11);
-AOC_BENCHMARK(2024, 12);
-AOC_BENCHMARK(2024, 13);
-AOC_BENCHMARK(2024, 14);
-AOC_BENCHMARK(2024, 15);
-AOC_BENCHMARK(2024, 16);
-AOC_BENCHMARK(2024, 17);
-AOC_BENCHMARK(2024, 18);
-AOC_BENCHMARK(2024, 19);
-AOC_BENCHMARK(2024, 20);
-AOC_BENCHMARK(2024, 21);
-AOC_BENCHMARK(2024, 22);
-AOC_BENCHMARK(2024, 23);
-AOC_BENCHMARK(2024, 24);
-AOC_BENCHMARK(2024, 25);
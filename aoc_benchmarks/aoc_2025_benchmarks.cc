@@ -1,13 +1,16 @@
 #include "aoc_benchmarks.h"
 
-AOC_BENCHMARK(2025, 1);
-AOC_BENCHMARK(2025, 2);
-AOC_BENCHMARK(2025, 3);
-AOC_BENCHMARK(2025, 4);
-AOC_BENCHMARK(2025, 5);
-AOC_BENCHMARK(2025, 7);
-AOC_BENCHMARK(2025, 8);
-AOC_BENCHMARK(2025, 9);
-AOC_BENCHMARK(2025, 10);
-AOC_BENCHMARK(2025, 11);
-AOC_BENCHMARK(2025, 12);
+// Expected growth with the input size. Days 8 and 9 compare every pair of points, and day 10 already
+// takes most of a second at scale 1, so they are held to smaller scales.
+AOC_SCALED_BENCHMARK(2025, 1, 64, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 2, 64, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 3, 64, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 4, 64, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 5, 16, benchmark::oNSquared);
+AOC_SCALED_BENCHMARK(2025, 6, 64, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 7, 64, benchmark::oNLogN);
+AOC_SCALED_BENCHMARK(2025, 8, 4, benchmark::oNSquared);
+AOC_SCALED_BENCHMARK(2025, 9, 4, benchmark::oNSquared);
+AOC_SCALED_BENCHMARK(2025, 10, 8, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 11, 16, benchmark::oN);
+AOC_SCALED_BENCHMARK(2025, 12, 64, benchmark::oN);
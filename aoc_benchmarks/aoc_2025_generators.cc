@@ -0,0 +1,310 @@
+#include "aoc_generators.h"
+
+#include <absl/container/btree_set.h>
+
+#include <random>
+
+namespace aoc::generators {
+
+namespace {
+
+using Rng = std::mt19937_64;
+
+u64 Uniform(Rng& rng, const u64 from, const u64 to) {
+  return std::uniform_int_distribution<u64>(from, to)(rng);
+}
+
+// Side of a square grid holding `scale` times the cells of a `side` x `side` grid.
+u32 ScaledSide(const u32 side, const u32 scale) {
+  return static_cast<u32>(std::lround(side * std::sqrt(static_cast<double>(scale))));
+}
+
+// All three lowercase letter names, except the device names 2025/11 gives a meaning to.
+const std::vector<std::string>& DeviceNames() {
+  static const auto* names = [] {
+    const absl::flat_hash_set<std::string> reserved{"you", "out", "svr", "dac", "fft"};
+    auto* names = new std::vector<std::string>();
+    for (char a = 'a'; a <= 'z'; a++) {
+      for (char b = 'a'; b <= 'z'; b++) {
+        for (char c = 'a'; c <= 'z'; c++) {
+          std::string name{a, b, c};
+          if (!reserved.contains(name)) names->push_back(std::move(name));
+        }
+      }
+    }
+    return names;
+  }();
+  return *names;
+}
+
+}  // namespace
+
+// Dial rotations, one per line: "L68", "R48".
+template <>
+std::string Generate<2025, 1>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  std::string out;
+  for (u32 i = 0; i < 4500 * scale; i++) {
+    fmt::format_to(
+        std::back_inserter(out), "{}{}\n", Uniform(rng, 0, 1) ? 'R' : 'L', Uniform(rng, 1, 999));
+  }
+  return out;
+}
+
+// A single line of comma separated id ranges: "11-22,95-115".
+template <>
+std::string Generate<2025, 2>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  std::string out;
+  for (u32 i = 0; i < 35 * scale; i++) {
+    const u32 digits = Uniform(rng, 2, 10);
+    const u64 from = Uniform(rng, kTenPowers[digits - 1], kTenPowers[digits] - 1);
+    const u64 to = std::min(from + Uniform(rng, 0, 999'999), kTenPowers[10] - 1);
+    fmt::format_to(std::back_inserter(out), "{}{}-{}", i ? "," : "", from, to);
+  }
+  out.push_back('\n');
+  return out;
+}
+
+// Battery banks of 100 digits each.
+template <>
+std::string Generate<2025, 3>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  std::string out;
+  for (u32 i = 0; i < 200 * scale; i++) {
+    for (u32 j = 0; j < 100; j++) out.push_back(static_cast<char>('1' + Uniform(rng, 0, 8)));
+    out.push_back('\n');
+  }
+  return out;
+}
+
+// A square grid of paper rolls '@' and empty cells '.'. The solver derives the height from the
+// width, so the grid must not be taller than it is wide.
+template <>
+std::string Generate<2025, 4>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  const u32 side = ScaledSide(137, scale);
+  std::string out;
+  for (u32 i = 0; i < side; i++) {
+    for (u32 j = 0; j < side; j++) out.push_back(Uniform(rng, 0, 9) < 6 ? '@' : '.');
+    out.push_back('\n');
+  }
+  return out;
+}
+
+// Fresh id ranges "3-5", a blank line, then the available ids.
+template <>
+std::string Generate<2025, 5>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  constexpr u64 kMaxId = 560'000'000'000'000;
+  std::string out;
+  for (u32 i = 0; i < 190 * scale; i++) {
+    const u64 from = Uniform(rng, 1, kMaxId);
+    fmt::format_to(std::back_inserter(out), "{}-{}\n", from, from + Uniform(rng, 0, 1ull << 41));
+  }
+  out.push_back('\n');
+  for (u32 i = 0; i < 1000 * scale; i++) {
+    fmt::format_to(std::back_inserter(out), "{}\n", Uniform(rng, 1, kMaxId));
+  }
+  return out;
+}
+
+// Four rows of numbers and a row of operators, one problem per block of columns. Within a block
+// the numbers are all left or all right aligned. The operator row loses its trailing spaces when
+// the input is trimmed, so the last problem is kept a single column wide.
+template <>
+std::string Generate<2025, 6>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  constexpr u32 kRows = 4;
+  const u32 problems = 1000 * scale;
+  std::array<std::string, kRows + 1> lines;
+  for (u32 p = 0; p < problems; p++) {
+    const u32 width = p == problems - 1 ? 1 : Uniform(rng, 1, 4);
+    const bool left = Uniform(rng, 0, 1);
+    const u32 widest = Uniform(rng, 0, kRows - 1);
+    for (u32 r = 0; r < kRows; r++) {
+      const u32 digits = r == widest ? width : Uniform(rng, 1, width);
+      const u64 number = Uniform(rng, kTenPowers[digits - 1], kTenPowers[digits] - 1);
+      if (p) lines[r].push_back(' ');
+      if (left) fmt::format_to(std::back_inserter(lines[r]), "{:<{}}", number, width);
+      else
+        fmt::format_to(std::back_inserter(lines[r]), "{:>{}}", number, width);
+    }
+    if (p) lines[kRows].push_back(' ');
+    fmt::format_to(
+        std::back_inserter(lines[kRows]), "{:<{}}", Uniform(rng, 0, 1) ? '+' : '*', width);
+  }
+  return fmt::format("{}\n", fmt::join(lines, "\n"));
+}
+
+// The manifold: 'S' on the first row, then every other row holds splitters '^'. Splitters are only
+// placed where a beam can reach them, inside the triangle below 'S'.
+template <>
+std::string Generate<2025, 7>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  const u32 height = ScaledSide(142, scale) & ~1u;
+  const u32 width = height + 1;
+  const u32 start = height / 2;
+  std::string out;
+  for (u32 i = 0; i < height; i++) {
+    std::string row(width, '.');
+    if (i == 0) {
+      row[start] = 'S';
+    } else if (i % 2 == 0) {
+      const u32 reach = i / 2 - 1;
+      for (u32 j = start - reach; j <= start + reach; j += 2) {
+        if (Uniform(rng, 0, 9) < 6) row[j] = '^';
+      }
+    }
+    out += row;
+    out.push_back('\n');
+  }
+  return out;
+}
+
+// Junction box coordinates "x,y,z". The solver requires every pairwise distance to be distinct, so
+// coordinates are drawn from a range wide enough to make collisions vanishingly rare.
+template <>
+std::string Generate<2025, 8>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  std::string out;
+  for (u32 i = 0; i < 1000 * scale; i++) {
+    fmt::format_to(
+        std::back_inserter(out), "{},{},{}\n", Uniform(rng, 0, 999'999'999),
+        Uniform(rng, 0, 999'999'999), Uniform(rng, 0, 999'999'999));
+  }
+  return out;
+}
+
+// Red tile corners "x,y" of a closed rectilinear polygon, consecutive corners sharing a row or a
+// column. The shape is a histogram: a flat bottom edge and a random walk of columns above it.
+template <>
+std::string Generate<2025, 9>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  constexpr i64 kBase = 1000;
+  const u32 columns = 250 * scale - 1;
+  std::string out;
+  i64 x = kBase, y = 50'000;
+  fmt::format_to(std::back_inserter(out), "{},{}\n", x, kBase);
+  for (u32 c = 0; c < columns; c++) {
+    if (c) {
+      i64 step = static_cast<i64>(Uniform(rng, 1, 2000));
+      if (y - step <= kBase || (y + step < 100'000 && Uniform(rng, 0, 1))) y += step;
+      else
+        y -= step;
+    }
+    fmt::format_to(std::back_inserter(out), "{},{}\n", x, y);
+    x += static_cast<i64>(Uniform(rng, 1, 400));
+    fmt::format_to(std::back_inserter(out), "{},{}\n", x, y);
+  }
+  fmt::format_to(std::back_inserter(out), "{},{}\n", x, kBase);
+  return out;
+}
+
+// Machines "[.##.] (3) (1,3) (2) {3,5,4,7}". Both the light pattern and the joltages are produced
+// by pressing buttons, so every machine can be solved.
+template <>
+std::string Generate<2025, 10>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  std::string out;
+  for (u32 m = 0; m < 170 * scale; m++) {
+    // The solver reads light indices as single digits.
+    const u32 num_lights = Uniform(rng, 4, 10);
+    const u32 num_buttons = Uniform(rng, 3, 13);
+    std::vector<u32> buttons;
+    for (u32 b = 0; b < num_buttons; b++) {
+      buttons.push_back(Uniform(rng, 1, (1u << num_lights) - 1));
+    }
+    u32 lights = 0;
+    std::vector<u32> joltages(num_lights, 0);
+    for (u32 button : buttons) {
+      if (Uniform(rng, 0, 1)) lights ^= button;
+      const u32 presses = Uniform(rng, 0, 40);
+      for (u32 l = 0; l < num_lights; l++) {
+        if (button & (1 << l)) joltages[l] += presses;
+      }
+    }
+    out.push_back('[');
+    for (u32 l = 0; l < num_lights; l++) out.push_back(lights & (1 << l) ? '#' : '.');
+    out += "] ";
+    for (u32 button : buttons) {
+      std::vector<u32> indices;
+      for (u32 l = 0; l < num_lights; l++) {
+        if (button & (1 << l)) indices.push_back(l);
+      }
+      fmt::format_to(std::back_inserter(out), "({}) ", fmt::join(indices, ","));
+    }
+    fmt::format_to(std::back_inserter(out), "{{{}}}\n", fmt::join(joltages, ","));
+  }
+  return out;
+}
+
+// Device connections "aaa: bbb ccc" forming a layered DAG that ends in "out". Layer width grows
+// with the scale while the depth stays fixed; "you" sits a few layers before "out", keeping the
+// part 1 path enumeration small, and a spine through the first device of every layer makes sure
+// "svr" reaches "fft", "dac" and "out".
+template <>
+std::string Generate<2025, 11>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  constexpr u32 kLayers = 16;
+  const u32 width = 38 * scale;
+  auto name = [scale, width](u32 layer, u32 index) -> std::string {
+    if (index == 0) {
+      switch (layer) {
+        case 0: return "svr";
+        case 5: return "fft";
+        case 9: return "dac";
+        case kLayers - 6: return "you";
+      }
+    }
+    const auto& names = DeviceNames();
+    CHECK(layer * width + index < names.size()) << "Too many devices for scale " << scale << ".";
+    return names[layer * width + index];
+  };
+  std::string out;
+  for (u32 layer = 0; layer < kLayers; layer++) {
+    for (u32 index = 0; index < width; index++) {
+      out += name(layer, index);
+      out += ":";
+      if (layer == kLayers - 1) {
+        out += " out\n";
+        continue;
+      }
+      absl::btree_set<u32> next{0};
+      const u32 extra = Uniform(rng, 1, 2);
+      while (next.size() < 1 + extra) next.insert(Uniform(rng, 0, width - 1));
+      for (u32 n : next) {
+        out.push_back(' ');
+        out += name(layer + 1, n);
+      }
+      out.push_back('\n');
+    }
+  }
+  return out;
+}
+
+// Six 3x3 present shapes, then regions "12x5: 1 0 1 0 2 2".
+template <>
+std::string Generate<2025, 12>(const u32 scale, const u64 seed) {
+  Rng rng(seed);
+  std::string out;
+  for (u32 p = 0; p < 6; p++) {
+    fmt::format_to(std::back_inserter(out), "{}:\n", p);
+    // The centre is always filled so no shape is empty.
+    for (u32 i = 0; i < 3; i++) {
+      for (u32 j = 0; j < 3; j++) {
+        out.push_back((i == 1 && j == 1) || Uniform(rng, 0, 9) < 7 ? '#' : '.');
+      }
+      out.push_back('\n');
+    }
+    out.push_back('\n');
+  }
+  for (u32 r = 0; r < 1000 * scale; r++) {
+    fmt::format_to(std::back_inserter(out), "{}x{}:", Uniform(rng, 35, 50), Uniform(rng, 35, 50));
+    for (u32 p = 0; p < 6; p++) fmt::format_to(std::back_inserter(out), " {}", Uniform(rng, 0, 60));
+    out.push_back('\n');
+  }
+  return out;
+}
+
+}  // namespace aoc::generators
@@ -4,20 +4,126 @@
 #include <aoc.h>
 #include <benchmark/benchmark.h>
 
+#include "aoc_counters.h"
+#include "aoc_generators.h"
+
+// Reports every phase the solver recorded as an average per-iteration counter, in microseconds.
+inline void ReportPhases(benchmark::State& state, const aoc::PhaseTimes& phase_times) {
+  for (const auto& [name, total] : phase_times.Phases()) {
+    state.counters[fmt::format("{}_us", name)] = benchmark::Counter(
+        std::chrono::duration<double, std::micro>(total).count(),
+        benchmark::Counter::kAvgIterations);
+  }
+}
+
+// Reports what the last solve took from its arena, since every solve resets it.
+inline void ReportArena(benchmark::State& state, const aoc::Arena& arena) {
+  state.counters["arena_allocs"] = static_cast<double>(arena.Allocations());
+  state.counters["arena_bytes"] = static_cast<double>(arena.Bytes());
+}
+
+// Reports whichever of allocations and hardware events were counted as averages per iteration, and
+// instructions per cycle when both were.
+inline void ReportCounters(benchmark::State& state, const aoc::counters::Sample& sample) {
+  const auto per_iteration = [&](const double value) {
+    return benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+  };
+  if (sample.allocations.has_value()) {
+    state.counters["allocs"] = per_iteration(static_cast<double>(*sample.allocations));
+    state.counters["alloc_bytes"] = per_iteration(static_cast<double>(*sample.allocation_bytes));
+  }
+  for (u32 e = 0; e < sample.perf.size(); e++) {
+    if (sample.perf[e].has_value()) {
+      state.counters[std::string(aoc::counters::kPerfEventNames[e])] =
+          per_iteration(static_cast<double>(*sample.perf[e]));
+    }
+  }
+  if (sample.perf[0].has_value() && sample.perf[1].has_value() && *sample.perf[0] != 0) {
+    state.counters["ipc"] = static_cast<double>(*sample.perf[1]) / static_cast<double>(*sample.perf[0]);
+  }
+}
+
+// End to end: parse and solve on every iteration.
 template <int YEAR, int DAY>
 void AocBenchmarks(benchmark::State& state) {
   advent<YEAR, DAY> adv;
   adv.GetInput();
+  adv.Phases().Enable();
+  aoc::counters::Scope counters;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(adv.solve());
+  }
+  ReportCounters(state, counters.Stop());
+  ReportPhases(state, adv.Phases());
+  ReportArena(state, adv.Scratch());
+}
+
+template <int YEAR, int DAY>
+void AocParseBenchmarks(benchmark::State& state) {
+  advent<YEAR, DAY> adv;
+  adv.GetInput();
+  aoc::counters::Scope counters;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(adv.Parse());
+  }
+  ReportCounters(state, counters.Stop());
+}
+
+// Solves the same pre-parsed input on every iteration.
+template <int YEAR, int DAY>
+void AocSolveBenchmarks(benchmark::State& state) {
+  advent<YEAR, DAY> adv;
+  adv.GetInput();
+  const auto parsed = adv.Parse();
+  adv.Phases().Enable();
+  aoc::counters::Scope counters;
+  for (auto _ : state) {
+    adv.Scratch().Reset();
+    benchmark::DoNotOptimize(adv.Solve(*parsed));
+  }
+  ReportCounters(state, counters.Stop());
+  ReportPhases(state, adv.Phases());
+  ReportArena(state, adv.Scratch());
+}
+
+// End to end on a generated input `state.range(0)` times the size of the puzzle input. The scale
+// is the complexity N, so the reported fit describes how the day grows with its input.
+template <int YEAR, int DAY>
+void AocScaledBenchmarks(benchmark::State& state) {
+  advent<YEAR, DAY> adv;
+  adv.SetInput(aoc::generators::Generate<YEAR, DAY>(state.range(0)));
   for (auto _ : state) {
     benchmark::DoNotOptimize(adv.solve());
   }
+  state.SetComplexityN(state.range(0));
 }
 
 #ifndef AOC_BENCHMARK
 #define AOC_BENCHMARK(year, day) BENCHMARK(AocBenchmarks<(year), (day)>)\
     ->Name("AoC-" #year "-" #day)\
     ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime();\
+    BENCHMARK(AocParseBenchmarks<(year), (day)>)\
+    ->Name("AoC-" #year "-" #day "/parse")\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime();\
+    BENCHMARK(AocSolveBenchmarks<(year), (day)>)\
+    ->Name("AoC-" #year "-" #day "/solve")\
+    ->Unit(benchmark::kMicrosecond)\
     ->UseRealTime()
 #endif // AOC_BENCHMARK
 
+// Scales 1, 2, 4, ... up to max_scale, fitted against the expected complexity, e.g. benchmark::oN.
+#ifndef AOC_SCALED_BENCHMARK
+#define AOC_SCALED_BENCHMARK(year, day, max_scale, complexity) \
+    BENCHMARK(AocScaledBenchmarks<(year), (day)>)\
+    ->Name("AoC-" #year "-" #day "/scaled")\
+    ->ArgName("scale")\
+    ->RangeMultiplier(2)\
+    ->Range(1, (max_scale))\
+    ->Complexity(complexity)\
+    ->Unit(benchmark::kMillisecond)\
+    ->UseRealTime()
+#endif // AOC_SCALED_BENCHMARK
+
 #endif // AOC_BENCHMARKS_H
@@ -0,0 +1,147 @@
+#include "aoc_benchmarks.h"
+
+#include <random>
+
+namespace {
+
+// NumDigits and NumBits as they were before they moved into aoc_core.h: defined out of line in
+// aoc.cpp, so never inlined into their callers.
+[[gnu::noinline]] u32 BranchTreeNumDigits(const u64 x) {
+  if (x >= 10000000000) {
+    if (x >= 100000000000000) {
+      if (x >= 10000000000000000) {
+        if (x >= 100000000000000000) {
+          if (x >= 1000000000000000000) {
+            if (x >= 10000000000000000000u) return 20;
+            return 19;
+          }
+          return 18;
+        }
+        return 17;
+      }
+      if (x >= 1000000000000000) return 16;
+      return 15;
+    }
+    if (x >= 1000000000000) {
+      if (x >= 10000000000000) return 14;
+      return 13;
+    }
+    if (x >= 100000000000) return 12;
+    return 11;
+  }
+  if (x >= 100000) {
+    if (x >= 10000000) {
+      if (x >= 100000000) {
+        if (x >= 1000000000) return 10;
+        return 9;
+      }
+      return 8;
+    }
+    if (x >= 1000000) return 7;
+    return 6;
+  }
+  if (x >= 100) {
+    if (x >= 1000) {
+      if (x >= 10000) return 5;
+      return 4;
+    }
+    return 3;
+  }
+  if (x >= 10) return 2;
+  return 1;
+}
+
+[[gnu::noinline]] u32 SwarNumBits(const u64 x) {
+  u64 count = x - ((x >> 1) & 0x5555555555555555);
+  count = ((count >> 2) & 0x3333333333333333) + (count & 0x3333333333333333);
+  count = ((count >> 4) + count) & 0x0F0F0F0F0F0F0F0F;
+  count = ((count >> 8) + count) & 0x00FF00FF00FF00FF;
+  count = ((count >> 16) + count) & 0x0000FFFF0000FFFF;
+  count = ((count >> 32) + count) & 0x00000000FFFFFFFF;
+  return count;
+}
+
+struct OutOfLine {
+  static u32 NumDigits(const u64 x) { return BranchTreeNumDigits(x); }
+  static u32 NumBits(const u64 x) { return SwarNumBits(x); }
+};
+
+struct Inline {
+  static constexpr u32 NumDigits(const u64 x) { return aoc::util::NumDigits(x); }
+  static constexpr u32 NumBits(const u64 x) { return aoc::util::NumBits(x); }
+};
+
+// `size` stones of 1 to 12 digits, blinked once each as in 2024/11: split the even-digit ones.
+template<typename Bits>
+void BlinkBenchmark(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  std::vector<u64> stones(state.range(0));
+  for (u64& stone : stones) stone = rng() % aoc::kTenPowers[1 + rng() % 12];
+  for (auto _ : state) {
+    u64 sum = 0;
+    for (const u64 stone : stones) {
+      const u32 digits = Bits::NumDigits(stone);
+      if (digits & 1) {
+        sum += stone * 2024;
+      } else {
+        const u64 left = stone / aoc::kTenPowers[digits / 2];
+        sum += left + (stone - left * aoc::kTenPowers[digits / 2]);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Every pattern below `size` repeated twice and thrice, as 2025/02 MakeWhole does for the ranges.
+template<typename Bits>
+void MakeWholeBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    u64 sum = 0;
+    for (u64 pattern = 1; pattern < static_cast<u64>(state.range(0)); pattern++) {
+      const u64 multiplier = aoc::kTenPowers[Bits::NumDigits(pattern)];
+      sum += pattern * multiplier + pattern;
+      sum += (pattern * multiplier + pattern) * multiplier + pattern;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The button combinations of 2025/10 bucketed by the number of buttons pressed.
+template<typename Bits>
+void ButtonCombinationsBenchmark(benchmark::State& state) {
+  const u32 max_buttons = state.range(0);
+  for (auto _ : state) {
+    std::array<u32, 65> counts{};
+    for (u64 toggles = 1; toggles < (u64{1} << max_buttons); toggles++) {
+      counts[Bits::NumBits(toggles)]++;
+    }
+    benchmark::DoNotOptimize(counts);
+  }
+  state.SetItemsProcessed(state.iterations() * (u64{1} << max_buttons));
+}
+
+}  // namespace
+
+#ifndef AOC_BITS_BENCHMARK
+#define AOC_BITS_BENCHMARK(func, name, arg) BENCHMARK(func)\
+    ->Name("Bits-" name)\
+    ->ArgName(arg)\
+    ->RangeMultiplier(16)\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_BITS_BENCHMARK
+
+AOC_BITS_BENCHMARK(BlinkBenchmark<OutOfLine>, "NumDigits/Blink/OutOfLine", "stones")
+    ->Range(1 << 10, 1 << 18);
+AOC_BITS_BENCHMARK(BlinkBenchmark<Inline>, "NumDigits/Blink/Inline", "stones")
+    ->Range(1 << 10, 1 << 18);
+AOC_BITS_BENCHMARK(MakeWholeBenchmark<OutOfLine>, "NumDigits/MakeWhole/OutOfLine", "patterns")
+    ->Range(1 << 10, 1 << 18);
+AOC_BITS_BENCHMARK(MakeWholeBenchmark<Inline>, "NumDigits/MakeWhole/Inline", "patterns")
+    ->Range(1 << 10, 1 << 18);
+AOC_BITS_BENCHMARK(ButtonCombinationsBenchmark<OutOfLine>, "NumBits/Buttons/OutOfLine", "buttons")
+    ->DenseRange(4, 16, 4);
+AOC_BITS_BENCHMARK(ButtonCombinationsBenchmark<Inline>, "NumBits/Buttons/Inline", "buttons")
+    ->DenseRange(4, 16, 4);
@@ -0,0 +1,128 @@
+#include "aoc_counters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(AOC_BENCHMARK_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define AOC_PERF_EVENTS 1
+#endif
+
+namespace {
+
+std::atomic<u64> allocations{0};
+std::atomic<u64> allocation_bytes{0};
+
+#ifdef AOC_PERF_EVENTS
+
+// (type, config) of every kPerfEventNames entry.
+constexpr std::array<std::pair<u32, u64>, aoc::counters::kPerfEventNames.size()> kPerfEvents = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+// A counter of this thread and its future children in user space, started; -1 if refused.
+int OpenPerfEvent(const u32 type, const u64 config) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  return fd;
+}
+
+// The count of `fd`, scaled up for the time the kernel multiplexed it out.
+std::optional<u64> ReadPerfEvent(const int fd) {
+  struct {
+    u64 value;
+    u64 enabled;
+    u64 running;
+  } data{};
+  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  if (read(fd, &data, sizeof(data)) != sizeof(data) || data.running == 0) return std::nullopt;
+  if (data.running == data.enabled) return data.value;
+  return static_cast<u64>(static_cast<double>(data.value) * data.enabled / data.running);
+}
+
+#endif  // AOC_PERF_EVENTS
+
+}  // namespace
+
+namespace aoc::counters {
+
+Scope::Scope() {
+  _fds.fill(-1);
+#ifdef AOC_PERF_EVENTS
+  for (u32 e = 0; e < _fds.size(); e++) _fds[e] = OpenPerfEvent(kPerfEvents[e].first, kPerfEvents[e].second);
+#endif
+  _allocations = allocations.load(std::memory_order_relaxed);
+  _allocation_bytes = allocation_bytes.load(std::memory_order_relaxed);
+}
+
+Scope::~Scope() {
+#ifdef AOC_PERF_EVENTS
+  for (int& fd : _fds) {
+    if (fd >= 0) close(fd);
+    fd = -1;
+  }
+#endif
+}
+
+Sample Scope::Stop() {
+  Sample sample;
+#ifdef AOC_BENCHMARK_COUNTERS
+  sample.allocations = allocations.load(std::memory_order_relaxed) - _allocations;
+  sample.allocation_bytes = allocation_bytes.load(std::memory_order_relaxed) - _allocation_bytes;
+#endif
+#ifdef AOC_PERF_EVENTS
+  for (u32 e = 0; e < _fds.size(); e++) {
+    if (_fds[e] >= 0) sample.perf[e] = ReadPerfEvent(_fds[e]);
+  }
+#endif
+  return sample;
+}
+
+}  // namespace aoc::counters
+
+#ifdef AOC_BENCHMARK_COUNTERS
+
+// Replacements of the global allocation functions that count every request. The array and
+// nothrow forms of the standard library forward to these.
+void* operator new(const std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  const auto align = static_cast<std::size_t>(alignment);
+  if (void* p = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif  // AOC_BENCHMARK_COUNTERS
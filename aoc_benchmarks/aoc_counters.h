@@ -0,0 +1,46 @@
+#ifndef AOC_COUNTERS_H
+#define AOC_COUNTERS_H
+
+#include <aoc.h>
+
+#include <array>
+#include <optional>
+#include <string_view>
+
+namespace aoc::counters {
+
+// The hardware events a Scope counts, by their benchmark counter names.
+inline constexpr std::array<std::string_view, 5> kPerfEventNames = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+
+struct Sample {
+  // Heap allocations and bytes requested through operator new by any thread, if hooked.
+  std::optional<u64> allocations;
+  std::optional<u64> allocation_bytes;
+  // One entry per kPerfEventNames, empty where the kernel or the CPU doesn't provide the event.
+  std::array<std::optional<u64>, kPerfEventNames.size()> perf{};
+};
+
+// Counts allocations and, on Linux where perf_event_open is allowed, hardware events from
+// construction to Stop(). The perf events follow the calling thread and the threads it starts
+// while counting, so work handed to an already running pool isn't in them; allocations are
+// counted process-wide. Without AOC_BENCHMARK_COUNTERS nothing is hooked and every Sample is
+// empty.
+class Scope {
+  std::array<int, kPerfEventNames.size()> _fds;
+  u64 _allocations;
+  u64 _allocation_bytes;
+
+ public:
+  Scope();
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+  ~Scope();
+
+  // The counts since construction. Counting stops; call it once.
+  Sample Stop();
+};
+
+}  // namespace aoc::counters
+
+#endif  // AOC_COUNTERS_H
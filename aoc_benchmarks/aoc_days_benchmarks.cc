@@ -0,0 +1,8 @@
+#include "aoc_benchmarks.h"
+
+#include <aoc_days.h>
+
+#define AOC_BENCHMARK_DAY(year, day) AOC_BENCHMARK(year, day);
+
+// End to end, parse and solve of every day compiled into aoc_lib.
+AOC_FOR_EACH_DAY(AOC_BENCHMARK_DAY)
@@ -0,0 +1,16 @@
+#ifndef AOC_GENERATORS_H
+#define AOC_GENERATORS_H
+
+#include <aoc.h>
+
+namespace aoc::generators {
+
+// Returns a well-formed input for advent<YEAR, DAY>, about `scale` times the size of the real
+// puzzle input. The same scale and seed always produce the same input. Only the format and the
+// solver's assumptions about it are honoured; the answers are whatever the input happens to give.
+template <int YEAR, int DAY>
+std::string Generate(u32 scale, u64 seed = 1);
+
+}  // namespace aoc::generators
+
+#endif  // AOC_GENERATORS_H
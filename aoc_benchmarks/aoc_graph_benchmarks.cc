@@ -0,0 +1,189 @@
+#include "aoc_benchmarks.h"
+
+#include <aoc_graph.h>
+
+#include <absl/container/btree_map.h>
+#include <absl/container/btree_set.h>
+
+#include <deque>
+#include <random>
+
+namespace {
+
+using Edges = std::vector<std::pair<u32, u32>>;
+// Adjacency the way the solvers kept it before aoc::CsrGraph.
+using NestedGraph = absl::btree_map<u32, absl::btree_set<u32>>;
+
+// `nodes` nodes with 4 random edges each, like the wiring of 2023/25 at scale.
+Edges RandomEdges(const u32 nodes) {
+  std::mt19937_64 rng(1);
+  Edges edges;
+  for (u32 node = 0; node < nodes; node++) {
+    for (u32 i = 0; i < 4; i++) edges.emplace_back(node, rng() % nodes);
+  }
+  return edges;
+}
+
+// A DAG like the devices of 2025/11: every node feeds 1 to 3 of the 64 nodes after it.
+Edges RandomDag(const u32 nodes) {
+  std::mt19937_64 rng(1);
+  Edges arcs;
+  for (u32 node = 0; node + 1 < nodes; node++) {
+    for (u32 i = 0; i <= rng() % 3; i++) {
+      arcs.emplace_back(node, std::min<u32>(nodes - 1, node + 1 + rng() % 64));
+    }
+  }
+  absl::c_sort(arcs);
+  arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+  return arcs;
+}
+
+NestedGraph Nested(const Edges& edges, const bool undirected) {
+  NestedGraph graph;
+  for (const auto [a, b] : edges) {
+    graph[a].insert(b);
+    if (undirected) graph[b].insert(a);
+  }
+  return graph;
+}
+
+u64 NestedBfs(const NestedGraph& graph, const u32 source, absl::flat_hash_set<u32>& visited) {
+  std::deque<u32> q{source};
+  visited.insert(source);
+  u64 reached = 0;
+  while (!q.empty()) {
+    const u32 node = q.front();
+    q.pop_front();
+    reached++;
+    const auto it = graph.find(node);
+    if (it == graph.end()) continue;
+    for (const u32 next : it->second) {
+      if (visited.insert(next).second) q.push_back(next);
+    }
+  }
+  return reached;
+}
+
+// A plain FIFO breadth-first search of the CsrGraph, on the calling thread.
+std::vector<u32> QueueBfs(const aoc::CsrGraph& graph, const u32 source) {
+  std::vector<u32> distances(graph.NumNodes(), aoc::CsrGraph::kUnreachable);
+  std::vector<u32> q{source};
+  distances[source] = 0;
+  for (u64 head = 0; head < q.size(); head++) {
+    for (const u32 next : graph.Neighbors(q[head])) {
+      if (distances[next] != aoc::CsrGraph::kUnreachable) continue;
+      distances[next] = distances[q[head]] + 1;
+      q.push_back(next);
+    }
+  }
+  return distances;
+}
+
+u64 MemoizedPaths(const absl::flat_hash_map<u32, absl::flat_hash_set<u32>>& graph, const u32 from,
+                  const u32 to, absl::flat_hash_map<u32, u64>& cache) {
+  if (from == to) return 1;
+  if (const auto it = cache.find(from); it != cache.end()) return it->second;
+  u64 paths = 0;
+  if (const auto it = graph.find(from); it != graph.end()) {
+    for (const u32 next : it->second) paths += MemoizedPaths(graph, next, to, cache);
+  }
+  cache[from] = paths;
+  return paths;
+}
+
+void BfsNestedBenchmark(benchmark::State& state) {
+  const NestedGraph graph = Nested(RandomEdges(state.range(0)), true);
+  for (auto _ : state) {
+    absl::flat_hash_set<u32> visited;
+    benchmark::DoNotOptimize(NestedBfs(graph, 0, visited));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BfsQueueBenchmark(benchmark::State& state) {
+  const auto graph = aoc::CsrGraph::Undirected(state.range(0), RandomEdges(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(QueueBfs(graph, 0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BfsDirectionOptimizingBenchmark(benchmark::State& state) {
+  const auto graph = aoc::CsrGraph::Undirected(state.range(0), RandomEdges(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aoc::BfsDistances(graph, 0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Sizes of the components, one search from every node not seen yet, as 2023/25 counted them.
+void ComponentsNestedBenchmark(benchmark::State& state) {
+  const u32 nodes = state.range(0);
+  const NestedGraph graph = Nested(RandomEdges(nodes / 2), true);
+  for (auto _ : state) {
+    absl::flat_hash_set<u32> visited;
+    std::vector<u64> sizes;
+    for (u32 node = 0; node < nodes; node++) {
+      if (!visited.contains(node)) sizes.push_back(NestedBfs(graph, node, visited));
+    }
+    benchmark::DoNotOptimize(sizes);
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+void ComponentsUnionFindBenchmark(benchmark::State& state) {
+  const u32 nodes = state.range(0);
+  const auto graph = aoc::CsrGraph::Undirected(nodes, RandomEdges(nodes / 2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aoc::ConnectedComponents(graph));
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+// Paths from the first node to the last, memoized in hash maps as 2025/11 counted them.
+void PathsMemoizedBenchmark(benchmark::State& state) {
+  const u32 nodes = state.range(0);
+  absl::flat_hash_map<u32, absl::flat_hash_set<u32>> graph;
+  for (const auto [from, to] : RandomDag(nodes)) graph[from].insert(to);
+  for (auto _ : state) {
+    absl::flat_hash_map<u32, u64> cache;
+    benchmark::DoNotOptimize(MemoizedPaths(graph, 0, nodes - 1, cache));
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+void PathsTopologicalBenchmark(benchmark::State& state) {
+  const u32 nodes = state.range(0);
+  const aoc::CsrGraph graph(nodes, RandomDag(nodes));
+  for (auto _ : state) {
+    const auto order = aoc::TopologicalOrder(graph);
+    std::vector<u64> paths(nodes, 0);
+    paths[nodes - 1] = 1;
+    for (const u32 node : *order | std::views::reverse) {
+      for (const u32 next : graph.Neighbors(node)) paths[node] += paths[next];
+    }
+    benchmark::DoNotOptimize(paths[0]);
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+}  // namespace
+
+#ifndef AOC_GRAPH_BENCHMARK
+#define AOC_GRAPH_BENCHMARK(func, name, max) BENCHMARK(func)\
+    ->Name("Graph-" name)\
+    ->ArgName("nodes")\
+    ->RangeMultiplier(32)\
+    ->Range(1 << 10, (max))\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_GRAPH_BENCHMARK
+
+AOC_GRAPH_BENCHMARK(BfsNestedBenchmark, "Bfs/NestedContainers", 1 << 20);
+AOC_GRAPH_BENCHMARK(BfsQueueBenchmark, "Bfs/Queue", 1 << 20);
+AOC_GRAPH_BENCHMARK(BfsDirectionOptimizingBenchmark, "Bfs/DirectionOptimizing", 1 << 20);
+AOC_GRAPH_BENCHMARK(ComponentsNestedBenchmark, "Components/NestedContainers", 1 << 20);
+AOC_GRAPH_BENCHMARK(ComponentsUnionFindBenchmark, "Components/UnionFind", 1 << 20);
+// The memoized recursion goes as deep as the longest path, so the DAGs stay small.
+AOC_GRAPH_BENCHMARK(PathsMemoizedBenchmark, "Paths/Memoized", 1 << 15);
+AOC_GRAPH_BENCHMARK(PathsTopologicalBenchmark, "Paths/Topological", 1 << 15);
@@ -0,0 +1,199 @@
+#include "aoc_benchmarks.h"
+
+#include <random>
+
+namespace {
+
+// A `size` x `size` map of four plot types in patches, shaped like 2024/12.
+std::string MapInput(const i64 size) {
+  std::mt19937_64 rng(1);
+  std::string input;
+  for (i64 i = 0; i < size; i++) {
+    for (i64 j = 0; j < size; j++) {
+      const bool copy_above = i > 0 && rng() % 4 != 0;
+      input.push_back(
+          copy_above ? input[input.size() - size - 1] : static_cast<char>('A' + rng() % 4));
+    }
+    input.push_back('\n');
+  }
+  input.pop_back();
+  return input;
+}
+
+// The maps grid days used before aoc::Grid: a vector per row and bounds-checked accesses.
+u64 FloodFillNested(const std::vector<std::vector<char>>& map) {
+  const u64 height = map.size(), width = map.at(0).size();
+  std::vector<std::vector<bool>> scanned(height, std::vector<bool>(width, false));
+  std::vector<aoc::Pos> q;
+  u64 result = 0;
+  for (i64 i = 0; i < height; i++) {
+    for (i64 j = 0; j < width; j++) {
+      if (scanned.at(i).at(j)) continue;
+      const char tile = map.at(i).at(j);
+      u64 area = 0, perimeter = 0;
+      q.emplace_back(i, j);
+      scanned[i][j] = true;
+      while (!q.empty()) {
+        const aoc::Pos pos = q.back();
+        q.pop_back();
+        area++;
+        for (aoc::Dir dir : aoc::kAllDirs) {
+          const aoc::Pos new_pos = pos + aoc::MoveDir(dir);
+          if (aoc::util::IsOutOfMap(height, width, new_pos) ||
+              map.at(new_pos.i).at(new_pos.j) != tile) {
+            perimeter++;
+            continue;
+          }
+          if (scanned.at(new_pos.i).at(new_pos.j)) continue;
+          scanned[new_pos.i][new_pos.j] = true;
+          q.push_back(new_pos);
+        }
+      }
+      result += area * perimeter;
+    }
+  }
+  return result;
+}
+
+// The same fill on a bordered aoc::Grid, with linear indices and no bounds checks.
+u64 FloodFillGrid(const aoc::Grid<char>& map) {
+  const auto offsets = map.Offsets();
+  std::vector<bool> scanned(map.Size(), false);
+  std::vector<i64> q;
+  u64 result = 0;
+  for (i64 i = 0; i < map.Height(); i++) {
+    for (i64 j = 0; j < map.Width(); j++) {
+      const i64 start = map.Index(i, j);
+      if (scanned[start]) continue;
+      const char tile = map[start];
+      u64 area = 0, perimeter = 0;
+      q.push_back(start);
+      scanned[start] = true;
+      while (!q.empty()) {
+        const i64 pos = q.back();
+        q.pop_back();
+        area++;
+        for (const i64 offset : offsets) {
+          const i64 new_pos = pos + offset;
+          if (map[new_pos] != tile) {
+            perimeter++;
+            continue;
+          }
+          if (scanned[new_pos]) continue;
+          scanned[new_pos] = true;
+          q.push_back(new_pos);
+        }
+      }
+      result += area * perimeter;
+    }
+  }
+  return result;
+}
+
+void ParseNestedBenchmark(benchmark::State& state) {
+  const std::string input = MapInput(state.range(0));
+  for (auto _ : state) {
+    auto map = aoc::util::TokenizeInput<std::vector<char>>(input, [](auto line) {
+      return std::vector<char>{line.begin(), line.end()};
+    });
+    benchmark::DoNotOptimize(map.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void ParseGridBenchmark(benchmark::State& state) {
+  const std::string input = MapInput(state.range(0));
+  for (auto _ : state) {
+    aoc::Grid<char> map(input, [](const char ch) { return ch; }, 1, '.');
+    benchmark::DoNotOptimize(map[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void ParseGridViewBenchmark(benchmark::State& state) {
+  // Views keep the last line's '\n' as its border.
+  const std::string input = MapInput(state.range(0)) + '\n';
+  for (auto _ : state) {
+    aoc::Grid<const char> map(input);
+    benchmark::DoNotOptimize(map[0]);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void FloodFillNestedBenchmark(benchmark::State& state) {
+  const std::string input = MapInput(state.range(0));
+  const auto map = aoc::util::TokenizeInput<std::vector<char>>(input, [](auto line) {
+    return std::vector<char>{line.begin(), line.end()};
+  });
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FloodFillNested(map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+void FloodFillGridBenchmark(benchmark::State& state) {
+  const std::string input = MapInput(state.range(0));
+  const aoc::Grid<char> map(input, [](const char ch) { return ch; }, 1, '.');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FloodFillGrid(map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+// Visits a `size` x `size` map in BFS order, keeping visited positions in a hash set of `P`, as the
+// searches of 2024/10 and 2023/21 do. Reports the bytes the set holds at the end.
+template<typename P>
+void PosSetBenchmark(benchmark::State& state) {
+  const i64 size = state.range(0);
+  u64 bytes = 0;
+  for (auto _ : state) {
+    absl::flat_hash_set<P> visited;
+    std::deque<aoc::Pos> q{{0, 0}};
+    visited.insert(P(aoc::Pos{0, 0}));
+    while (!q.empty()) {
+      const aoc::Pos pos = q.front();
+      q.pop_front();
+      for (aoc::Dir dir : aoc::kAllDirs) {
+        const aoc::Pos new_pos = pos + aoc::MoveDir(dir);
+        if (aoc::util::IsOutOfMap(size, size, new_pos)) continue;
+        if (visited.insert(P(new_pos)).second) q.push_back(new_pos);
+      }
+    }
+    bytes = visited.capacity() * (sizeof(P) + 1);
+    benchmark::DoNotOptimize(visited.size());
+  }
+  state.counters["set_bytes"] = static_cast<double>(bytes);
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+
+}  // namespace
+
+#ifndef AOC_GRID_BENCHMARK
+#define AOC_GRID_BENCHMARK(func, name) BENCHMARK(func)\
+    ->Name("Grid-" name)\
+    ->ArgName("size")\
+    ->RangeMultiplier(4)\
+    ->Range(64, 4096)\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_GRID_BENCHMARK
+
+AOC_GRID_BENCHMARK(ParseNestedBenchmark, "Parse/Nested");
+AOC_GRID_BENCHMARK(ParseGridBenchmark, "Parse/Grid");
+AOC_GRID_BENCHMARK(ParseGridViewBenchmark, "Parse/GridView");
+AOC_GRID_BENCHMARK(FloodFillNestedBenchmark, "FloodFill/Nested");
+AOC_GRID_BENCHMARK(FloodFillGridBenchmark, "FloodFill/Grid");
+
+// Up to 1024 only: a set of 4096 x 4096 Pos would take half a gigabyte.
+#ifndef AOC_POS_SET_BENCHMARK
+#define AOC_POS_SET_BENCHMARK(func, name) BENCHMARK(func)\
+    ->Name("Grid-PosSet/" name)\
+    ->ArgName("size")\
+    ->RangeMultiplier(4)\
+    ->Range(64, 1024)\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_POS_SET_BENCHMARK
+
+AOC_POS_SET_BENCHMARK(PosSetBenchmark<aoc::Pos>, "Pos");
+AOC_POS_SET_BENCHMARK(PosSetBenchmark<aoc::PackedPos>, "PackedPos");
@@ -0,0 +1,81 @@
+#include "aoc_benchmarks.h"
+
+#include <filesystem>
+
+namespace {
+
+// Synthetic inputs are written once per size to the temp directory and removed at exit.
+class InputFiles {
+  absl::flat_hash_map<i64, std::string> _paths;
+
+ public:
+  ~InputFiles() {
+    for (const auto& [_, path] : _paths) std::filesystem::remove(path);
+  }
+  const std::string& Get(const i64 size) {
+    if (_paths.contains(size)) return _paths.at(size);
+    auto path = std::filesystem::temp_directory_path() / fmt::format("aoc_input_{}.txt", size);
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    // Lines shaped like a typical puzzle input, e.g. 2024/01.
+    std::string chunk;
+    while (chunk.size() < (1 << 20)) chunk += "48514   27399\n";
+    for (i64 written = 0; written < size; written += static_cast<i64>(chunk.size())) {
+      f.write(chunk.data(), std::min(static_cast<i64>(chunk.size()), size - written));
+    }
+    return _paths[size] = path.string();
+  }
+};
+InputFiles input_files;
+
+// The loading path advent::GetInput used before InputFile: ifstream -> stringstream -> string ->
+// trimmed substr.
+std::string LoadWithStringStream(const std::string& path) {
+  std::ifstream f(path);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  std::string result = ss.str();
+  auto it = std::find_if(result.rbegin(), result.rend(), absl::ascii_isprint);
+  return result.substr(0, static_cast<size_t>(result.rend() - it));
+}
+
+// Mapped pages are only faulted in when read, so range(1) == 1 adds a single pass over the input
+// (what every parser does first) to keep the comparison honest.
+u64 Touch(const std::string_view input) { return absl::c_count(input, '\n'); }
+
+void InputStringStreamBenchmark(benchmark::State& state) {
+  const auto& path = input_files.Get(state.range(0));
+  for (auto _ : state) {
+    std::string input = LoadWithStringStream(path);
+    if (state.range(1)) benchmark::DoNotOptimize(Touch(input));
+    benchmark::DoNotOptimize(input);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template<aoc::InputMode MODE>
+void InputFileBenchmark(benchmark::State& state) {
+  const auto& path = input_files.Get(state.range(0));
+  aoc::InputFile file;
+  for (auto _ : state) {
+    file.Load(path, MODE);
+    std::string_view input = aoc::TrimInput(file.Contents());
+    if (state.range(1)) benchmark::DoNotOptimize(Touch(input));
+    benchmark::DoNotOptimize(input);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+#ifndef AOC_INPUT_BENCHMARK
+#define AOC_INPUT_BENCHMARK(func, name) BENCHMARK(func)\
+    ->Name("Input-" name)\
+    ->ArgNames({"bytes", "touch"})\
+    ->ArgsProduct({benchmark::CreateRange(10 << 10, 1 << 30, 10), {0, 1}})\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_INPUT_BENCHMARK
+
+AOC_INPUT_BENCHMARK(InputStringStreamBenchmark, "StringStream");
+AOC_INPUT_BENCHMARK(InputFileBenchmark<aoc::InputMode::kCopy>, "Copy");
+AOC_INPUT_BENCHMARK(InputFileBenchmark<aoc::InputMode::kMapped>, "Mapped");
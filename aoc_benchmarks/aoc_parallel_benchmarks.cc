@@ -0,0 +1,69 @@
+#include "aoc_benchmarks.h"
+
+#include <aoc_parallel.h>
+
+#include <thread>
+
+namespace {
+
+constexpr i64 kBuyers = 2048;
+
+// 2000 rounds of the 2024/22 secret generator per buyer: an even, CPU-bound load.
+u64 Secrets(const i64 begin, const i64 end) {
+  u64 total = 0;
+  for (i64 buyer = begin; buyer < end; buyer++) {
+    u32 secret = static_cast<u32>(buyer * 7919 + 1);
+    for (u32 i = 0; i < 2000; i++) {
+      secret = (secret ^ (secret << 6)) & 0xFFFFFF;
+      secret = (secret ^ (secret >> 5)) & 0xFFFFFF;
+      secret = (secret ^ (secret << 11)) & 0xFFFFFF;
+    }
+    // One buyer at a time, or the compiler vectorizes across them and the grain skews the load.
+    benchmark::DoNotOptimize(secret);
+    total += secret;
+  }
+  return total;
+}
+
+// The same load as `Secrets`, but buyer b runs b % 64 times as long, like machines of 2025/10.
+u64 UnevenSecrets(const i64 begin, const i64 end) {
+  u64 total = 0;
+  for (i64 buyer = begin; buyer < end; buyer++) {
+    for (i64 r = 0; r <= buyer % 64; r++) total += Secrets(buyer, buyer + 1);
+  }
+  return total / 32;
+}
+
+template<u64 (*kLoad)(i64, i64)>
+void ReduceBenchmark(benchmark::State& state) {
+  aoc::parallel::ThreadPool pool(state.range(0));
+  const i64 grain = state.range(1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        aoc::parallel::ParallelReduce(pool, kBuyers, grain, u64{0}, kLoad, std::plus<>{}));
+  }
+  state.SetItemsProcessed(state.iterations() * kBuyers);
+}
+
+// Threads from 1 to every core, with fine and coarse grains.
+void ThreadArgs(benchmark::internal::Benchmark* b) {
+  const i64 cores = std::max<i64>(std::thread::hardware_concurrency(), 1);
+  for (const i64 grain : {1, 64}) {
+    for (i64 threads = 1; threads < cores; threads *= 2) b->Args({threads, grain});
+    b->Args({cores, grain});
+  }
+}
+
+}  // namespace
+
+#ifndef AOC_PARALLEL_BENCHMARK
+#define AOC_PARALLEL_BENCHMARK(func, name) BENCHMARK(func)\
+    ->Name("Parallel-" name)\
+    ->ArgNames({"threads", "grain"})\
+    ->Apply(ThreadArgs)\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_PARALLEL_BENCHMARK
+
+AOC_PARALLEL_BENCHMARK(ReduceBenchmark<Secrets>, "Reduce/Even");
+AOC_PARALLEL_BENCHMARK(ReduceBenchmark<UnevenSecrets>, "Reduce/Uneven");
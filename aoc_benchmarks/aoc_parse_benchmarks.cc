@@ -0,0 +1,125 @@
+#include "aoc_benchmarks.h"
+
+#include <random>
+
+namespace {
+
+// Lines shaped like a typical puzzle input, e.g. 2024/01, `bytes` long.
+std::string LinesInput(const i64 bytes) {
+  std::string input;
+  while (static_cast<i64>(input.size()) < bytes) input += "48514   27399\n";
+  input.resize(bytes);
+  return input;
+}
+
+// The split most solvers start with: every line materialised into a vector first.
+void SplitStrSplitBenchmark(benchmark::State& state) {
+  const std::string input = LinesInput(state.range(0));
+  for (auto _ : state) {
+    std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
+    u64 total = 0;
+    for (auto line : lines) total += line.size();
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void SplitTokensBenchmark(benchmark::State& state) {
+  const std::string input = LinesInput(state.range(0));
+  for (auto _ : state) {
+    u64 total = 0;
+    for (auto line : aoc::util::Tokens(input)) total += line.size();
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Space separated numbers of up to `max_digits` digits, negative about half the time if `T` is
+// signed, `bytes` long.
+template<std::integral T>
+std::string NumbersInput(const i64 bytes, const u32 max_digits) {
+  std::mt19937_64 rng(1);
+  std::string input;
+  while (static_cast<i64>(input.size()) < bytes) {
+    const u32 digits = 1 + rng() % max_digits;
+    if (std::is_signed_v<T> && rng() % 2) input.push_back('-');
+    const u64 low = aoc::kTenPowers[digits - 1];
+    input += fmt::format("{} ", low + rng() % (9 * low));
+  }
+  input.resize(input.rfind(' ', bytes));
+  return input;
+}
+
+// FasterScanList before it parsed eight digits at a time: split on the separator and hand every
+// token to fast_float.
+template<std::integral T>
+void FastFloatScanList(const std::string_view input, std::vector<T>& list, const char separator) {
+  const char* ptr = input.data();
+  const char* const end = ptr + input.size();
+  while (ptr < end) {
+    T x;
+    auto result = fast_float::from_chars(ptr, end, x);
+    CHECK(result.ec == std::errc()) << "Couldn't parse '" << ptr << "'.";
+    list.push_back(x);
+    ptr = result.ptr;
+    while (ptr < end && *ptr == separator) ptr++;
+  }
+}
+
+template<std::integral T, u32 MAX_DIGITS>
+void IntegersFastScanListBenchmark(benchmark::State& state) {
+  const std::string input = NumbersInput<T>(state.range(0), MAX_DIGITS);
+  for (auto _ : state) {
+    std::vector<T> list;
+    aoc::util::FastScanList(input, list);
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+template<std::integral T, u32 MAX_DIGITS>
+void IntegersFastFloatBenchmark(benchmark::State& state) {
+  const std::string input = NumbersInput<T>(state.range(0), MAX_DIGITS);
+  for (auto _ : state) {
+    std::vector<T> list;
+    FastFloatScanList(input, list, ' ');
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+template<std::integral T, u32 MAX_DIGITS>
+void IntegersFasterScanListBenchmark(benchmark::State& state) {
+  const std::string input = NumbersInput<T>(state.range(0), MAX_DIGITS);
+  for (auto _ : state) {
+    std::vector<T> list;
+    aoc::util::FasterScanList(input, list);
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+}  // namespace
+
+#ifndef AOC_PARSE_BENCHMARK
+#define AOC_PARSE_BENCHMARK(func, name) BENCHMARK(func)\
+    ->Name("Parse-" name)\
+    ->ArgName("bytes")\
+    ->RangeMultiplier(16)\
+    ->Range(16 << 10, 64 << 20)\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_PARSE_BENCHMARK
+
+AOC_PARSE_BENCHMARK(SplitStrSplitBenchmark, "Split/StrSplit");
+AOC_PARSE_BENCHMARK(SplitTokensBenchmark, "Split/Tokens");
+
+AOC_PARSE_BENCHMARK((IntegersFastScanListBenchmark<u32, 9>), "Integers/u32/FastScanList");
+AOC_PARSE_BENCHMARK((IntegersFastFloatBenchmark<u32, 9>), "Integers/u32/FastFloat");
+AOC_PARSE_BENCHMARK((IntegersFasterScanListBenchmark<u32, 9>), "Integers/u32/FasterScanList");
+AOC_PARSE_BENCHMARK((IntegersFastScanListBenchmark<u64, 19>), "Integers/u64/FastScanList");
+AOC_PARSE_BENCHMARK((IntegersFastFloatBenchmark<u64, 19>), "Integers/u64/FastFloat");
+AOC_PARSE_BENCHMARK((IntegersFasterScanListBenchmark<u64, 19>), "Integers/u64/FasterScanList");
+AOC_PARSE_BENCHMARK((IntegersFastScanListBenchmark<i64, 18>), "Integers/i64/FastScanList");
+AOC_PARSE_BENCHMARK((IntegersFastFloatBenchmark<i64, 18>), "Integers/i64/FastFloat");
+AOC_PARSE_BENCHMARK((IntegersFasterScanListBenchmark<i64, 18>), "Integers/i64/FasterScanList");
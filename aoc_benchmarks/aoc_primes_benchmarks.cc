@@ -0,0 +1,132 @@
+#include "aoc_benchmarks.h"
+
+#include <aoc_primes.h>
+
+#include <random>
+
+namespace {
+
+// The sieve, factorization and LCM of aoc::util before aoc_primes.h: a std::vector<bool> of every
+// number up to the limit, trial division by all of its primes, and the LCM from the factors.
+std::vector<u64> VectorSieve(const u64 limit) {
+  if (limit < 2) return {};
+  std::vector<bool> sieve(limit, false);
+  sieve[0] = true;
+  sieve[1] = true;
+  std::vector<u64> primes;
+  for (u64 loop = 0; loop < limit; ++loop) {
+    if (!sieve[loop]) {
+      primes.push_back(loop);
+      for (u64 j = loop * loop; j < limit; j += loop) sieve[j] = true;
+    }
+  }
+  return primes;
+}
+
+absl::flat_hash_map<u64, u64> TrialDivision(const u64 x, const std::vector<u64>& primes) {
+  absl::flat_hash_map<u64, u64> result{};
+  u64 rem{x};
+  for (u64 pi = 0; rem != 1 && pi < primes.size(); pi++) {
+    while (rem % primes[pi] == 0) {
+      ++result[primes[pi]];
+      rem /= primes[pi];
+    }
+  }
+  CHECK(rem == 1) << "Need more primes.";
+  return result;
+}
+
+u64 FactorizedLCM(const std::vector<u64>& values) {
+  const std::vector<u64> primes = VectorSieve(*absl::c_max_element(values) + 1);
+  absl::flat_hash_map<u64, u64> common_factors{};
+  for (const u64 value : values) {
+    for (auto [prime, power] : TrialDivision(value, primes)) {
+      if (common_factors[prime] < power) common_factors[prime] = power;
+    }
+  }
+  u64 lcm = 1;
+  for (auto [prime, power] : common_factors) {
+    for (u64 i = 0; i < power; i++) lcm *= prime;
+  }
+  return lcm;
+}
+
+// Cycle lengths like those of 2023/08 and 2023/20: distinct primes around `size` times a shared
+// one, so the LCM is their product.
+std::vector<u64> CycleLengths(const u64 size) {
+  std::vector<u64> primes = aoc::primes::Primes(2 * size);
+  std::vector<u64> cycles;
+  for (u64 i = 0; i < 5; i++) cycles.push_back(primes[primes.size() - 1 - 3 * i] * 263);
+  return cycles;
+}
+
+void SieveVectorBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(VectorSieve(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void SieveSegmentedBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aoc::primes::SievePrimes(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void SieveCachedBenchmark(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aoc::primes::Primes(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Random numbers below `state.range(0)`, each factorized from scratch.
+void FactorizeTrialDivisionBenchmark(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  for (auto _ : state) {
+    const u64 n = 2 + rng() % state.range(0);
+    benchmark::DoNotOptimize(TrialDivision(n, VectorSieve(n + 1)));
+  }
+}
+
+void FactorizePollardRhoBenchmark(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aoc::primes::Factorize(2 + rng() % state.range(0)));
+  }
+}
+
+void LCMFactorizedBenchmark(benchmark::State& state) {
+  const auto cycles = CycleLengths(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FactorizedLCM(cycles));
+  }
+}
+
+void LCMGcdBenchmark(benchmark::State& state) {
+  const auto cycles = CycleLengths(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aoc::util::LCM(cycles));
+  }
+}
+
+}  // namespace
+
+#ifndef AOC_PRIMES_BENCHMARK
+#define AOC_PRIMES_BENCHMARK(func, name, max) BENCHMARK(func)\
+    ->Name("Primes-" name)\
+    ->ArgName("limit")\
+    ->RangeMultiplier(32)\
+    ->Range(1 << 10, (max))\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_PRIMES_BENCHMARK
+
+AOC_PRIMES_BENCHMARK(SieveVectorBenchmark, "Sieve/Vector", 1 << 25);
+AOC_PRIMES_BENCHMARK(SieveSegmentedBenchmark, "Sieve/Segmented", 1 << 25);
+AOC_PRIMES_BENCHMARK(SieveCachedBenchmark, "Sieve/Cached", 1 << 25);
+AOC_PRIMES_BENCHMARK(FactorizeTrialDivisionBenchmark, "Factorize/TrialDivision", 1 << 20);
+AOC_PRIMES_BENCHMARK(FactorizePollardRhoBenchmark, "Factorize/PollardRho", 1 << 30);
+AOC_PRIMES_BENCHMARK(LCMFactorizedBenchmark, "LCM/Factorized", 1 << 20);
+AOC_PRIMES_BENCHMARK(LCMGcdBenchmark, "LCM/Gcd", 1 << 20);
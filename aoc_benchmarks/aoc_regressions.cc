@@ -0,0 +1,407 @@
+// Records the benchmarks of this build as a baseline, or compares them with a recorded one.
+//
+//   aoc_regressions record [--commit id] [options] [benchmark flags]
+//   aoc_regressions compare <baseline> [contender] [options] [benchmark flags]
+//
+// A baseline is <store>/<commit>.json with the time per iteration of every repetition of every
+// benchmark. `compare` runs the benchmarks (and records them) unless given a contender baseline,
+// then prints one row per benchmark and exits with 1 if any of them regressed, or if a benchmark
+// of the baseline that the contender should have run is missing from it (renamed or removed).
+#include <aoc.h>
+#include <benchmark/benchmark.h>
+
+#include <absl/strings/numbers.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+
+namespace {
+
+constexpr absl::string_view kDefaultStore = ".aoc_bench";
+// The days end to end, parse and solve; the scaled and micro benchmarks are opt-in by filter.
+// AOC_BENCHMARK times real time, which Google Benchmark appends to the name as /real_time.
+constexpr absl::string_view kDefaultFilter = "^AoC-[0-9]+-[0-9]+(/parse|/solve)?(/real_time)?$";
+
+void PrintUsage(const char* argv0) {
+  fmt::print(
+      stderr,
+      "Usage: {0} record [--commit id] [options] [benchmark flags]\n"
+      "       {0} compare <baseline> [contender] [options] [benchmark flags]\n"
+      "  baseline, contender: a commit id recorded in the store, or a path to a .json file\n"
+      "  --commit: name of the recorded baseline (default: git rev-parse --short HEAD)\n"
+      "  --store: where baselines are kept (default: {1})\n"
+      "  --repetitions: runs of every benchmark (default: 10)\n"
+      "  --threshold: change of the median in percent that counts as a regression (default: 5)\n"
+      "  --alpha: significance level of the Mann-Whitney U test (default: 0.05)\n"
+      "  benchmark flags go to Google Benchmark; the default filter is {2}\n",
+      argv0, kDefaultStore, kDefaultFilter);
+}
+
+// Times per iteration in nanoseconds, one per repetition, by benchmark name.
+struct Baseline {
+  std::string commit;
+  std::vector<std::pair<std::string, std::vector<double>>> benchmarks;
+};
+
+std::string JsonString(const absl::string_view str) {
+  std::string out{'"'};
+  for (char c : str) {
+    if (c == '"' || c == '\\') out.push_back('\\');
+    out.push_back(c);
+  }
+  out.push_back('"');
+  return out;
+}
+
+bool Write(const Baseline& baseline, const std::filesystem::path& path) {
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  std::ofstream out(path);
+  if (!out.is_open()) return false;
+  out << fmt::format("{{\n  \"commit\": {},\n  \"benchmarks\": [", JsonString(baseline.commit));
+  for (u64 b = 0; b < baseline.benchmarks.size(); b++) {
+    const auto& [name, times] = baseline.benchmarks[b];
+    out << fmt::format(
+        "{}\n    {{\"name\": {}, \"real_time_ns\": [{:.1f}]}}", b == 0 ? "" : ",", JsonString(name),
+        fmt::join(times, ", "));
+  }
+  out << "\n  ]\n}\n";
+  return out.good();
+}
+
+// Reads the JSON written by Write(). Just enough JSON for that: unknown keys are skipped, but
+// only if their values are strings, numbers or arrays of them.
+class BaselineReader {
+  absl::string_view _json;
+
+  void SkipSpace() {
+    while (!_json.empty() && absl::ascii_isspace(_json.front())) _json.remove_prefix(1);
+  }
+  bool Consume(const char c) {
+    SkipSpace();
+    if (_json.empty() || _json.front() != c) return false;
+    _json.remove_prefix(1);
+    return true;
+  }
+  bool String(std::string& out) {
+    if (!Consume('"')) return false;
+    out.clear();
+    while (!_json.empty() && _json.front() != '"') {
+      if (_json.front() == '\\') _json.remove_prefix(1);
+      if (_json.empty()) return false;
+      out.push_back(_json.front());
+      _json.remove_prefix(1);
+    }
+    return Consume('"');
+  }
+  bool Number(double& out) {
+    SkipSpace();
+    const u64 end = _json.find_first_of(",]} \n");
+    if (!absl::SimpleAtod(_json.substr(0, end), &out)) return false;
+    _json.remove_prefix(std::min(end, _json.size()));
+    return true;
+  }
+  // A comma separated list up to `close`, calling `item()` for every element.
+  template<typename Item>
+  bool List(const char close, Item&& item) {
+    if (Consume(close)) return true;
+    do {
+      if (!item()) return false;
+    } while (Consume(','));
+    return Consume(close);
+  }
+  bool SkipValue() {
+    SkipSpace();
+    std::string ignored;
+    double number;
+    if (!_json.empty() && _json.front() == '"') return String(ignored);
+    if (Consume('[')) return List(']', [&] { return SkipValue(); });
+    return Number(number);
+  }
+
+ public:
+  explicit BaselineReader(const absl::string_view json) : _json(json) {}
+
+  bool Read(Baseline& baseline) {
+    std::string key;
+    return Consume('{') && List('}', [&] {
+      if (!String(key) || !Consume(':')) return false;
+      if (key == "commit") return String(baseline.commit);
+      if (key != "benchmarks") return SkipValue();
+      return Consume('[') && List(']', [&] {
+        auto& [name, times] = baseline.benchmarks.emplace_back();
+        return Consume('{') && List('}', [&] {
+          if (!String(key) || !Consume(':')) return false;
+          if (key == "name") return String(name);
+          if (key != "real_time_ns") return SkipValue();
+          return Consume('[') && List(']', [&] { return Number(times.emplace_back()); });
+        });
+      });
+    });
+  }
+};
+
+std::optional<Baseline> Read(const std::filesystem::path& path) {
+  std::ifstream in(path);
+  if (!in.is_open()) return std::nullopt;
+  std::stringstream json;
+  json << in.rdbuf();
+  Baseline baseline;
+  if (!BaselineReader(json.str()).Read(baseline)) return std::nullopt;
+  return baseline;
+}
+
+// A commit id from the store, or a path to a baseline file.
+std::filesystem::path BaselinePath(const absl::string_view name, const std::string& store) {
+  if (name.ends_with(".json")) return std::filesystem::path(name);
+  return std::filesystem::path(store) / fmt::format("{}.json", name);
+}
+
+std::string CurrentCommit() {
+  std::string commit;
+  if (FILE* git = popen("git rev-parse --short HEAD 2>/dev/null", "r")) {
+    char buffer[64];
+    while (fgets(buffer, sizeof(buffer), git) != nullptr) commit += buffer;
+    pclose(git);
+  }
+  commit = absl::StripAsciiWhitespace(commit);
+  return commit.empty() ? "unknown" : commit;
+}
+
+// Keeps the time per iteration of every repetition while the console shows the usual report.
+class RecordingReporter : public benchmark::ConsoleReporter {
+  Baseline& _baseline;
+
+ public:
+  explicit RecordingReporter(Baseline& baseline) : _baseline(baseline) {}
+
+  void ReportRuns(const std::vector<Run>& runs) override {
+    for (const auto& run : runs) {
+      if (run.run_type != Run::RT_Iteration || run.skipped || run.iterations == 0) continue;
+      const std::string name = run.benchmark_name();
+      auto it = absl::c_find_if(_baseline.benchmarks, [&](const auto& b) { return b.first == name; });
+      if (it == _baseline.benchmarks.end()) it = _baseline.benchmarks.insert(it, {name, {}});
+      it->second.push_back(run.real_accumulated_time * 1e9 / static_cast<double>(run.iterations));
+    }
+    ConsoleReporter::ReportRuns(runs);
+  }
+};
+
+double Median(std::vector<double> values) {
+  absl::c_sort(values);
+  const u64 n = values.size();
+  return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// Median absolute deviation from the median.
+double Mad(const std::vector<double>& values) {
+  const double median = Median(values);
+  std::vector<double> deviations;
+  for (double v : values) deviations.push_back(std::abs(v - median));
+  return Median(deviations);
+}
+
+// Two-sided p-value of the Mann-Whitney U test that `a` and `b` come from the same distribution,
+// by the normal approximation with tie correction. 1 when either has fewer than 3 samples.
+double MannWhitneyP(const std::vector<double>& a, const std::vector<double>& b) {
+  const double n1 = a.size(), n2 = b.size(), n = n1 + n2;
+  if (a.size() < 3 || b.size() < 3) return 1;
+  std::vector<std::pair<double, bool>> all;
+  for (double v : a) all.emplace_back(v, true);
+  for (double v : b) all.emplace_back(v, false);
+  absl::c_sort(all);
+  double rank_sum_a = 0, ties = 0;
+  for (u64 i = 0; i < all.size();) {
+    u64 j = i;
+    while (j < all.size() && all[j].first == all[i].first) j++;
+    const double t = j - i, rank = (i + j + 1) / 2.0;
+    for (u64 k = i; k < j; k++) rank_sum_a += all[k].second ? rank : 0;
+    ties += t * t * t - t;
+    i = j;
+  }
+  const double u = rank_sum_a - n1 * (n1 + 1) / 2;
+  const double sigma = std::sqrt(n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1))));
+  if (sigma == 0) return 1;
+  const double z = (std::abs(u - n1 * n2 / 2) - 0.5) / sigma;
+  return std::erfc(std::max(z, 0.0) / std::sqrt(2.0));
+}
+
+std::string Duration(const double ns) {
+  if (ns >= 1e9) return fmt::format("{:.3f} s", ns / 1e9);
+  if (ns >= 1e6) return fmt::format("{:.3f} ms", ns / 1e6);
+  if (ns >= 1e3) return fmt::format("{:.3f} us", ns / 1e3);
+  return fmt::format("{:.1f} ns", ns);
+}
+
+// Whether Google Benchmark runs `name` under `--benchmark_filter=filter`: an extended regex
+// searched for in the name, or, with a leading '-', one that must not be found.
+bool MatchesFilter(const std::string& name, absl::string_view filter) {
+  const bool negative = filter.starts_with('-');
+  if (negative) filter.remove_prefix(1);
+  if (filter.empty() || filter == "all") return !negative;
+  return std::regex_search(name, std::regex(std::string(filter), std::regex::extended)) != negative;
+}
+
+struct Verdicts {
+  u32 regressions{0};
+  // Benchmarks of the baseline the contender should have but doesn't.
+  u32 missing{0};
+};
+
+// Prints one row per benchmark of `contender`, then one per benchmark of `base` that `contender`
+// lacks although `filter` selects it, and counts both kinds of failure. New benchmarks pass.
+Verdicts Compare(
+    const Baseline& base, const Baseline& contender, const absl::string_view filter,
+    const double threshold, const double alpha) {
+  fmt::print(
+      "\nComparing {} against {} (threshold {}%, alpha {})\n{:<36} {:>12} {:>12} {:>9} {:>15} {:>7}  {}\n",
+      contender.commit, base.commit, threshold, alpha, "Benchmark", "Baseline", "Contender", "Change",
+      "MAD base/new", "p", "");
+  Verdicts verdicts;
+  for (const auto& [name, times] : contender.benchmarks) {
+    const auto it = absl::c_find_if(base.benchmarks, [&](const auto& b) { return b.first == name; });
+    if (it == base.benchmarks.end() || it->second.empty() || times.empty()) {
+      fmt::print("{:<36} {:>12} {:>12}{:34}{}\n", name, "-",
+                 times.empty() ? "-" : Duration(Median(times)), "",
+                 it == base.benchmarks.end() ? "new" : "");
+      continue;
+    }
+    const double old_median = Median(it->second), new_median = Median(times);
+    const double change = (new_median - old_median) / old_median * 100;
+    const double p = MannWhitneyP(it->second, times);
+    absl::string_view verdict = "";
+    if (p < alpha && change > threshold) {
+      verdict = "REGRESSION";
+      verdicts.regressions++;
+    } else if (p < alpha && change < -threshold) {
+      verdict = "improvement";
+    }
+    fmt::print(
+        "{:<36} {:>12} {:>12} {:>+8.1f}% {:>6.1f}%/{:>5.1f}% {:>7.4f}  {}\n", name, Duration(old_median),
+        Duration(new_median), change, Mad(it->second) / old_median * 100, Mad(times) / new_median * 100,
+        p, verdict);
+  }
+  for (const auto& [name, times] : base.benchmarks) {
+    if (!MatchesFilter(name, filter)) continue;
+    if (absl::c_any_of(contender.benchmarks, [&](const auto& b) { return b.first == name; })) continue;
+    fmt::print("{:<36} {:>12} {:>12}{:34}MISSING\n", name,
+               times.empty() ? "-" : Duration(Median(times)), "-", "");
+    verdicts.missing++;
+  }
+  return verdicts;
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  std::string commit;
+  std::string store{kDefaultStore};
+  u32 repetitions = 10;
+  double threshold = 5;
+  double alpha = 0.05;
+  // The contender's filter, which decides the baseline's benchmarks it must have. A stored
+  // contender must have all of them.
+  absl::string_view filter = kDefaultFilter;
+  std::vector<absl::string_view> positional;
+  // argv[0] and the flags for Google Benchmark, which doesn't know ours.
+  std::vector<char*> benchmark_args{argv[0]};
+  for (int a = 1; a < argc; a++) {
+    absl::string_view arg = argv[a];
+    bool ok = true;
+    if (arg == "--commit" && a + 1 < argc) {
+      commit = argv[++a];
+    } else if (arg == "--store" && a + 1 < argc) {
+      store = argv[++a];
+    } else if (arg == "--repetitions" && a + 1 < argc) {
+      ok = absl::SimpleAtoi(argv[++a], &repetitions) && repetitions > 0;
+    } else if (arg == "--threshold" && a + 1 < argc) {
+      ok = absl::SimpleAtod(argv[++a], &threshold);
+    } else if (arg == "--alpha" && a + 1 < argc) {
+      ok = absl::SimpleAtod(argv[++a], &alpha);
+    } else if (arg.starts_with("--benchmark_")) {
+      if (arg.starts_with("--benchmark_filter=")) filter = arg.substr(arg.find('=') + 1);
+      benchmark_args.push_back(argv[a]);
+    } else {
+      positional.push_back(arg);
+    }
+    if (!ok) {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+  const bool record = positional.size() == 1 && positional[0] == "record";
+  const bool compare = positional.size() >= 2 && positional.size() <= 3 && positional[0] == "compare";
+  if (!record && !compare) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::optional<Baseline> base;
+  if (compare) {
+    base = Read(BaselinePath(positional[1], store));
+    if (!base) {
+      fmt::print(stderr, "Could not read baseline '{}'.\n", positional[1]);
+      return 1;
+    }
+  }
+
+  Baseline contender;
+  if (positional.size() == 3) {
+    auto stored = Read(BaselinePath(positional[2], store));
+    if (!stored) {
+      fmt::print(stderr, "Could not read baseline '{}'.\n", positional[2]);
+      return 1;
+    }
+    contender = *std::move(stored);
+    filter = "";
+  } else {
+    contender.commit = commit.empty() ? CurrentCommit() : commit;
+    // Repetitions interleaved across benchmarks, so a slow spell of the machine doesn't land on
+    // one benchmark only.
+    std::string repetitions_flag = fmt::format("--benchmark_repetitions={}", repetitions);
+    std::string interleaving_flag = "--benchmark_enable_random_interleaving=true";
+    std::string filter_flag = fmt::format("--benchmark_filter={}", kDefaultFilter);
+    benchmark_args.insert(benchmark_args.begin() + 1, {repetitions_flag.data(), interleaving_flag.data()});
+    if (filter == kDefaultFilter) benchmark_args.insert(benchmark_args.begin() + 1, filter_flag.data());
+    int benchmark_argc = static_cast<int>(benchmark_args.size());
+    benchmark::Initialize(&benchmark_argc, benchmark_args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmark_argc, benchmark_args.data())) return 1;
+    RecordingReporter reporter(contender);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    // Interleaving shuffles the run order; the report goes by name, which is by day.
+    absl::c_sort(contender.benchmarks);
+    if (contender.benchmarks.empty()) {
+      fmt::print(stderr, "No benchmark ran; nothing was recorded.\n");
+      return 1;
+    }
+
+    const auto path = BaselinePath(contender.commit, store);
+    if (!Write(contender, path)) {
+      fmt::print(stderr, "Could not write baseline '{}'.\n", path.string());
+      return 1;
+    }
+    fmt::print("Recorded {} benchmarks as {}.\n", contender.benchmarks.size(), path.string());
+  }
+
+  if (!compare) return 0;
+  // An empty side would compare nothing and pass.
+  for (const Baseline* baseline : {&*base, &contender}) {
+    if (baseline->benchmarks.empty()) {
+      fmt::print(stderr, "Baseline '{}' has no benchmarks.\n", baseline->commit);
+      return 1;
+    }
+  }
+  const auto [regressions, missing] = Compare(*base, contender, filter, threshold, alpha);
+  if (regressions > 0) {
+    fmt::print("{} benchmark(s) regressed more than {}%.\n", regressions, threshold);
+  }
+  if (missing > 0) {
+    fmt::print("{} benchmark(s) of {} are missing from {}, renamed or removed.\n", missing,
+               base->commit, contender.commit);
+  }
+  return regressions > 0 || missing > 0 ? 1 : 0;
+}
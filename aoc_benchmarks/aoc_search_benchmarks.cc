@@ -0,0 +1,128 @@
+#include "aoc_benchmarks.h"
+
+#include <aoc_search.h>
+
+#include <random>
+
+namespace {
+
+// A `size` x `size` map of random heat losses 1 to 9, shaped like 2023/17.
+std::string HeatInput(const i64 size) {
+  std::mt19937_64 rng(1);
+  std::string input;
+  for (i64 i = 0; i < size; i++) {
+    for (i64 j = 0; j < size; j++) {
+      input.push_back(static_cast<char>('1' + rng() % 9));
+    }
+    input.push_back('\n');
+  }
+  input.pop_back();
+  return input;
+}
+
+aoc::Grid<u8> HeatMap(const i64 size) {
+  return {HeatInput(size), [](const char ch) { return static_cast<u8>(ch - '0'); }, 1, 0};
+}
+
+// Corner to corner Dijkstra the way the solvers did it before aoc::search: a binary heap of
+// tuples and a hash set of settled tiles.
+u64 DijkstraPriorityQueue(const aoc::Grid<u8>& map) {
+  using Node = std::tuple<u64, i64>;
+  const auto offsets = map.Offsets();
+  const i64 goal = map.Index(map.Height() - 1, map.Width() - 1);
+  std::priority_queue<Node, std::vector<Node>, std::greater<>> pq;
+  absl::flat_hash_set<i64> visited;
+  pq.emplace(0, map.Index(0, 0));
+  while (!pq.empty()) {
+    const auto [distance, pos] = pq.top();
+    pq.pop();
+    if (pos == goal) return distance;
+    if (!visited.insert(pos).second) continue;
+    for (const i64 offset : offsets) {
+      const i64 new_pos = pos + offset;
+      if (map[new_pos] == 0 || visited.contains(new_pos)) continue;
+      pq.emplace(distance + map[new_pos], new_pos);
+    }
+  }
+  return -1;
+}
+
+u64 DijkstraEngine(const aoc::Grid<u8>& map, aoc::search::ShortestPaths<>& search) {
+  const auto offsets = map.Offsets();
+  const i64 goal = map.Index(map.Height() - 1, map.Width() - 1);
+  return search.Run(
+      {{map.Index(0, 0)}},
+      [&](const aoc::search::State& from, auto&& edge) {
+        for (const i64 offset : offsets) {
+          const i64 new_pos = from.index + offset;
+          if (map[new_pos] != 0) edge({new_pos}, map[new_pos]);
+        }
+      },
+      [&](const aoc::search::State& state) { return state.index == goal; });
+}
+
+void DijkstraPriorityQueueBenchmark(benchmark::State& state) {
+  const auto map = HeatMap(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DijkstraPriorityQueue(map));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+void DijkstraEngineBenchmark(benchmark::State& state) {
+  const auto map = HeatMap(state.range(0));
+  aoc::search::ShortestPaths<> search(map.Size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DijkstraEngine(map, search));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+// Push and pop of random small keys in Dijkstra order, on either queue.
+void QueueStdBenchmark(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  std::priority_queue<std::pair<u32, u32>, std::vector<std::pair<u32, u32>>, std::greater<>> pq;
+  for (auto _ : state) {
+    u32 last = 0;
+    for (u32 n = 0; n < state.range(0); n++) {
+      pq.emplace(last + rng() % 10, n);
+      if (n % 2) {
+        last = pq.top().first;
+        pq.pop();
+      }
+    }
+    while (!pq.empty()) pq.pop();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void QueueRadixHeapBenchmark(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  aoc::search::RadixHeap<u32> pq;
+  for (auto _ : state) {
+    u32 last = 0;
+    for (u32 n = 0; n < state.range(0); n++) {
+      pq.Push(last + rng() % 10, n);
+      if (n % 2) last = pq.Pop().first;
+    }
+    pq.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+#ifndef AOC_SEARCH_BENCHMARK
+#define AOC_SEARCH_BENCHMARK(func, name) BENCHMARK(func)\
+    ->Name("Search-" name)\
+    ->ArgName("size")\
+    ->RangeMultiplier(4)\
+    ->Range(64, 1024)\
+    ->Unit(benchmark::kMicrosecond)\
+    ->UseRealTime()
+#endif // AOC_SEARCH_BENCHMARK
+
+AOC_SEARCH_BENCHMARK(DijkstraPriorityQueueBenchmark, "Dijkstra/PriorityQueue");
+AOC_SEARCH_BENCHMARK(DijkstraEngineBenchmark, "Dijkstra/Engine");
+AOC_SEARCH_BENCHMARK(QueueStdBenchmark, "Queue/PriorityQueue");
+AOC_SEARCH_BENCHMARK(QueueRadixHeapBenchmark, "Queue/RadixHeap");
@@ -1,6 +1,6 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
-namespace {
+namespace aoc_2020_01 {
 
 auto FindSumGoal(std::vector<u32>::const_iterator begin,
                  std::vector<u32>::const_iterator end, u32 goal)
@@ -18,15 +18,25 @@ auto FindSumGoal(std::vector<u32>::const_iterator begin,
   return std::nullopt;
 }
 
-}  // namespace
+}  // namespace aoc_2020_01
 
 template<>
-auto advent<2020, 1>::solve() -> Result {
-  std::string input = GetInput();
-  std::vector<u32> expenses = aoc::util::TokenizeInput<u32>(
-      input,
-      [](absl::string_view s) { return scn::scan_value<u32>(s).value(); });
+struct advent<2020, 1>::Parsed {
+  std::vector<u32> expenses;
+};
+
+template<>
+auto advent<2020, 1>::Parse() -> std::shared_ptr<const Parsed> {
+  std::vector<u32> expenses;
+  aoc::util::FastScanList(input, expenses, "\n");
   absl::c_sort(expenses);
+  return std::make_shared<Parsed>(std::move(expenses));
+}
+
+template<>
+auto advent<2020, 1>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2020_01;
+  const auto& [expenses] = parsed;
 
   auto p1 =
       FindSumGoal(expenses.cbegin(), expenses.cend(), 2020).value();
@@ -40,4 +50,8 @@ auto advent<2020, 1>::solve() -> Result {
     }
   }
   return aoc::result(p1, p2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2020, 1>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2020, 1>::PartTwo() -> std::string { return ""; }
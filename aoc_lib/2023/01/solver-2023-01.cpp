@@ -1,7 +1,7 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 #include <absl/container/flat_hash_map.h>
 
-namespace {
+namespace aoc_2023_01 {
 
 absl::flat_hash_map<absl::string_view, int> word_value = {
     {"0", 0}, {"zero", 0},
@@ -44,14 +44,25 @@ int findDigits(absl::string_view input, const std::vector<absl::string_view> &ke
   return 10 * first + last;
 }
 
-}  // namespace
+}  // namespace aoc_2023_01
 
 template<>
-auto advent<2023, 1>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 1>::Parsed {
+  std::vector<absl::string_view> lines;
+};
+
+template<>
+auto advent<2023, 1>::Parse() -> std::shared_ptr<const Parsed> {
   std::vector<absl::string_view> lines = aoc::util::TokenizeInput<absl::string_view>(
       input,
       [](absl::string_view line) { return line; });
+  return std::make_shared<Parsed>(std::move(lines));
+}
+
+template<>
+auto advent<2023, 1>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_01;
+  const auto& [lines] = parsed;
 
   // Part 1
   std::vector<int> calibrations1;
@@ -72,4 +83,8 @@ auto advent<2023, 1>::solve() -> Result {
   });
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 1>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 1>::PartTwo() -> std::string { return ""; }
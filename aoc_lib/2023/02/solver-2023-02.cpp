@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <ostream>
 #include <absl/container/flat_hash_map.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_02 {
 
 RE2 CubeCountPattern = ("(\\d+) (red|green|blue)(?:, )?");
 
@@ -34,11 +34,16 @@ struct Game {
   std::vector<CubeSet> sets;
 };
 
-}  // namespace
+}  // namespace aoc_2023_02
 
 template<>
-auto advent<2023, 2>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 2>::Parsed {
+  std::vector<aoc_2023_02::Game> games;
+};
+
+template<>
+auto advent<2023, 2>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_02;
   std::vector<absl::string_view> lines = aoc::util::TokenizeInput<absl::string_view>(
       input,
       [](absl::string_view line) { return line; });
@@ -46,9 +51,10 @@ auto advent<2023, 2>::solve() -> Result {
   std::vector<Game> games;
   absl::c_transform(lines, std::back_inserter(games), [](auto line) {
     Game game;
-    auto ret = scn::scan(line, "Game {}: ", game.id);
-    assert(ret);
-    std::string sets_part = ret.range_as_string();
+    auto ret = scn::scan<u64>(line, "Game {}: ");
+    CHECK(ret) << "Couldn't parse game id from '" << line << "'";
+    game.id = ret->value();
+    absl::string_view sets_part(ret->begin(), ret->end());
     std::vector<absl::string_view> sets_list = absl::StrSplit(sets_part, "; ");
     for (auto set_str : sets_list) {
       CubeSet cube_set;
@@ -62,6 +68,13 @@ auto advent<2023, 2>::solve() -> Result {
     }
     return game;
   });
+  return std::make_shared<Parsed>(std::move(games));
+}
+
+template<>
+auto advent<2023, 2>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_02;
+  const auto& [games] = parsed;
 
   // Part 1
   u64 part1 = 0;
@@ -112,4 +125,8 @@ auto advent<2023, 2>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 2>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 2>::PartTwo() -> std::string { return ""; }
@@ -1,9 +1,9 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <ostream>
 #include <absl/container/flat_hash_map.h>
 
-namespace {
+namespace aoc_2023_03 {
 
 using LineSymbolsByColumn = absl::flat_hash_map<int, char>;
 using SymbolsByLine = absl::flat_hash_map<int, LineSymbolsByColumn>;
@@ -35,11 +35,18 @@ int ParseNum(InputIt *first, InputIt last) {
   return num;
 }
 
-}  // namespace
+}  // namespace aoc_2023_03
 
 template<>
-auto advent<2023, 3>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 3>::Parsed {
+  aoc_2023_03::SymbolsByLine symbols;
+  aoc_2023_03::Gears gears;
+  aoc_2023_03::NumbersByLine numbers;
+};
+
+template<>
+auto advent<2023, 3>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_03;
   std::vector<absl::string_view> lines = aoc::util::TokenizeInput<absl::string_view>(
       input,
       [](absl::string_view line) { return line; });
@@ -72,6 +79,15 @@ auto advent<2023, 3>::solve() -> Result {
       it = std::find_if_not(++it, line.end(), is_dot);
     }
   }
+  return std::make_shared<Parsed>(std::move(symbols), std::move(gears), std::move(numbers));
+}
+
+template<>
+auto advent<2023, 3>::Solve(const Parsed& parsed) -> Result {
+  const auto& symbols = parsed.symbols;
+  const auto& numbers = parsed.numbers;
+  // Copied: the numbers adjacent to each gear are collected while scanning.
+  auto gears = parsed.gears;
 
   // Part 1 & Part 2
   u64 part1 = 0;
@@ -107,4 +123,8 @@ auto advent<2023, 3>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 3>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 3>::PartTwo() -> std::string { return ""; }
@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <ostream>
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 
-namespace {
+namespace aoc_2023_04 {
 
 using NumSet = std::set<u16>;
 struct Card {
@@ -15,15 +15,15 @@ struct Card {
 
 Card parseCard(absl::string_view line) {
   std::vector<absl::string_view> parts = absl::StrSplit(line, ':', absl::SkipWhitespace());
-  u16 id{};
-  auto ret = scn::scan(parts.at(0), "Card {}", id);
+  auto ret = scn::scan<u16>(parts.at(0), "Card {}");
   CHECK(ret) << "Couldn't parse card id from '" << parts.at((0)) << "'";
+  u16 id = ret->value();
   std::vector num_sets =
       aoc::util::TokenizeInput<NumSet>(
           parts.at(1),
           [](absl::string_view num_list) {
             std::vector<u16> nums;
-            CHECK(scn::scan_list(num_list, nums)) << "Problem with '" << num_list << "'";
+            aoc::util::FastScanList(num_list, nums);
             return NumSet(nums.begin(), nums.end());
           },
           " | ");
@@ -31,14 +31,25 @@ Card parseCard(absl::string_view line) {
   return {id, num_sets.at(0), num_sets.at(1)};
 }
 
-}  // namespace
+}  // namespace aoc_2023_04
 
 template<>
-auto advent<2023, 4>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 4>::Parsed {
+  std::vector<aoc_2023_04::Card> cards;
+};
+
+template<>
+auto advent<2023, 4>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_04;
   std::vector<Card> cards = aoc::util::TokenizeInput<Card>(
       input,
       [](absl::string_view line) { return parseCard(line); });
+  return std::make_shared<Parsed>(std::move(cards));
+}
+
+template<>
+auto advent<2023, 4>::Solve(const Parsed& parsed) -> Result {
+  const auto& [cards] = parsed;
 
   // Part 1 & Part 2
   u64 part1 = 0;
@@ -64,4 +75,8 @@ auto advent<2023, 4>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 4>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 4>::PartTwo() -> std::string { return ""; }
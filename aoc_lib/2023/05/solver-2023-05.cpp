@@ -1,4 +1,4 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <ostream>
 #include <absl/container/btree_map.h>
@@ -7,7 +7,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
-namespace {
+namespace aoc_2023_05 {
 
 // Representation of MapTypes, ordered by application order.
 enum MapType {
@@ -65,13 +65,13 @@ using MappedRangeSet = absl::btree_map<Range, bool, RangeLess>;
 // Implicit assumption that range-from and range-to have the same number of elements.
 using Mapping = absl::btree_map<Range, Range, RangeLess>;
 // The holder of all mappings, keyed by MapType.
-absl::flat_hash_map<MapType, Mapping> maps{};
+using Maps = absl::flat_hash_map<MapType, Mapping>;
 
 // Parses the first line of input.
 std::vector<u64> ParseSeeds(absl::string_view line) {
   CHECK(line.substr(0, 7) == "seeds: ") << "Not a seeds line ('" << line << "').";
   std::vector<u64> seeds;
-  CHECK(scn::scan_list(line.substr(7), seeds)) << "Could not parse seeds.";
+  aoc::util::FastScanList(line.substr(7), seeds);
   return seeds;
 }
 // Maps a single value.
@@ -131,7 +131,7 @@ RangeSet SplitRangeSet(const Range &range, const Mapping &mapping) {
   return result;
 }
 
-u64 GetLocationForSeed(u64 seed) {
+u64 GetLocationForSeed(const Maps &maps, u64 seed) {
   u64 result{seed};
   for (MapType m = SEED_SOIL; m <= HUMD_LOCT; m = (MapType) ((int) m + 1)) {
     const auto &map = maps.at(m);
@@ -147,7 +147,7 @@ u64 GetLocationForSeed(u64 seed) {
   return result;
 }
 
-RangeSet GetLocationForSeedRange(const Range &seedRange) {
+RangeSet GetLocationForSeedRange(const Maps &maps, const Range &seedRange) {
   RangeSet input{};
   RangeSet result{};
   result.insert(seedRange);
@@ -173,40 +173,56 @@ RangeSet GetLocationForSeedRange(const Range &seedRange) {
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2023_05
 
 namespace fmt {
 
 template<>
-struct fmt::formatter<Range> : ostream_formatter {};
+struct formatter<aoc_2023_05::Range> : ostream_formatter {};
 
 }  // namespace fmt
 
 template<>
-auto advent<2023, 5>::solve() -> Result {
-  std::string input = GetInput();
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
-  std::vector<u64> seeds = ParseSeeds(lines.at(0));
+struct advent<2023, 5>::Parsed {
+  std::vector<u64> seeds;
+  aoc_2023_05::Maps maps;
+};
+
+template<>
+auto advent<2023, 5>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_05;
+  aoc::util::Tokens lines(input);
+  auto it = lines.begin();
+  CHECK(it != lines.end()) << "Empty input.";
+  std::vector<u64> seeds = ParseSeeds(*it);
+  Maps maps;
   MapType mapType{UNKNOWN};
-  for (int l = 1; l < lines.size(); l++) {
-    auto line = lines.at(l);
+  for (++it; it != lines.end(); ++it) {
+    absl::string_view line = *it;
     if (line.at(0) < '0' || line.at(0) > '9') {
-      auto ret = scn::scan_value<std::string>(line);
-      CHECK(ret && ret.has_value()) << "Could not parse map type '" << line << "'";
-      mapType = mapTypes.at(ret.value());
+      auto name = line.substr(0, line.find(' '));
+      CHECK(mapTypes.contains(name)) << "Could not parse map type '" << line << "'";
+      mapType = mapTypes.at(name);
       continue;
     }
-    u64 dst{};
-    u64 src{};
-    u64 len{};
-    CHECK(scn::scan(line, "{}{}{}", dst, src, len)) << "Couldn't parse mapping '" << line << "'";
+    std::vector<u64> values;
+    aoc::util::FastScanList(line, values);
+    CHECK(values.size() == 3) << "Couldn't parse mapping '" << line << "'";
+    const auto [dst, src, len] = std::tie(values[0], values[1], values[2]);
     maps[mapType][{src, src + len - 1}] = {dst, dst + len - 1};
   }
+  return std::make_shared<Parsed>(std::move(seeds), std::move(maps));
+}
+
+template<>
+auto advent<2023, 5>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_05;
+  const auto& [seeds, maps] = parsed;
 
   // Part 1
   u64 part1 = std::numeric_limits<u64>::max();
   for (u64 seed : seeds) {
-    u64 loc = GetLocationForSeed(seed);
+    u64 loc = GetLocationForSeed(maps, seed);
     if (part1 > loc) {
       part1 = loc;
     }
@@ -224,11 +240,15 @@ auto advent<2023, 5>::solve() -> Result {
   }
 
   for (const Range &seedRange : seeds2) {
-    auto locRanges = GetLocationForSeedRange(seedRange);
+    auto locRanges = GetLocationForSeedRange(maps, seedRange);
     if (part2 > locRanges.begin()->start) {
       part2 = locRanges.begin()->start;
     }
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 5>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 5>::PartTwo() -> std::string { return ""; }
@@ -1,11 +1,11 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 #include <cfenv>
 #include <re2/re2.h>
 #pragma STDC FENV_ACCESS ON
 
-namespace {
+namespace aoc_2023_06 {
 
 RE2 SpacesPattern = ("\\s+");
 
@@ -13,7 +13,7 @@ std::vector<u16> ParsePart1Line(absl::string_view line) {
   std::vector<absl::string_view> splits = absl::StrSplit(line, ':', absl::SkipWhitespace());
   CHECK(splits.size() == 2);
   std::vector<u16> numbers;
-  CHECK(scn::scan_list(splits.at(1), numbers)) << "Could not parse numbers '" << line << "'.";
+  aoc::util::FastScanList(splits.at(1), numbers);
   return numbers;
 }
 u64 ParsePart2Line(absl::string_view line) {
@@ -22,7 +22,8 @@ u64 ParsePart2Line(absl::string_view line) {
   std::vector<absl::string_view> splits = absl::StrSplit(kerning_fixed, ':', absl::SkipWhitespace());
   CHECK(splits.size() == 2);
   u64 number{};
-  CHECK(scn::scan_default(splits.at(1), number)) << "Could not parse number '" << splits.at(1) << "'.";
+  auto [_, ec] = std::from_chars(splits.at(1).data(), splits.at(1).data() + splits.at(1).size(), number);
+  CHECK(ec == std::errc()) << "Could not parse number '" << splits.at(1) << "'.";
   return number;
 }
 
@@ -46,17 +47,34 @@ std::pair<u64, u64> CalculateWinningLimits(u64 time, u64 distance) {
   return {ti1, ti2};
 }
 
-}  // namespace
+}  // namespace aoc_2023_06
 
 template<>
-auto advent<2023, 6>::solve() -> Result {
-  std::string input = GetInput();
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
+struct advent<2023, 6>::Parsed {
+  std::vector<u16> times;
+  std::vector<u16> distances;
+  u64 actual_time;
+  u64 actual_distance;
+};
 
-  // Part 1
+template<>
+auto advent<2023, 6>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_06;
+  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   std::vector<u16> times = ParsePart1Line(lines.at(0));
   std::vector<u16> distances = ParsePart1Line(lines.at(1));
   CHECK(times.size() == distances.size());
+  return std::make_shared<Parsed>(
+      std::move(times), std::move(distances), ParsePart2Line(lines.at(0)),
+      ParsePart2Line(lines.at(1)));
+}
+
+template<>
+auto advent<2023, 6>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_06;
+  const auto& [times, distances, actual_time, actual_distance] = parsed;
+
+  // Part 1
   u64 part1 = 1;
   for (int i = 0; i < times.size(); i++) {
     auto winning_limits = CalculateWinningLimits(times.at(i), distances.at(i));
@@ -64,10 +82,12 @@ auto advent<2023, 6>::solve() -> Result {
   }
 
   // Part 2
-  u64 actual_time = ParsePart2Line(lines.at(0));
-  u64 actual_distance = ParsePart2Line(lines.at(1));
   auto winning_limit = CalculateWinningLimits(actual_time, actual_distance);
   u64 part2 = winning_limit.second - winning_limit.first + 1;
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 6>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 6>::PartTwo() -> std::string { return ""; }
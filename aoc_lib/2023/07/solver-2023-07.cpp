@@ -1,11 +1,11 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 #include "fmt/ostream.h"
 
-namespace {
+namespace aoc_2023_07 {
 
 using Card = char;
 const absl::btree_map<Card, u8> cardOrdering1{
@@ -146,31 +146,44 @@ TypeEnum GetType2(absl::string_view hand) {
   }
 }
 
-}  // namespace
+}  // namespace aoc_2023_07
 
 namespace fmt {
 
 template<>
-struct fmt::formatter<Type> : ostream_formatter {};
+struct formatter<aoc_2023_07::Type> : ostream_formatter {};
 template<>
-struct fmt::formatter<Hand < 1>> : ostream_formatter {
-};
+struct formatter<aoc_2023_07::Hand<1>> : ostream_formatter {};
 template<>
-struct fmt::formatter<Hand<2>> : ostream_formatter {};
+struct formatter<aoc_2023_07::Hand<2>> : ostream_formatter {};
 
 }  // namespace fmt
 
 template<>
-auto advent<2023, 7>::solve() -> Result {
-  std::string input = GetInput();
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
+struct advent<2023, 7>::Parsed {
+  std::vector<aoc_2023_07::HandBid<1>> handBids;
+};
+
+template<>
+auto advent<2023, 7>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_07;
   std::vector<HandBid<1>> handBids = aoc::util::TokenizeInput<HandBid<1>>(input, [](absl::string_view line) {
     HandBid<1> handBid{};
-    CHECK(scn::scan(line, "{} {}", handBid.handType.hand.val, handBid.bid));
-    CHECK(handBid.handType.hand.val.size() == 5);
+    auto space = line.find(' ');
+    CHECK(space == 5) << "Couldn't parse hand from '" << line << "'";
+    handBid.handType.hand.val = line.substr(0, space);
+    auto [_, ec] = std::from_chars(line.data() + space + 1, line.data() + line.size(), handBid.bid);
+    CHECK(ec == std::errc()) << "Couldn't parse bid from '" << line << "'";
     handBid.handType.type.val = GetType1(handBid.handType.hand.val);
     return handBid;
   });
+  return std::make_shared<Parsed>(std::move(handBids));
+}
+
+template<>
+auto advent<2023, 7>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_07;
+  const auto& [handBids] = parsed;
 
   // Part 1
   u64 part1 = 0;
@@ -198,4 +211,8 @@ auto advent<2023, 7>::solve() -> Result {
     part2 += rank++ * bid;
   }
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 7>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 7>::PartTwo() -> std::string { return ""; }
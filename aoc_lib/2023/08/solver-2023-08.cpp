@@ -1,4 +1,5 @@
-#include <aoc.hpp>
+#include <aoc.h>
+#include <aoc_graph.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
@@ -7,17 +8,17 @@
 #include <fmt/ostream.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_08 {
 
 RE2 NodePattern(R"((...) = \((...), (...)\))");
 enum Move {
   LEFT,
   RIGHT
 };
-using Node = absl::string_view;
+using Node = u32;
 struct Instruction {
-  Node left;
-  Node right;
+  Node left{aoc::Interner::kNotFound};
+  Node right{aoc::Interner::kNotFound};
   [[nodiscard]] inline Node MoveLeftRight(Move move) const {
     return move == LEFT ? left : right;
   }
@@ -25,57 +26,81 @@ struct Instruction {
     return os << fmt::format("({}, {})", i.left, i.right);
   }
 };
-using Map = absl::flat_hash_map<Node, Instruction>;
+// Indexed by node.
+using Map = std::vector<Instruction>;
 
-u64 SolvePart1(Node start, const absl::flat_hash_set<Node> &targets, const Map &map, const std::vector<Move> &moves) {
+u64 SolvePart1(Node start, const std::vector<bool> &targets, const Map &map,
+               const std::vector<Move> &moves) {
   u64 result{0};
   Node node{start};
-  while (!targets.contains(node)) {
+  while (!targets[node]) {
     for (Move move : moves) {
-      node = map.at(node).MoveLeftRight(move);
+      node = map[node].MoveLeftRight(move);
     }
     result += moves.size();
   }
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2023_08
 
 namespace fmt {
 
 template<>
-struct fmt::formatter<Instruction> : ostream_formatter {};
+struct formatter<aoc_2023_08::Instruction> : ostream_formatter {};
 
 }  // namespace fmt
 
 template<>
-auto advent<2023, 8>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 8>::Parsed {
+  std::vector<aoc_2023_08::Move> moves;
+  aoc::Interner nodes;
+  aoc_2023_08::Map map;
+};
+
+template<>
+auto advent<2023, 8>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_08;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   std::vector<Move> moves{};
   absl::c_transform(lines.at(0), std::back_inserter(moves), [](char c) { return c == 'L' ? LEFT : RIGHT; });
-  absl::flat_hash_map<Node, Instruction> map;
-  std::for_each(lines.begin() + 1, lines.end(), [&map](absl::string_view line) {
-    Node key;
-    Instruction inst;
-    CHECK(RE2::FullMatch(line, NodePattern, &key, &inst.left, &inst.right))
+  aoc::Interner nodes;
+  Map map;
+  std::for_each(lines.begin() + 1, lines.end(), [&nodes, &map](absl::string_view line) {
+    absl::string_view key, left, right;
+    CHECK(RE2::FullMatch(line, NodePattern, &key, &left, &right))
             << "Unable to parse '" << line << "'.";
-    map[key] = inst;
+    const Node node = nodes.Intern(key);
+    const Instruction inst{nodes.Intern(left), nodes.Intern(right)};
+    if (map.size() < nodes.Size()) map.resize(nodes.Size());
+    map[node] = inst;
   });
+  CHECK(map.size() == lines.size() - 1 && map.size() == nodes.Size())
+      << "Every node needs exactly one line.";
+  return std::make_shared<Parsed>(std::move(moves), std::move(nodes), std::move(map));
+}
+
+template<>
+auto advent<2023, 8>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_08;
+  const auto& [moves, nodes, map] = parsed;
 
   // Part 1
-  u64 part1 = SolvePart1("AAA", {"ZZZ"}, map, moves);
+  const Node aaa = nodes.Find("AAA"), zzz = nodes.Find("ZZZ");
+  CHECK(aaa != aoc::Interner::kNotFound && zzz != aoc::Interner::kNotFound) << "No AAA or ZZZ.";
+  std::vector<bool> targets(nodes.Size(), false);
+  targets[zzz] = true;
+  u64 part1 = SolvePart1(aaa, targets, map, moves);
 
   // Part 2
   absl::flat_hash_set<u64> solutions{part1};
   std::vector<Node> starts;
-  absl::flat_hash_set<Node> targets;
-  for (const auto &[key, _] : map) {
+  for (Node node = 0; node < nodes.Size(); node++) {
+    const absl::string_view key = nodes.Name(node);
     if (key[2] == 'A' && key != "AAA") {
-      starts.push_back(key);
-    } else if (key[2] == 'Z') {
-      targets.insert(key);
+      starts.push_back(node);
     }
+    targets[node] = key[2] == 'Z';
   }
   for (const Node start : starts) {
     u64 solution = SolvePart1(start, targets, map, moves);
@@ -85,4 +110,8 @@ auto advent<2023, 8>::solve() -> Result {
   u64 part2 = aoc::util::LCM(solutions);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 8>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 8>::PartTwo() -> std::string { return ""; }
@@ -1,11 +1,11 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_09 {
 
 using History = std::deque<i64>;
 
@@ -17,17 +17,30 @@ History GetNextSequence(const History &sequence) {
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2023_09
 
 template<>
-auto advent<2023, 9>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 9>::Parsed {
+  std::vector<aoc_2023_09::History> histories;
+};
+
+template<>
+auto advent<2023, 9>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_09;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   std::vector<History> histories{};
   absl::c_for_each(lines, [&histories](absl::string_view line) {
-    histories.emplace_back();
-    CHECK(scn::scan_list(line, histories.back()));
+    std::vector<i64> values;
+    aoc::util::FastScanList(line, values);
+    histories.emplace_back(values.begin(), values.end());
   });
+  return std::make_shared<Parsed>(std::move(histories));
+}
+
+template<>
+auto advent<2023, 9>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_09;
+  const auto& [histories] = parsed;
 
   u64 part1 = 0;
   u64 part2 = 0;
@@ -49,4 +62,8 @@ auto advent<2023, 9>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 9>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 9>::PartTwo() -> std::string { return ""; }
@@ -1,4 +1,4 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
@@ -6,7 +6,7 @@
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_10 {
 
 enum Dir { N, S, W, E };
 using Pipe = char;
@@ -69,8 +69,8 @@ std::tuple<i32, i32, Dir> Follow(const Map &map, i32 row, i32 col, Dir dir) {
 }
 
 void FillPaint(Map &map, i32 row, i32 col, char paint) {
-  static u32 height = map.size();
-  static u32 width = map.at(0).size();
+  const u32 height = map.size();
+  const u32 width = map.at(0).size();
   if (row < 0 || row >= height || col < 0 || col >= width) return;
   if (map[row][col] != FREE) return;
   std::deque<std::tuple<i32, i32>> q;
@@ -149,28 +149,28 @@ void PaintPathSides(Map &map, i32 row, i32 col, Dir arrived_by_going, Pipe pipe)
   }
 }
 
-}  // namespace
+}  // namespace aoc_2023_10
 
 namespace fmt {
 
 template<>
-struct fmt::formatter<Map> : formatter<string_view> {
-  static auto format(const Map &m, format_context &ctx) {
+struct formatter<aoc_2023_10::Map> : formatter<string_view> {
+  static auto format(const aoc_2023_10::Map &m, format_context &ctx) {
     std::vector<std::string> rows;
-    absl::c_transform(m, std::back_inserter(rows), [](std::vector<Pipe> row) {
+    absl::c_transform(m, std::back_inserter(rows), [](std::vector<aoc_2023_10::Pipe> row) {
       return fmt::format("{}", string_view{row.data(), row.size()});
     });
     return fmt::format_to(ctx.out(), "{}", fmt::join(rows, "\n"));
   }
 };
 template<>
-struct fmt::formatter<Dir> : formatter<string_view> {
-  auto format(Dir dir, format_context &ctx) const {
+struct formatter<aoc_2023_10::Dir> : formatter<string_view> {
+  auto format(aoc_2023_10::Dir dir, format_context &ctx) const {
     switch (dir) {
-      case N: return formatter<string_view>::format("N", ctx);
-      case S: return formatter<string_view>::format("S", ctx);
-      case E: return formatter<string_view>::format("E", ctx);
-      case W: return formatter<string_view>::format("W", ctx);
+      case aoc_2023_10::N: return formatter<string_view>::format("N", ctx);
+      case aoc_2023_10::S: return formatter<string_view>::format("S", ctx);
+      case aoc_2023_10::E: return formatter<string_view>::format("E", ctx);
+      case aoc_2023_10::W: return formatter<string_view>::format("W", ctx);
     }
   }
 };
@@ -178,8 +178,15 @@ struct fmt::formatter<Dir> : formatter<string_view> {
 }  // namespace fmt
 
 template<>
-auto advent<2023, 10>::solve() -> Result {
-  std::string input = GetInput(false);
+struct advent<2023, 10>::Parsed {
+  aoc_2023_10::Map map;
+  i32 start_row;
+  i32 start_col;
+};
+
+template<>
+auto advent<2023, 10>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_10;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   u32 height = lines.size();
   u32 width = lines.at(0).size();
@@ -197,6 +204,15 @@ auto advent<2023, 10>::solve() -> Result {
       }
     }
   }
+  return std::make_shared<Parsed>(std::move(map), start_row, start_col);
+}
+
+template<>
+auto advent<2023, 10>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_10;
+  const auto& [map, start_row, start_col] = parsed;
+  const u32 height = map.size();
+  const u32 width = map.at(0).size();
 
   // Prep for part 2
   Map paintMap{};
@@ -277,4 +293,8 @@ auto advent<2023, 10>::solve() -> Result {
   });
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 10>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 10>::PartTwo() -> std::string { return ""; }
@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <absl/container/btree_set.h>
 #include <Eigen/Dense>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2023_11 {
 
 using Sky = Eigen::Matrix<u8, Eigen::Dynamic, Eigen::Dynamic>;
 using Galaxy = std::pair<i32, i32>;
@@ -65,19 +65,24 @@ u64 FindPairDistances(const IndexSet &expanded_rows,
         j2 = galaxies[j].second;
       }
       result += i2 - i1 + j2 - j1;
-      u64 empty_rows = expanded_rows.upper_bound(i2) - expanded_rows.lower_bound(i1);
-      u64 empty_cols = expanded_cols.upper_bound(j2) - expanded_cols.lower_bound(j1);
+      u64 empty_rows = std::distance(expanded_rows.lower_bound(i1), expanded_rows.upper_bound(i2));
+      u64 empty_cols = std::distance(expanded_cols.lower_bound(j1), expanded_cols.upper_bound(j2));
       result += expansion_factor * (empty_rows + empty_cols);
     }
   }
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2023_11
 
 template<>
-auto advent<2023, 11>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 11>::Parsed {
+  aoc_2023_11::Sky sky;
+};
+
+template<>
+auto advent<2023, 11>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_11;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   u32 height = lines.size();
   u32 width = lines.at(0).size();
@@ -88,6 +93,13 @@ auto advent<2023, 11>::solve() -> Result {
       sky(row, col) = lines.at(row).at(col) == '#' ? 1 : 0;
     }
   }
+  return std::make_shared<Parsed>(std::move(sky));
+}
+
+template<>
+auto advent<2023, 11>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_11;
+  const auto& [sky] = parsed;
 
   // Part 1
   auto [empty_rows, empty_cols] = ExpandSky(sky);
@@ -99,4 +111,8 @@ auto advent<2023, 11>::solve() -> Result {
   u64 part2 = FindPairDistances(empty_rows, empty_cols, finder.finds, 999'999ll);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 11>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 11>::PartTwo() -> std::string { return ""; }
@@ -1,10 +1,11 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
+#include <aoc_parallel.h>
 
 #include <absl/container/flat_hash_map.h>
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_12 {
 
 RE2 kLinePattern(R"(([.?#]+) ([0-9,]+))");
 using Group = std::tuple<i32, i32>;
@@ -76,22 +77,33 @@ u64 CountMatches(absl::string_view pattern, const Groups &groups, Cache &cache)
   return matches;
 }
 
-}  // namespace
+}  // namespace aoc_2023_12
 
 template<>
-auto advent<2023, 12>::solve() -> Result {
-  std::string input = GetInput(false);
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
+struct advent<2023, 12>::Parsed {
+  std::vector<std::string> patterns1;
+  std::vector<aoc_2023_12::Groups> group_sets1;
+};
 
-  std::vector<std::string> patterns1(lines.size());
-  std::vector<Groups> group_sets1(lines.size());
-  for (i32 i = 0; i < lines.size(); i++) {
+template<>
+auto advent<2023, 12>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_12;
+  std::vector<std::string> patterns1;
+  std::vector<Groups> group_sets1;
+  for (absl::string_view line : aoc::util::Tokens(input)) {
     std::string group_str;
-    CHECK(RE2::FullMatch(lines.at(i), kLinePattern, &patterns1[i], &group_str))
-            << "Couldn't parse '" << lines.at(i) << "'.";
-    CHECK(scn::scan_list_ex(group_str, group_sets1[i], scn::list_separator(',')))
-            << "Couldn't parse '" << group_str << "'.";
+    CHECK(RE2::FullMatch(line, kLinePattern, &patterns1.emplace_back(), &group_str))
+            << "Couldn't parse '" << line << "'.";
+    aoc::util::FastScanList(group_str, group_sets1.emplace_back(), ",");
+    CHECK(!group_sets1.back().empty()) << "Couldn't parse '" << group_str << "'.";
   }
+  return std::make_shared<Parsed>(std::move(patterns1), std::move(group_sets1));
+}
+
+template<>
+auto advent<2023, 12>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_12;
+  const auto& [patterns1, group_sets1] = parsed;
 
   // Part 1
   u64 part1 = 0;
@@ -101,9 +113,8 @@ auto advent<2023, 12>::solve() -> Result {
   }
 
   // Part 2
-  u64 part2 = 0;
-  std::vector<std::string> patterns2(lines.size());
-  std::vector<Groups> group_sets2(lines.size());
+  std::vector<std::string> patterns2(patterns1.size());
+  std::vector<Groups> group_sets2(patterns1.size());
   for (i32 i = 0; i < patterns1.size(); i++) {
     patterns2[i] = fmt::format("{0}?{0}?{0}?{0}?{0}", patterns1.at(i));
     for (i32 j = 0; j < 5; j++) {
@@ -113,10 +124,22 @@ auto advent<2023, 12>::solve() -> Result {
     }
   }
 
-  cache.clear();
-  for (i32 i = 0; i < patterns2.size(); i++) {
-    part2 += CountMatches(patterns2.at(i), group_sets2.at(i), cache);
-  }
+  // Rows are independent: every chunk of them gets its own cache.
+  u64 part2 = aoc::parallel::ParallelReduce(
+      patterns2.size(), 32, u64{0},
+      [&](i64 begin, i64 end) {
+        Cache chunk_cache{};
+        u64 matches = 0;
+        for (i64 i = begin; i < end; i++) {
+          matches += CountMatches(patterns2[i], group_sets2[i], chunk_cache);
+        }
+        return matches;
+      },
+      std::plus<>{});
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 12>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 12>::PartTwo() -> std::string { return ""; }
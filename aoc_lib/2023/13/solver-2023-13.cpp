@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <Eigen/Dense>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
-namespace {
+namespace aoc_2023_13 {
 
 using Pattern = Eigen::MatrixXi;
 Eigen::IOFormat PatterFormat(Eigen::StreamPrecision, 0, "", "\n");
@@ -24,18 +24,20 @@ i32 MirrorAtRowAndDiff(const Pattern &p, i32 j_mirror) {
   return diff.array().abs().sum();
 }
 
-}  // namespace
+}  // namespace aoc_2023_13
 
 namespace fmt {
 
-template<>
-struct formatter<Eigen::WithFormat<Pattern>> : ostream_formatter {};
-
 }  // namespace fmt
 
 template<>
-auto advent<2023, 13>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 13>::Parsed {
+  std::vector<aoc_2023_13::Pattern> patterns;
+};
+
+template<>
+auto advent<2023, 13>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_13;
   std::vector<Pattern> patterns;
   for (auto line_block : absl::StrSplit(input, "\n\n")) {
     std::vector<absl::string_view> lines = absl::StrSplit(line_block, "\n");
@@ -46,6 +48,13 @@ auto advent<2023, 13>::solve() -> Result {
       }
     }
   }
+  return std::make_shared<Parsed>(std::move(patterns));
+}
+
+template<>
+auto advent<2023, 13>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_13;
+  const auto& [patterns] = parsed;
 
   // Part 1
   u64 part1 = 0;
@@ -88,4 +97,8 @@ auto advent<2023, 13>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 13>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 13>::PartTwo() -> std::string { return ""; }
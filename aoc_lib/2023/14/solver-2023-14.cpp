@@ -1,4 +1,4 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
@@ -7,7 +7,7 @@
 #include <fmt/ostream.h>
 #include <functional>
 
-namespace {
+namespace aoc_2023_14 {
 
 using Platform = Eigen::MatrixXi;
 Eigen::IOFormat PlatformFormat(Eigen::StreamPrecision, 0, "", "\n");
@@ -86,18 +86,22 @@ u64 CalculateLoad(const Platform &round) {
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2023_14
 
 namespace fmt {
 
-template<>
-struct formatter<Eigen::WithFormat<Platform>> : ostream_formatter {};
-
 }  // namespace fmt
 
 template<>
-auto advent<2023, 14>::solve() -> Result {
-  std::string input = GetInput(false);
+struct advent<2023, 14>::Parsed {
+  aoc_2023_14::Platform round;
+  absl::btree_map<i32, aoc_2023_14::Splits> splits_by_col;
+  absl::btree_map<i32, aoc_2023_14::Splits> splits_by_row;
+};
+
+template<>
+auto advent<2023, 14>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_14;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   Platform round(lines.size(), lines.at(0).size());
   Platform cubic(lines.size(), lines.at(0).size());
@@ -117,6 +121,16 @@ auto advent<2023, 14>::solve() -> Result {
   for (i32 i = 0; i < round.rows(); i++) {
     splits_by_row[i] = SplitRowByCube(cubic.row(i));
   }
+  return std::make_shared<Parsed>(std::move(round), std::move(splits_by_col), std::move(splits_by_row));
+}
+
+template<>
+auto advent<2023, 14>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_14;
+  const auto& splits_by_col = parsed.splits_by_col;
+  const auto& splits_by_row = parsed.splits_by_row;
+  // Copied: the stones are rolled in place.
+  Platform round = parsed.round;
 
   // Part 1
   RollNorthSouth(round, splits_by_col, true);
@@ -158,4 +172,8 @@ auto advent<2023, 14>::solve() -> Result {
   u64 part2 = CalculateLoad(round);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 14>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 14>::PartTwo() -> std::string { return ""; }
@@ -1,9 +1,9 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <absl/container/flat_hash_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2023_15 {
 
 struct Lens {
   absl::string_view label;
@@ -41,19 +41,19 @@ void RemoveLens(Boxes &boxes, const Lens &lens) {
   box.erase(index);
 }
 
-}  // namespace
+}  // namespace aoc_2023_15
 
 namespace fmt {
 
 template<>
-struct fmt::formatter<Lens> : formatter<string_view> {
-  static auto format(const Lens &l, format_context &ctx) {
+struct formatter<aoc_2023_15::Lens> : formatter<string_view> {
+  static auto format(const aoc_2023_15::Lens &l, format_context &ctx) {
     return fmt::format_to(ctx.out(), "[{} {}]", l.label, l.focal_length);
   }
 };
 template<>
-struct fmt::formatter<Box> : formatter<string_view> {
-  static auto format(const Box &b, format_context &ctx) {
+struct formatter<aoc_2023_15::Box> : formatter<string_view> {
+  static auto format(const aoc_2023_15::Box &b, format_context &ctx) {
     return fmt::format_to(ctx.out(), "{}", fmt::join(b, " "));
   }
 };
@@ -61,9 +61,20 @@ struct fmt::formatter<Box> : formatter<string_view> {
 }  // namespace fmt
 
 template<>
-auto advent<2023, 15>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 15>::Parsed {
+  std::vector<absl::string_view> codes;
+};
+
+template<>
+auto advent<2023, 15>::Parse() -> std::shared_ptr<const Parsed> {
   std::vector<absl::string_view> codes = absl::StrSplit(input, ",", absl::SkipWhitespace());
+  return std::make_shared<Parsed>(std::move(codes));
+}
+
+template<>
+auto advent<2023, 15>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_15;
+  const auto& [codes] = parsed;
 
   // Part 1
   u64 part1{0};
@@ -87,4 +98,8 @@ auto advent<2023, 15>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 15>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 15>::PartTwo() -> std::string { return ""; }
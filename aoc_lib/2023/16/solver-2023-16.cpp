@@ -1,9 +1,10 @@
-#include <aoc.hpp>
+#include <aoc.h>
+#include <aoc_parallel.h>
 
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2023_16 {
 
 enum class Tile : char {
   EMPTY = '.',
@@ -131,38 +132,38 @@ u64 Energize(const Map &map, const Beam &initial_beam) {
   return CountEnergy(beam_map);
 }
 
-}  // namespace
+}  // namespace aoc_2023_16
 
 namespace fmt {
 
 template<>
-struct formatter<Dir> : formatter<char> {
-  auto format(Dir dir, format_context &ctx) const {
+struct formatter<aoc_2023_16::Dir> : formatter<char> {
+  auto format(aoc_2023_16::Dir dir, format_context &ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(dir), ctx);
   }
 };
 template<>
-struct formatter<Tile> : formatter<char> {
-  auto format(Tile tile, format_context &ctx) const {
+struct formatter<aoc_2023_16::Tile> : formatter<char> {
+  auto format(aoc_2023_16::Tile tile, format_context &ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(tile), ctx);
   }
 };
 template<>
-struct formatter<std::vector<Tile>> : formatter<string_view> {
-  auto format(std::vector<Tile> row, format_context &ctx) const {
+struct formatter<std::vector<aoc_2023_16::Tile>> : formatter<string_view> {
+  auto format(std::vector<aoc_2023_16::Tile> row, format_context &ctx) const {
     return formatter<string_view>::format(fmt::format("{}", join(row, "")), ctx);
   }
 };
 template<>
-struct formatter<Map> : formatter<string_view> {
-  auto format(const Map &map, format_context &ctx) const {
+struct formatter<aoc_2023_16::Map> : formatter<string_view> {
+  auto format(const aoc_2023_16::Map &map, format_context &ctx) const {
     return formatter<string_view>::format(fmt::format("{}", join(map, "\n")), ctx);
   }
 };
 
 }  // namespace fmt
 
-namespace {
+namespace aoc_2023_16 {
 
 void PrintMap(const Map &map,
               const BeamMap &beam_map,
@@ -212,11 +213,16 @@ void PrintMap(const Map &map,
   latest.clear();
 }
 
-}  // namespace
+}  // namespace aoc_2023_16
 
 template<>
-auto advent<2023, 16>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 16>::Parsed {
+  aoc_2023_16::Map map;
+};
+
+template<>
+auto advent<2023, 16>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_16;
   Map map = aoc::util::TokenizeInput<std::vector<Tile>>(input, [](auto line) {
     std::vector<Tile> row{line.size()};
     for (i32 i = 0; i < line.size(); i++) {
@@ -224,29 +230,42 @@ auto advent<2023, 16>::solve() -> Result {
     }
     return row;
   });
+  return std::make_shared<Parsed>(std::move(map));
+}
+
+template<>
+auto advent<2023, 16>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_16;
+  const auto& [map] = parsed;
 
   // Part 1
   Beams beams{{{0, -1}, Dir::EAST}};
   u64 part1{Energize(map, {{0, -1}, Dir::EAST})};
 
   // Part 2
-  u64 part2{part1};
-  u32 height = map.size();
-  u32 width = map.at(0).size();
-  u64 energy = Energize(map, {{0, width}, Dir::WEST});
-  if (energy > part2) part2 = energy;
+  i32 height = map.size();
+  i32 width = map.at(0).size();
+  std::vector<Beam> starts{{{0, width}, Dir::WEST}};
   for (i32 i = 1; i < height; i++) {
-    energy = Energize(map, {{i, -1}, Dir::EAST});
-    if (energy > part2) part2 = energy;
-    energy = Energize(map, {{i, width}, Dir::WEST});
-    if (energy > part2) part2 = energy;
+    starts.push_back({{i, -1}, Dir::EAST});
+    starts.push_back({{i, width}, Dir::WEST});
   }
   for (i32 j = 0; j < width; j++) {
-    energy = Energize(map, {{-1, j}, Dir::SOUTH});
-    if (energy > part2) part2 = energy;
-    energy = Energize(map, {{height, j}, Dir::NORTH});
-    if (energy > part2) part2 = energy;
+    starts.push_back({{-1, j}, Dir::SOUTH});
+    starts.push_back({{height, j}, Dir::NORTH});
   }
+  u64 part2 = aoc::parallel::ParallelReduce(
+      starts.size(), 8, part1,
+      [&](i64 begin, i64 end) {
+        u64 energy = 0;
+        for (i64 s = begin; s < end; s++) energy = std::max(energy, Energize(map, starts[s]));
+        return energy;
+      },
+      [](u64 a, u64 b) { return std::max(a, b); });
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 16>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 16>::PartTwo() -> std::string { return ""; }
@@ -1,126 +1,76 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
+#include <aoc_search.h>
 
-#include <absl/container/flat_hash_set.h>
-#include <absl/hash/hash.h>
-#include <Eigen/Dense>
 #include <fmt/format.h>
-#include <fmt/ostream.h>
 
-namespace {
+namespace aoc_2023_17 {
 
-using Map = Eigen::MatrixXi;
-//Eigen::IOFormat MapFormat(Eigen::StreamPrecision, 0, "", "\n");
-struct Node {
-  i32 i;
-  i32 j;
-  u64 heat_loss;
-  aoc::Dir last_dir;
-  i32 dir_length;
-  bool operator>(const Node &r) const {
-    return heat_loss > r.heat_loss;
-  }
-  bool operator==(const Node &r) const {
-    return i == r.i && j == r.j && heat_loss == r.heat_loss && last_dir == r.last_dir && dir_length == r.dir_length;
-  }
-};
-using VisitedNode = std::tuple<i32, i32, aoc::Dir, i32>;
-template<typename H>
-H AbslHashValue(H h, const Node &n) {
-  return H::combine(std::move(h), n.i, n.j, n.heat_loss, n.last_dir, n.dir_length);
-}
-i32 MoveConstraint1(const Node &node, aoc::Dir dir) {
-  return node.last_dir != dir || node.dir_length < 3;
-}
-i32 MoveConstraint2(const Node &node, aoc::Dir dir) {
-  if (node.dir_length == 0) {
-    return 4;
-  }
-  if (node.last_dir != dir && node.dir_length >= 4) {
-    return 4;
-  }
-  if (node.last_dir == dir && node.dir_length < 10) {
-    return 1;
-  }
-  return 0;
-}
-u64 FindBestPath(const Map &map, std::function<i32(const Node &, aoc::Dir)> constraint) {
-  u32 height = map.rows();
-  u32 width = map.cols();
-  u32 goal_i = height - 1;
-  u32 goal_j = width - 1;
-  std::priority_queue<Node, std::vector<Node>, std::greater<>> pq;
-  pq.push({0, 0, 0, aoc::Dir::S, 0});
-  absl::flat_hash_set<VisitedNode> visited{};
+// Heat loss of every block, bordered by 0s which no block has.
+using Map = aoc::Grid<u8>;
+using Search = aoc::search::ShortestPaths<2>;
+// A state is a block and the axis the crucible arrived along, 0 vertical and 1 horizontal. Every
+// move turns onto the other axis and runs `min_run` to `max_run` blocks straight, so the run
+// length needs no place in the state.
+constexpr u32 kVertical = 0;
+constexpr u32 kHorizontal = 1;
 
-  while (!pq.empty()) {
-    const auto cur = pq.top();
-    pq.pop();
-    if (cur.i == goal_i && cur.j == goal_j) {
-      return cur.heat_loss;
-    }
-    VisitedNode visited_node{cur.i, cur.j, cur.last_dir, cur.dir_length};
-    if (visited.count(visited_node)) {
-      // Been here before.
-      continue;
-    }
-    visited.insert(visited_node);
-    for (auto d : aoc::kAllDirs) {
-      if (d == OppositeDir(cur.last_dir)) {
-        // Can't go backwards.
-        continue;
-      }
-      i32 try_move = constraint(cur, d);
-      if (try_move == 0) {
-        // Can't move this way.
-        continue;
-      }
-      auto [di, dj] = MoveDir(d);
-      i32 ni = cur.i + di * try_move;
-      i32 nj = cur.j + dj * try_move;
-      if (ni < 0 || ni >= height || nj < 0 || nj >= width) {
-        // Out of frame.
-        continue;
-      }
-      u64 new_heat_loss = cur.heat_loss;
-      for (i32 m = 1; m <= try_move; m++) {
-        new_heat_loss += map(cur.i + di * m, cur.j + dj * m);
-      }
-
-      pq.push({ni, nj, new_heat_loss, d, d == cur.last_dir ? cur.dir_length + try_move : try_move});
-    }
-  }
-  return -1;
+u64 FindBestPath(const Map &map, i32 min_run, i32 max_run) {
+  const auto offsets = map.Offsets();
+  i64 start = map.Index(0, 0);
+  i64 goal = map.Index(map.Height() - 1, map.Width() - 1);
+  Search search(map.Size());
+  aoc::search::Cost heat_loss = search.Run(
+      {{start, kVertical}, {start, kHorizontal}},
+      [&](const aoc::search::State &from, auto &&edge) {
+        u32 axis = from.dir == kVertical ? kHorizontal : kVertical;
+        // Offsets are in N, E, S, W order: the axis picks E/W or N/S.
+        for (u32 d = (axis == kHorizontal) ? 1 : 0; d < 4; d += 2) {
+          i64 pos = from.index;
+          aoc::search::Cost run_loss = 0;
+          for (i32 run = 1; run <= max_run; run++) {
+            pos += offsets[d];
+            if (map[pos] == 0) break;
+            run_loss += map[pos];
+            if (run >= min_run) edge({pos, axis}, run_loss);
+          }
+        }
+      },
+      [&](const aoc::search::State &state) { return state.index == goal; });
+  CHECK(heat_loss != aoc::search::kUnreachable) << "The factory can't be reached.";
+  return heat_loss;
 }
 
-}  // namespace
-
-namespace fmt {
+}  // namespace aoc_2023_17
 
 template<>
-struct formatter<Eigen::WithFormat<Map>> : ostream_formatter {};
-
-}  // namespace fmt
+struct advent<2023, 17>::Parsed {
+  aoc_2023_17::Map map;
+};
 
 template<>
-auto advent<2023, 17>::solve() -> Result {
-  std::string input = GetInput();
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
-  u32 height = lines.size();
-  u32 width = lines.at(0).size();
-  Map map;
-  map.resize(height, width);
-  for (i32 i = 0; i < height; i++) {
-    for (i32 j = 0; j < width; j++) {
-      map(i, j) = lines.at(i).at(j) - '0';
-    }
-  }
+auto advent<2023, 17>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_17;
+  Map map(input, [](char ch) {
+    CHECK(ch >= '1' && ch <= '9') << "Unexpected heat loss '" << ch << "'.";
+    return static_cast<u8>(ch - '0');
+  }, 1, 0);
+  return std::make_shared<Parsed>(std::move(map));
+}
 
+template<>
+auto advent<2023, 17>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_17;
+  const auto& [map] = parsed;
 
   // Part 1
-  u64 part1 = FindBestPath(map, MoveConstraint1);
+  u64 part1 = FindBestPath(map, 1, 3);
 
   // Part 2
-  u64 part2 = FindBestPath(map, MoveConstraint2);
+  u64 part2 = FindBestPath(map, 4, 10);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 17>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 17>::PartTwo() -> std::string { return ""; }
@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <absl/container/btree_set.h>
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_18 {
 
 RE2 InputPattern(R"(([URDL]) (\d+) \(#([0-9a-f]+)\))");
 struct Instruction {
@@ -39,8 +39,9 @@ Instruction FromColor(absl::string_view color) {
       break;
     default: CHECK(false) << "Unexpected last digit '" << color.back() << "'.";
   }
-  auto hex_str = fmt::format("0x{}", color.substr(0, color.size() - 1));
-  CHECK(scn::scan(hex_str, "{:x}", ins.move)) << "Couldn't parse hex '" << hex_str << "'.";
+  absl::string_view hex_str = color.substr(0, color.size() - 1);
+  auto [ptr, ec] = std::from_chars(hex_str.data(), hex_str.data() + hex_str.size(), ins.move, 16);
+  CHECK(ec == std::errc()) << "Couldn't parse hex '" << hex_str << "'.";
   return ins;
 }
 
@@ -57,13 +58,13 @@ u64 ShoeLace(const std::vector<Instruction> &instructions) {
   return (abs(result) + perimeter) / 2ll + 1ll;
 }
 
-}  // namespace
+}  // namespace aoc_2023_18
 
 namespace fmt {
 
 template<>
-struct formatter<Instruction> : formatter<string_view> {
-  auto format(const Instruction &i, format_context &ctx) const {
+struct formatter<aoc_2023_18::Instruction> : formatter<string_view> {
+  auto format(const aoc_2023_18::Instruction &i, format_context &ctx) const {
     return formatter<string_view>::format(fmt::format("{} {}", i.dir, i.move), ctx);
   }
 };
@@ -71,8 +72,14 @@ struct formatter<Instruction> : formatter<string_view> {
 }  // namespace fmt
 
 template<>
-auto advent<2023, 18>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 18>::Parsed {
+  std::vector<aoc_2023_18::Instruction> instructions1;
+  std::vector<aoc_2023_18::Instruction> instructions2;
+};
+
+template<>
+auto advent<2023, 18>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_18;
   std::vector<absl::string_view> colors;
   std::vector<Instruction>
       instructions1 = aoc::util::TokenizeInput<Instruction>(input, [&colors](absl::string_view line) {
@@ -84,16 +91,26 @@ auto advent<2023, 18>::solve() -> Result {
     ins.dir = ToDir(ins_char);
     return ins;
   });
+  std::vector<Instruction> instructions2;
+  absl::c_transform(colors, std::back_inserter(instructions2), [](absl::string_view color) {
+    return FromColor(color);
+  });
+  return std::make_shared<Parsed>(std::move(instructions1), std::move(instructions2));
+}
+
+template<>
+auto advent<2023, 18>::Solve(const Parsed& parsed) -> Result {
+  const auto& [instructions1, instructions2] = parsed;
 
   // Part 1
   u64 part1 = ShoeLace(instructions1);
 
   // Part 2
-  std::vector<Instruction> instructions2;
-  absl::c_transform(colors, std::back_inserter(instructions2), [](absl::string_view color) {
-    return FromColor(color);
-  });
   u64 part2 = ShoeLace(instructions2);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 18>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 18>::PartTwo() -> std::string { return ""; }
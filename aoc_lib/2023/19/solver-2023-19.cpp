@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_19 {
 
 RE2 kWorkflowPattern(R"(([^{]+){(.*)})");
 RE2 kClausePattern(R"((.)([<>])(\d+):(\w+))");
@@ -66,21 +66,21 @@ std::tuple<bool, bool, RangedPart, RangedPart> SplitRangedPart(const RangedPart
   return std::make_tuple(true, true, success, failure);
 }
 
-}  // namespace
+}  // namespace aoc_2023_19
 
 namespace fmt {
 
 template<>
-struct formatter<Clause> : formatter<string_view> {
-  auto format(const Clause &c, format_context &ctx) const {
+struct formatter<aoc_2023_19::Clause> : formatter<string_view> {
+  auto format(const aoc_2023_19::Clause &c, format_context &ctx) const {
     if (c.is_unconditional) return formatter<string_view>::format(c.target, ctx);
     return formatter<string_view>::format(fmt::format("{}{}{}:{}", c.attr, c.is_less ? '<' : '>', c.val, c.target),
                                           ctx);
   }
 };
 template<>
-struct formatter<Workflow> : formatter<string_view> {
-  auto format(const Workflow &w, format_context &ctx) const {
+struct formatter<aoc_2023_19::Workflow> : formatter<string_view> {
+  auto format(const aoc_2023_19::Workflow &w, format_context &ctx) const {
     return formatter<string_view>::format(fmt::format("{}{{{}}}", w.name, fmt::join(w.clauses, ",")), ctx);
   }
 };
@@ -88,8 +88,14 @@ struct formatter<Workflow> : formatter<string_view> {
 }  // namespace fmt
 
 template<>
-auto advent<2023, 19>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 19>::Parsed {
+  absl::flat_hash_map<absl::string_view, aoc_2023_19::Workflow> workflows;
+  std::vector<aoc_2023_19::Part> parts;
+};
+
+template<>
+auto advent<2023, 19>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_19;
   std::vector<absl::string_view> input_parts = absl::StrSplit(input, "\n\n");
   // Parse workflows.
   absl::flat_hash_map<absl::string_view, Workflow> workflows;
@@ -127,6 +133,13 @@ auto advent<2023, 19>::solve() -> Result {
     p['s'] = s;
     parts.push_back(p);
   }
+  return std::make_shared<Parsed>(std::move(workflows), std::move(parts));
+}
+
+template<>
+auto advent<2023, 19>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_19;
+  const auto& [workflows, parts] = parsed;
 
   // Part 1
   u64 part1 = 0;
@@ -169,4 +182,8 @@ auto advent<2023, 19>::solve() -> Result {
   }
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 19>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 19>::PartTwo() -> std::string { return ""; }
@@ -1,9 +1,10 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
+#include <aoc_graph.h>
 
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2023_20 {
 constexpr absl::string_view kBroadcaster{"broadcaster"};
 constexpr absl::string_view kRx{"rx"};
 enum class ModuleType : char {
@@ -12,59 +13,61 @@ enum class ModuleType : char {
   CNJ = '&',
   UNTYPED = '-'
 };
+using ModuleId = u32;
 struct Module {
   absl::string_view name;
-  ModuleType type;
+  ModuleType type{ModuleType::UNTYPED};
   bool mem{false};
-  std::vector<absl::string_view> targets{};
-  absl::flat_hash_map<absl::string_view, bool> inputs{};
+  std::vector<ModuleId> targets{};
+  // Conjunctions only: the modules sending to this one, whether the last pulse of each was high,
+  // and how many were.
+  std::vector<ModuleId> inputs{};
+  std::vector<bool> input_high{};
+  u32 num_high{0};
   Module() : name() {}
   explicit Module(absl::string_view _name, ModuleType _type) : name(_name), type(_type) {}
-  Module(const Module &o) : name(o.name), type(o.type), mem(o.mem), targets{o.targets}, inputs(o.inputs) {}
-  Module(Module &&) = default;
-  bool operator==(const Module &o) const {
-    return name == o.name && type == o.type && mem == o.mem && targets == o.targets && inputs == o.inputs;
-  }
-
+  bool operator==(const Module &o) const = default;
 };
 struct Pulse {
-  absl::string_view from;
+  ModuleId from;
   bool val;
-  absl::string_view to;
+  ModuleId to;
 };
-using Modules = absl::flat_hash_map<absl::string_view, Module>;
+// Indexed by ModuleId.
+using Modules = std::vector<Module>;
 using Pulses = std::deque<Pulse>;
 
-}  // namespace
+}  // namespace aoc_2023_20
 
 namespace fmt {
 
 template<>
-struct formatter<ModuleType> : formatter<char> {
-  auto format(ModuleType type, format_context &ctx) const {
+struct formatter<aoc_2023_20::ModuleType> : formatter<char> {
+  auto format(aoc_2023_20::ModuleType type, format_context &ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(type), ctx);
   }
 };
 template<>
-struct formatter<Module> : formatter<string_view> {
-  auto format(const Module &mod, format_context &ctx) const {
+struct formatter<aoc_2023_20::Module> : formatter<string_view> {
+  auto format(const aoc_2023_20::Module &mod, format_context &ctx) const {
     absl::string_view state;
     switch (mod.type) {
-      case ModuleType::FF:
+      case aoc_2023_20::ModuleType::FF:
         return formatter<string_view>::format(fmt::format("{}{} [{}] ", mod.type, mod.name, mod.mem),
                                               ctx);
-      case ModuleType::CNJ:
-        return formatter<string_view>::format(fmt::format("{}{} {} ",
+      case aoc_2023_20::ModuleType::CNJ:
+        return formatter<string_view>::format(fmt::format("{}{} {} {} ",
                                                           mod.type,
                                                           mod.name,
-                                                          mod.inputs), ctx);
+                                                          mod.inputs,
+                                                          mod.input_high), ctx);
       default:return formatter<string_view>::format(fmt::format("{}{} ", mod.type, mod.name), ctx);
     }
   }
 };
 template<>
-struct formatter<Pulse> : formatter<string_view> {
-  auto format(const Pulse &pulse, format_context &ctx) const {
+struct formatter<aoc_2023_20::Pulse> : formatter<string_view> {
+  auto format(const aoc_2023_20::Pulse &pulse, format_context &ctx) const {
     return formatter<string_view>::format(fmt::format("{} -{}-> {}", pulse.from, pulse.val ? "high" : "low", pulse.to),
                                           ctx);
   }
@@ -72,30 +75,33 @@ struct formatter<Pulse> : formatter<string_view> {
 
 }  // namespace fmt
 
-namespace {
+namespace aoc_2023_20 {
 
-void TransmitPulses(const Module &mod, Pulses &pulses, bool pulse) {
+void TransmitPulses(ModuleId id, const Module &mod, Pulses &pulses, bool pulse) {
   for (auto target : mod.targets) {
-    Pulse p{mod.name, pulse, target};
+    Pulse p{id, pulse, target};
     pulses.push_back(p);
   }
 }
 
-void AcceptPulse(Modules &mods, Pulses &pulses, bool pulse, absl::string_view from, absl::string_view target) {
+void AcceptPulse(Modules &mods, Pulses &pulses, bool pulse, ModuleId from, ModuleId target) {
   auto &mod = mods[target];
-  bool all_high;
+  u64 input;
   switch (mod.type) {
     case ModuleType::FF:
       if (!pulse) {
         mod.mem = !mod.mem;
-        TransmitPulses(mod, pulses, mod.mem);
+        TransmitPulses(target, mod, pulses, mod.mem);
       }
       break;
-    case ModuleType::CNJ:CHECK(mod.inputs.contains(from))
-              << "Unexpected input for " << mod.name << " from " << from << ".";
-      mod.inputs[from] = pulse;
-      all_high = absl::c_all_of(mod.inputs, [](const auto &kv) { return kv.second; });
-      TransmitPulses(mod, pulses, !all_high);
+    case ModuleType::CNJ:input = absl::c_find(mod.inputs, from) - mod.inputs.begin();
+      CHECK(input < mod.inputs.size())
+              << "Unexpected input for " << mod.name << " from " << mods[from].name << ".";
+      if (mod.input_high[input] != pulse) {
+        mod.input_high[input] = pulse;
+        if (pulse) mod.num_high++; else mod.num_high--;
+      }
+      TransmitPulses(target, mod, pulses, mod.num_high != mod.inputs.size());
       break;
     case ModuleType::UNTYPED:mod.mem = pulse;
       break;
@@ -103,35 +109,40 @@ void AcceptPulse(Modules &mods, Pulses &pulses, bool pulse, absl::string_view fr
   }
 }
 
-std::tuple<u64, u64> PressButton(Modules &mods, absl::flat_hash_map<absl::string_view, bool> &monitor) {
+// Marks in `sent_low` every module that sent a low pulse.
+std::tuple<u64, u64> PressButton(Modules &mods, ModuleId broadcaster, std::vector<bool> &sent_low) {
   u64 lows{1};
   u64 highs{0};
   std::deque<Pulse> pulses;
-  for (auto target : mods.at(kBroadcaster).targets) {
-    pulses.emplace_back(kBroadcaster, false, target);
+  for (auto target : mods[broadcaster].targets) {
+    pulses.emplace_back(broadcaster, false, target);
   }
   while (!pulses.empty()) {
     auto pulse = pulses.front();
     pulses.pop_front();
     if (pulse.val) highs++; else lows++;
-    if (monitor.contains(pulse.from) && !pulse.val) {
-      monitor[pulse.from] = true;
-    }
+    if (!pulse.val) sent_low[pulse.from] = true;
     AcceptPulse(mods, pulses, pulse.val, pulse.from, pulse.to);
   }
   return {lows, highs};
 }
 
-}  // namespace
+}  // namespace aoc_2023_20
+
+template<>
+struct advent<2023, 20>::Parsed {
+  aoc::Interner names;
+  aoc_2023_20::Modules modules;
+};
 
 template<>
-auto advent<2023, 20>::solve() -> Result {
-  std::string input = GetInput(false, 2);
+auto advent<2023, 20>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_20;
+  aoc::Interner names;
   Modules modules;
   for (auto line : absl::StrSplit(input, "\n", absl::SkipWhitespace())) {
     Module mod;
     auto index = line.find(" -> ");
-    mod.targets = absl::StrSplit(line.substr(index + 4), ", ");
     if (line.starts_with(kBroadcaster)) {
       mod.type = ModuleType::BROADCAST;
       mod.name = kBroadcaster;
@@ -145,38 +156,43 @@ auto advent<2023, 20>::solve() -> Result {
       }
       mod.name = line.substr(1, index - 1);
     }
-    modules.emplace(mod.name, mod);
+    const ModuleId id = names.Intern(mod.name);
+    for (absl::string_view target : absl::StrSplit(line.substr(index + 4), ", ")) {
+      mod.targets.push_back(names.Intern(target));
+    }
+    if (modules.size() < names.Size()) modules.resize(names.Size());
+    modules[id] = std::move(mod);
   }
+  // Modules that only receive pulses are untyped.
+  modules.resize(names.Size());
+  for (ModuleId id = 0; id < names.Size(); id++) modules[id].name = names.Name(id);
 
   // Initialize inputs for conjunctions.
-  absl::flat_hash_map<absl::string_view, absl::flat_hash_set<absl::string_view>> inputs;
-  absl::flat_hash_set<absl::string_view> untyped;
-  inputs[kBroadcaster] = {};
-  for (const auto &mod : modules) {
-    for (auto target : mod.second.targets) {
-      if (!modules.contains(target)) {
-        untyped.insert(target);
-      }
-      inputs[target].insert(mod.second.name);
-    }
-  }
-  for (auto name : untyped) {
-    Module mod{name, ModuleType::UNTYPED};
-    modules.emplace(name, mod);
-  }
-  for (auto [to, froms] : inputs) {
-    if (modules.at(to).type != ModuleType::CNJ) continue;
-    for (auto from : froms) {
-      modules[to].inputs.emplace(from, false);
+  for (ModuleId from = 0; from < modules.size(); from++) {
+    for (auto target : modules[from].targets) {
+      auto &mod = modules[target];
+      if (mod.type != ModuleType::CNJ || absl::c_linear_search(mod.inputs, from)) continue;
+      mod.inputs.push_back(from);
+      mod.input_high.push_back(false);
     }
   }
+  return std::make_shared<Parsed>(std::move(names), std::move(modules));
+}
+
+template<>
+auto advent<2023, 20>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_20;
+  const ModuleId broadcaster = parsed.names.Find(kBroadcaster);
+  CHECK(broadcaster != aoc::Interner::kNotFound) << "No broadcaster.";
+  // Copied: pressing the button updates the module states.
+  Modules modules = parsed.modules;
+  std::vector<bool> sent_low(modules.size(), false);
 
   // Part 1
   u64 lows{0};
   u64 highs{0};
-  absl::flat_hash_map<absl::string_view, bool> monitor{};
   for (int i = 0; i < 1000; i++) {
-    auto [l, h] = PressButton(modules, monitor);
+    auto [l, h] = PressButton(modules, broadcaster, sent_low);
     lows += l;
     highs += h;
   }
@@ -184,26 +200,31 @@ auto advent<2023, 20>::solve() -> Result {
 
   // Part 2
   u64 part2{1};
-  monitor.emplace("nl", false);
-  monitor.emplace("cr", false);
-  monitor.emplace("jx", false);
-  monitor.emplace("vj", false);
-  absl::flat_hash_map<absl::string_view, u64> required{};
+  std::vector<ModuleId> monitor;
+  for (absl::string_view name : {"nl", "cr", "jx", "vj"}) {
+    monitor.push_back(parsed.names.Find(name));
+    CHECK(monitor.back() != aoc::Interner::kNotFound) << "No module " << name << ".";
+  }
+  absl::flat_hash_map<ModuleId, u64> required{};
   u64 press{1000};
-  while (absl::c_any_of(monitor, [](const auto &kv) { return !kv.second; })) {
+  while (!monitor.empty()) {
     press++;
-    PressButton(modules, monitor);
-    for (auto [mod, triggered] : monitor) {
-      if (triggered) {
+    absl::c_fill(sent_low, false);
+    PressButton(modules, broadcaster, sent_low);
+    for (auto mod : monitor) {
+      if (sent_low[mod]) {
         required.emplace(mod, press);
       }
     }
-    for (auto [mod, _] : required) monitor.erase(mod);
-    if (required.size() == 4) break;
+    std::erase_if(monitor, [&sent_low](ModuleId mod) { return sent_low[mod]; });
   }
   absl::flat_hash_set<u64> cycles{};
   for (auto [k, v] : required) cycles.insert(v);
   part2 = aoc::util::LCM(cycles);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 20>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 20>::PartTwo() -> std::string { return ""; }
@@ -1,10 +1,10 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
-namespace {
+namespace aoc_2023_21 {
 
 using Map = Eigen::MatrixXi;
 //Eigen::IOFormat MapFormat(Eigen::StreamPrecision, 0, "", "\n");
@@ -14,13 +14,15 @@ u64 Walk(const Map &map, const aoc::Pos &start, u64 budget) {
   u32 height = map.rows();
   u32 width = map.cols();
   u64 reached{0};
-  absl::flat_hash_set<aoc::Pos> visited{};
-  visited.insert(start);
-  std::deque<std::tuple<aoc::Pos, u64>> q;
+  // Indexed by i * width + j.
+  aoc::GridBitset<> visited(height * width);
+  visited.Insert(start.i * width + start.j);
+  std::deque<std::tuple<aoc::PackedPos, u64>> q;
   q.emplace_back(start, 0);
   while (!q.empty()) {
-    auto [pos, steps] = q.front();
+    auto [packed_pos, steps] = q.front();
     q.pop_front();
+    auto pos = packed_pos.ToPos();
     if (steps % 2 == budget % 2) {
       reached++;
     }
@@ -32,26 +34,28 @@ u64 Walk(const Map &map, const aoc::Pos &start, u64 budget) {
         continue;
       }
       if (map(new_pos.i, new_pos.j) == 1) continue;
-      if (visited.contains(new_pos)) continue;
-      visited.insert(new_pos);
+      if (!visited.Insert(new_pos.i * width + new_pos.j)) continue;
       q.emplace_back(new_pos, steps);
     }
   }
   return reached;
 }
 
-}  // namespace
+}  // namespace aoc_2023_21
 
 namespace fmt {
 
-template<>
-struct formatter<Eigen::WithFormat<Map>> : ostream_formatter {};
-
 }  // namespace fmt
 
 template<>
-auto advent<2023, 21>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 21>::Parsed {
+  aoc_2023_21::Map map;
+  aoc::Pos start;
+};
+
+template<>
+auto advent<2023, 21>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_21;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   u32 height = lines.size();
   u32 width = lines.at(0).size();
@@ -70,6 +74,13 @@ auto advent<2023, 21>::solve() -> Result {
       }
     }
   }
+  return std::make_shared<Parsed>(std::move(map), start);
+}
+
+template<>
+auto advent<2023, 21>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_21;
+  const auto& [map, start] = parsed;
 
   // Part 1
   auto part1 = Walk(map, start, 64);
@@ -168,4 +179,8 @@ auto advent<2023, 21>::solve() -> Result {
   part2 += PointyNorth + PointyEast + PointySouth + PointyWest;
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 21>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 21>::PartTwo() -> std::string { return ""; }
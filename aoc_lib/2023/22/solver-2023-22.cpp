@@ -1,11 +1,11 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <absl/container/btree_set.h>
 #include <Eigen/Core>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
-namespace {
+namespace aoc_2023_22 {
 
 struct Brick {
   aoc::Pos xy1;
@@ -38,24 +38,22 @@ struct RestingIdsFinder {
   }
 };
 
-}  // namespace
+}  // namespace aoc_2023_22
 
 namespace fmt {
 
 template<>
-struct formatter<Brick> : formatter<string_view> {
-  auto format(const Brick &b, format_context &ctx) const {
+struct formatter<aoc_2023_22::Brick> : formatter<string_view> {
+  auto format(const aoc_2023_22::Brick &b, format_context &ctx) const {
     return formatter<string_view>::format(
         fmt::format("{},{},{}~{},{},{}", b.xy1.i, b.xy1.j, b.bottom, b.xy2.i, b.xy2.j, b.top),
         ctx);
   }
 };
-template<>
-struct formatter<Eigen::WithFormat<HeightMap>> : ostream_formatter {};
 
 }  // namespace fmt
 
-namespace {
+namespace aoc_2023_22 {
 
 std::tuple<i32, i32> GetMapDimensions(const Bricks &bricks) {
   i64 min_i{1'000'000};
@@ -128,21 +126,32 @@ IdSet FindTransitiveSupporting(i32 id,
   return falling;
 }
 
-}  // namespace
+}  // namespace aoc_2023_22
 
 
 template<>
-auto advent<2023, 22>::solve() -> Result {
-  std::string input = GetInput();
+struct advent<2023, 22>::Parsed {
+  aoc_2023_22::Bricks bricks;
+};
+
+template<>
+auto advent<2023, 22>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_22;
   Bricks bricks = aoc::util::TokenizeInput<Brick>(input, [](auto line) {
     Brick b;
-    auto sep = line.find('~');
-    CHECK(sep != absl::string_view::npos) << "No '~' found in '" << line << "'.";
-    CHECK(scn::scan(line.substr(0, sep), "{},{},{}", b.xy1.i, b.xy1.j, b.bottom));
-    CHECK(scn::scan(line.substr(sep + 1), "{},{},{}", b.xy2.i, b.xy2.j, b.top));
+    auto ret = scn::scan<i64, i64, i32, i64, i64, i32>(line, "{},{},{}~{},{},{}");
+    CHECK(ret) << "Couldn't parse '" << line << "'.";
+    std::tie(b.xy1.i, b.xy1.j, b.bottom, b.xy2.i, b.xy2.j, b.top) = ret->values();
     return b;
   });
+  return std::make_shared<Parsed>(std::move(bricks));
+}
 
+template<>
+auto advent<2023, 22>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_22;
+  // Copied: the bricks settle in place.
+  Bricks bricks = parsed.bricks;
   auto [height, width] = GetMapDimensions(bricks);
   HeightMap map;
   map.resize(height, width);
@@ -173,5 +182,9 @@ auto advent<2023, 22>::solve() -> Result {
     part2 += FindTransitiveSupporting(id, supporters, supported_by).size();
   }
 
-    return aoc::result(part1, part2);
-}
\ No newline at end of file
+  return aoc::result(part1, part2);
+}
+
+template<> auto advent<2023, 22>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 22>::PartTwo() -> std::string { return ""; }
@@ -1,11 +1,11 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/btree_set.h>
 #include <absl/container/flat_hash_set.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2023_23 {
 
 enum class Tile : char {
   NORMAL = '.',
@@ -60,20 +60,20 @@ Tile FromUnderlying(char c) {
   }
 }
 
-}  // namespace
+}  // namespace aoc_2023_23
 
 namespace fmt {
 
 template<>
-struct formatter<Tile> : formatter<char> {
-  auto format(Tile tile, format_context &ctx) const {
+struct formatter<aoc_2023_23::Tile> : formatter<char> {
+  auto format(aoc_2023_23::Tile tile, format_context &ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(tile), ctx);
   }
 };
 
 }  // namespace fmt
 
-namespace {
+namespace aoc_2023_23 {
 
 //void PrintMap(const Map &map) {
 //  for (const auto &row : map) {
@@ -110,10 +110,13 @@ std::tuple<bool, aoc::Pos> TryMove(const Map &map, const aoc::Pos &from, aoc::Di
   CHECK(false) << fmt::format("Travelling {} parallel to a slop at [{}], slope: {}", dir, new_pos, new_tile);
 }
 
+// Longest path by label correcting on negated lengths: Dijkstra's monotone queue doesn't apply.
 u64 BellManFord(const Map &map, const aoc::Pos &start, const aoc::Pos &goal) {
   std::priority_queue<CostAndPos, std::vector<CostAndPos>, std::greater<>> pq;
-  absl::btree_map<aoc::Pos, i64> distance;
-  absl::btree_map<aoc::Pos, aoc::Pos> predecessor;
+  // Distances are never positive, so 1 marks tiles not reached yet.
+  constexpr i64 kUnreached = 1;
+  aoc::Grid<i64> distance(map.size(), map.at(0).size(), kUnreached);
+  aoc::Grid<aoc::Pos> predecessor(map.size(), map.at(0).size(), aoc::Pos{-1, -1});
   distance[start] = 0;
   pq.emplace(0, start);
   while (!pq.empty()) {
@@ -123,14 +126,14 @@ u64 BellManFord(const Map &map, const aoc::Pos &start, const aoc::Pos &goal) {
     for (auto d : aoc::kAllDirs) {
       auto [possible, new_pos] = TryMove(map, pos, d);
       if (!possible) continue;
-      if (predecessor.contains(pos) && new_pos == predecessor.at(pos)) continue;
-      if (distance.contains(new_pos) && distance.at(new_pos) <= distance.at(pos) - 1) continue;
+      if (new_pos == predecessor[pos]) continue;
+      if (distance[new_pos] != kUnreached && distance[new_pos] <= distance[pos] - 1) continue;
       distance[new_pos] = dist - 1;
       predecessor[new_pos] = pos;
-      pq.emplace(distance.at(new_pos), new_pos);
+      pq.emplace(distance[new_pos], new_pos);
     }
   }
-  return -distance.at(goal);
+  return -distance[goal];
 }
 
 std::tuple<bool, std::vector<aoc::Dir>> isNode(const Map &map, const aoc::Pos &pos) {
@@ -205,39 +208,45 @@ Graph BuildUDAG(const Map &map, const aoc::Pos &start, const aoc::Pos &goal) {
   return graph;
 }
 
-u64 LongestPath(const Graph &graph, const NodeId &start, const NodeId &goal) {
-  using State = std::tuple<std::vector<NodeId>, u64>;
-  std::deque<State> stack;
-  stack.push_back({{start}, 0});
-  u64 longest{0};
-
-  while (!stack.empty()) {
-    auto [path, length] = stack.back();
-    stack.pop_back();
-    const NodeId& cur = path.back();
-    if (cur == goal) {
-      if (length > longest) longest = length;
+// Extends `path` to `goal` every way it can without revisiting a node, keeping the longest length.
+// The path is extended and shrunk in place, so the search allocates nothing past its longest path.
+void ExtendPath(const Graph &graph, const NodeId &goal, std::pmr::vector<NodeId> &path, u64 length,
+                u64 &longest) {
+  const NodeId cur = path.back();
+  if (cur == goal) {
+    if (length > longest) longest = length;
+    return;
+  }
+  for (const auto &edge : graph.at(cur)) {
+    const NodeId& other = edge.Other(cur);
+    if (std::find(path.begin(), path.end(), other) != path.end()) {
       continue;
     }
-    for (const auto &edge : graph.at(cur)) {
-      const NodeId& other = edge.Other(cur);
-      if (std::find(path.begin(), path.end(), other) != path.end()) {
-        continue;
-      }
-      std::vector<NodeId> new_path{path.begin(), path.end()};
-      new_path.push_back(other);
-      State new_state{new_path, length + edge.len};
-      stack.push_back(new_state);
-    }
+    path.push_back(other);
+    ExtendPath(graph, goal, path, length + edge.len, longest);
+    path.pop_back();
   }
-  return longest;
 }
 
+u64 LongestPath(const Graph &graph, const NodeId &start, const NodeId &goal,
+                std::pmr::memory_resource *arena) {
+  std::pmr::vector<NodeId> path({start}, arena);
+  path.reserve(graph.size());
+  u64 longest{0};
+  ExtendPath(graph, goal, path, 0, longest);
+  return longest;
 }
 
+}  // namespace aoc_2023_23
+
 template<>
-auto advent<2023, 23>::solve() -> Result {
-  std::string input = GetInput(false);
+struct advent<2023, 23>::Parsed {
+  aoc_2023_23::Map map;
+};
+
+template<>
+auto advent<2023, 23>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_23;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   u32 height = lines.size();
   u32 width = lines.at(0).size();
@@ -248,6 +257,14 @@ auto advent<2023, 23>::solve() -> Result {
       map.back().push_back(FromUnderlying(lines.at(i).at(j)));
     }
   }
+  return std::make_shared<Parsed>(std::move(map));
+}
+
+template<>
+auto advent<2023, 23>::Solve(const Parsed& parsed) -> Result {
+  const auto& [map] = parsed;
+  const i64 height = map.size();
+  const i64 width = map.at(0).size();
 
   // Part 1
   aoc::Pos start{0, 1};
@@ -256,7 +273,11 @@ auto advent<2023, 23>::solve() -> Result {
 
   // Part 2
   auto graph = BuildUDAG(map, start, goal);
-  u64 part2 = LongestPath(graph, start, goal);
+  u64 part2 = LongestPath(graph, start, goal, &arena);
 
   return aoc::result(part1, part2);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 23>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 23>::PartTwo() -> std::string { return ""; }
@@ -1,4 +1,4 @@
-#include <aoc.hpp>
+#include <aoc.h>
 
 #include <absl/container/btree_map.h>
 #include <Eigen/Geometry>
@@ -7,9 +7,8 @@
 #include <fmt/ostream.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2023_24 {
 
-double zero = 1e-2;
 using Vec3 = Eigen::Matrix<i64, 3, 1>;
 Eigen::IOFormat Vec3Fmt(0, 0, ", ", ", ");
 struct Hail {
@@ -20,84 +19,88 @@ struct Hail {
     vel.setZero();
   }
 };
-inline long double i64_ld(i64 x) {
-  return static_cast<long double>(x);
-}
 
-}  // namespace
+// Bounds of the test area of part 1.
+constexpr i64 kMinArea = 200'000'000'000'000;
+constexpr i64 kMaxArea = 400'000'000'000'000;
+
+}  // namespace aoc_2023_24
 
 namespace fmt {
 
 template<>
-struct formatter<Eigen::WithFormat<Vec3>> : ostream_formatter {};
-template<>
-struct formatter<Eigen::WithFormat<Eigen::Vector3f>> : ostream_formatter {};
-template<>
-struct formatter<Hail> : formatter<string_view> {
-  auto format(const Hail &hs, format_context &ctx) const {
+struct formatter<aoc_2023_24::Hail> : formatter<string_view> {
+  auto format(const aoc_2023_24::Hail &hs, format_context &ctx) const {
     return formatter<string_view>::format(
-        fmt::format("{} @ {}", hs.pos.format(Vec3Fmt), hs.vel.format(Vec3Fmt)), ctx);
+        fmt::format("{} @ {}", hs.pos.format(aoc_2023_24::Vec3Fmt),
+                    hs.vel.format(aoc_2023_24::Vec3Fmt)),
+        ctx);
   }
 };
 
 }  // namespace fmt
 
-namespace {
-
-std::tuple<bool, long double, long double> Collide(const Hail &h1,
-                                                   const Hail &h2) {
-  long double px1 = i64_ld(h1.pos(0));
-  long double py1 = i64_ld(h1.pos(1));
-  long double px2 = i64_ld(h2.pos(0));
-  long double py2 = i64_ld(h2.pos(1));
-  long double ux1 = i64_ld(h1.vel(0));
-  long double uy1 = i64_ld(h1.vel(1));
-  long double ux2 = i64_ld(h2.vel(0));
-  long double uy2 = i64_ld(h2.vel(1));
-  long double denom = uy1 * ux2 - uy2 * ux1;
-  if (abs(denom) < zero) {
-    return {false, 0, 0};
+namespace aoc_2023_24 {
+
+// Whether the paths of `h1` and `h2` cross inside [min, max]^2, ignoring z, at times both
+// hailstones get there. They cross at P1 + t1 / d V1, where d = V1 x V2, t1 = dP x V2 and
+// t2 = dP x V1, so the crossing is in the area when d (min - P1) <= t1 V1 <= d (max - P1), which
+// needs no division and is exact. Every product is of two i64s except t1 V1, the only one checked:
+// it stays under 2^100 for positions of 10^18 (1000 times the input's) and velocities of 10^3.
+bool CrossInArea(const Hail &h1, const Hail &h2, const i64 min, const i64 max) {
+  const i64 dx = h2.pos(0) - h1.pos(0), dy = h2.pos(1) - h1.pos(1);
+  i128 denom = i128{h1.vel(0)} * h2.vel(1) - i128{h1.vel(1)} * h2.vel(0);
+  // Parallel paths never cross, or cross everywhere.
+  if (denom == 0) return false;
+  i128 t1 = i128{dx} * h2.vel(1) - i128{dy} * h2.vel(0);
+  i128 t2 = i128{dx} * h1.vel(1) - i128{dy} * h1.vel(0);
+  if (denom < 0) {
+    denom = -denom;
+    t1 = -t1;
+    t2 = -t2;
   }
-  long double c = py1 - uy1 * px1 / ux1;
-  long double d = py2 - uy2 * px2 / ux2;
-  long double px = (d - c) * ux1 * ux2 / denom;
-  long double py = px * (uy1 / ux1) + c;
-  long double t1 = (px - i64_ld(h1.pos(0))) / i64_ld(h1.vel(0));
-  long double t2 = (px - i64_ld(h2.pos(0))) / i64_ld(h2.vel(0));
-  if (t1 < 0 || t2 < 0) {
-    return {false, 0, 0};
+  if (t1 < 0 || t2 < 0) return false;
+  for (i8 dim = 0; dim < 2; dim++) {
+    const std::optional<i128> offset = aoc::util::CheckedMul<i128>(t1, h1.vel(dim));
+    CHECK(offset.has_value()) << "Overflow in i128.";
+    if (*offset < denom * (min - h1.pos(dim)) || *offset > denom * (max - h1.pos(dim))) {
+      return false;
+    }
   }
-  return {true, px, py};
+  return true;
 }
 
-}  // namespace
+}  // namespace aoc_2023_24
+
+template<>
+struct advent<2023, 24>::Parsed {
+  std::vector<aoc_2023_24::Hail> hails;
+};
 
 template<>
-auto advent<2023, 24>::solve() -> Result {
-  std::string input = GetInput(false);
+auto advent<2023, 24>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_24;
   std::vector<Hail> hails = aoc::util::TokenizeInput<Hail>(input, [](auto line) {
     Hail hs;
-    CHECK(scn::scan(line, "{}, {}, {} @ {}, {}, {}", hs.pos(0), hs.pos(1), hs.pos(2), hs.vel(0), hs.vel(1), hs.vel(2)))
-            << fmt::format("Couldn't parse '{}'", line);
-    CHECK(hs.pos(0) * hs.pos(1) * hs.pos(2) != 0) << fmt::format("Found zero speed {}", line);
+    auto ret = scn::scan<i64, i64, i64, i64, i64, i64>(line, "{}, {}, {} @ {}, {}, {}");
+    CHECK(ret) << fmt::format("Couldn't parse '{}'", line);
+    std::tie(hs.pos(0), hs.pos(1), hs.pos(2), hs.vel(0), hs.vel(1), hs.vel(2)) = ret->values();
+    CHECK(!hs.vel.isZero()) << fmt::format("Found zero speed {}", line);
     return hs;
   });
+  return std::make_shared<Parsed>(std::move(hails));
+}
+
+template<>
+auto advent<2023, 24>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_24;
+  const auto& [hails] = parsed;
 
   // Part 1
   u64 part1 = 0;
-  long double min = 200'000'000'000'000.0;
-  long double max = 400'000'000'000'000.0;
   for (int i = 0; i < hails.size() - 1; i++) {
     for (int j = i + 1; j < hails.size(); j++) {
-      const auto &h1 = hails.at(i);
-      const auto &h2 = hails.at(j);
-      auto [collide, px, py] = Collide(h1, h2);
-      if (!collide) {
-        continue;
-      }
-      if (px >= min && px <= max && py >= min && py <= max) {
-        part1++;
-      }
+      if (CrossInArea(hails.at(i), hails.at(j), kMinArea, kMaxArea)) part1++;
     }
   }
 
@@ -139,9 +142,17 @@ auto advent<2023, 24>::solve() -> Result {
   i64 u2y = stone.vel(1) - hails[1].vel(1);
   i64 denom = (u1x * u2y - u1y * u2x);
   CHECK(denom != 0) << "No solution exists at integer nanoseconds time.";
-  i64 t = (u2x * (hails[1].pos(1) - hails[0].pos(1)) - (hails[1].pos(0) - hails[0].pos(0)) * u2y) / denom;
-  stone.pos = hails[0].pos + (hails[0].vel - stone.vel) * t;
-  u64 part2 = stone.pos.sum();
+  // Distances times speeds overflow an i64 once the positions are scaled up 1000 times.
+  const i128 t = (i128{u2x} * (hails[1].pos(1) - hails[0].pos(1)) -
+                  i128{hails[1].pos(0) - hails[0].pos(0)} * u2y) / denom;
+  i128 part2 = 0;
+  for (i8 dim = 0; dim < 3; dim++) {
+    part2 += hails[0].pos(dim) + (hails[0].vel(dim) - stone.vel(dim)) * t;
+  }
 
   return aoc::result(part1, part2);
 }
+
+template<> auto advent<2023, 24>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 24>::PartTwo() -> std::string { return ""; }
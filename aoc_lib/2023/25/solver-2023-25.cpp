@@ -1,17 +1,21 @@
-#include <aoc.hpp>
+#include <aoc_core.h>
+#include <aoc_graph.h>
 
 #include <absl/container/btree_set.h>
 #include <absl/container/btree_map.h>
 #include <absl/hash/hash.h>
 #include <fmt/format.h>
 
-namespace {
+#include <random>
 
-using Id = absl::string_view;
-using Ids = std::vector<Id>;
+namespace aoc_2023_25 {
+
+using Id = u32;
+constexpr Id kNone = aoc::Interner::kNotFound;
 struct Link {
-  Id a{};
-  Id b{};
+  Id a{kNone};
+  Id b{kNone};
+  Link() = default;
   Link(Id _a, Id _b) {
     if (_a < _b) {
       a = _a;
@@ -29,123 +33,110 @@ struct Link {
   }
   bool operator<(const Link &o) const { return a < o.a || (a == o.a && b < o.b); }
   bool operator==(const Link &o) const { return a == o.a && b == o.b; }
+  template<typename H>
+  friend H AbslHashValue(H h, const Link &link) {
+    return H::combine(std::move(h), link.a, link.b);
+  }
 };
 using LinkSet = absl::btree_set<Link>;
-using Flows = absl::btree_map<Link, u64>;
-using Graph = absl::btree_map<Id, LinkSet>;
+using Flows = absl::flat_hash_map<Link, u64>;
 
-}  // namespace
+}  // namespace aoc_2023_25
 
 namespace fmt {
 
 template<>
-struct formatter<Link> : formatter<string_view> {
-  auto format(const Link &link, format_context &ctx) const {
+struct formatter<aoc_2023_25::Link> : formatter<string_view> {
+  auto format(const aoc_2023_25::Link &link, format_context &ctx) const {
     return formatter<string_view>::format(fmt::format("[{} {}]", link.a, link.b), ctx);
   }
 };
 
 }  // namespace fmt
 
-namespace {
+namespace aoc_2023_25 {
 
-std::tuple<u64, Flows> EdmondsKarpMaxFlow(const Graph &graph, Id source, Id sink) {
+std::tuple<u64, Flows> EdmondsKarpMaxFlow(const aoc::CsrGraph &graph, Id source, Id sink) {
   u64 flow = 0;
   Flows flows;
-  absl::btree_map<Id, Link> pred;
+  // The link each node was reached by, or a default Link for nodes not reached yet.
+  std::vector<Link> pred(graph.NumNodes());
+  const auto reached = [&pred](Id node) { return pred[node].a != kNone; };
+  std::vector<Id> q;
   do {
-    std::deque<Id> q;
-    q.push_back(source);
-    pred.clear();
-    while (!q.empty()) {
-      auto cur = q.front();
-      q.pop_front();
-      for (const auto &link : graph.at(cur)) {
-        auto t = link.Other(cur);
-        if (pred.contains(t) || t == source) continue;
-        if (!flows.contains(link)) {
-          flows[link] = 0;
-        }
-        if (flows.at(link) < 1) {
-          pred.emplace(t, link);
+    q.assign(1, source);
+    absl::c_fill(pred, Link{});
+    for (u64 head = 0; head < q.size(); head++) {
+      auto cur = q[head];
+      for (const Id t : graph.Neighbors(cur)) {
+        const Link link{cur, t};
+        if (reached(t) || t == source) continue;
+        if (flows[link] < 1) {
+          pred[t] = link;
           q.push_back(t);
         }
       }
     }
-    if (pred.contains(sink)) {
+    if (reached(sink)) {
       u64 df = 1'000'000.0;
       auto n = sink;
-      while (pred.contains(n)) {
-        auto e = pred.at(n);
+      while (reached(n)) {
+        auto e = pred[n];
         df = std::min(df, 1 - flows.at(e));
         n = e.Other(n);
       }
       n = sink;
-      while (pred.contains(n)) {
-        auto e = pred.at(n);
+      while (reached(n)) {
+        auto e = pred[n];
         flows[e] += df;
         n = e.Other(n);
       }
       flow += df;
     }
-  } while (pred.contains(sink));
+  } while (reached(sink));
 
   return {flow, flows};
 }
 
-u64 CountGraphSpan(const Graph &graph, Id from, const LinkSet &cut) {
-  std::deque<Id> q;
-  q.push_back(from);
-  absl::btree_set<Id> visited;
-  while (!q.empty()) {
-    auto p = q.front();
-    q.pop_front();
-    visited.insert(p);
-    for (const auto &e : graph.at(p)) {
-      if (cut.contains(e)) continue;
-      auto t = e.Other(p);
-      if (visited.contains(t)) continue;
-      q.push_back(t);
-    }
-  }
-  return visited.size();
-}
+}  // namespace aoc_2023_25
 
-}  // namespace
+template<>
+struct advent<2023, 25>::Parsed {
+  aoc::Interner ids;
+  aoc::CsrGraph graph;
+};
 
 template<>
-auto advent<2023, 25>::solve() -> Result {
-  std::string input = GetInput(false);
-  Ids ids{};
-  absl::btree_set<Id> idSet{};
-  Graph graph{};
-  Flows flows{};
+auto advent<2023, 25>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2023_25;
+  aoc::Interner ids;
+  std::vector<std::pair<Id, Id>> edges;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   for (auto line : lines) {
-    Id a{line.substr(0, 3)};
-    ids.push_back(a);
-    std::vector<Id> bs = absl::StrSplit(line.substr(5), " ");
-    for (auto b : bs) {
-      idSet.insert(b);
-      Link link{a, b};
-      flows.emplace(link, 0);
-      graph[a].insert(link);
-      graph[b].insert(link);
-    }
+    Id a = ids.Intern(line.substr(0, 3));
+    std::vector<absl::string_view> bs = absl::StrSplit(line.substr(5), " ");
+    for (auto b : bs) edges.emplace_back(a, ids.Intern(b));
   }
-  for (const Id &id : idSet) ids.push_back(id);
+  aoc::CsrGraph graph = aoc::CsrGraph::Undirected(ids.Size(), edges);
+  return std::make_shared<Parsed>(std::move(ids), std::move(graph));
+}
+
+template<>
+auto advent<2023, 25>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2023_25;
+  const auto& [ids, graph] = parsed;
 
   // Part 1
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::uniform_int_distribution<> distrib(0, static_cast<int>(ids.size() - 1));
+  std::uniform_int_distribution<> distrib(0, static_cast<int>(ids.Size() - 1));
 
-  absl::btree_set<Link> min_cut;
+  LinkSet min_cut;
   absl::btree_map<Link, u32> freq{};
   for (i32 i = 0; i < 100; i++) {
-    auto ret = EdmondsKarpMaxFlow(graph, ids.at(distrib(gen)), ids.at(distrib(gen)));
+    auto ret = EdmondsKarpMaxFlow(graph, distrib(gen), distrib(gen));
     while (std::get<0>(ret) != 3) {
-      ret = EdmondsKarpMaxFlow(graph, ids.at(distrib(gen)), ids.at(distrib(gen)));
+      ret = EdmondsKarpMaxFlow(graph, distrib(gen), distrib(gen));
     }
     for (const auto &[e, f] : std::get<1>(ret)) {
       if (f > 0) freq[e]++;
@@ -165,7 +156,14 @@ auto advent<2023, 25>::solve() -> Result {
       break;
     }
   }
-  u64 part1 = CountGraphSpan(graph, min_cut.begin()->a, min_cut) * CountGraphSpan(graph, min_cut.begin()->b, min_cut);
+  const auto components = aoc::ConnectedComponents(
+      graph.Subgraph([&min_cut](Id a, Id b) { return !min_cut.contains(Link{a, b}); }));
+  CHECK(components.sizes.size() == 2) << "The cut left " << components.sizes.size() << " parts.";
+  u64 part1 = u64{components.sizes[0]} * components.sizes[1];
 
   return aoc::result(part1, 0);
-}
\ No newline at end of file
+}
+
+template<> auto advent<2023, 25>::PartOne() -> std::string { return ""; }
+
+template<> auto advent<2023, 25>::PartTwo() -> std::string { return ""; }
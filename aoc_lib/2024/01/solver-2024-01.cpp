@@ -1,11 +1,18 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
-namespace {}  // namespace
+namespace aoc_2024_01 {}  // namespace aoc_2024_01
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2024, 1>::solve() -> Result {
+struct advent<2024, 1>::Parsed {
+  std::vector<i32> list1, list2;
+  absl::flat_hash_map<i32, u64> appears;
+};
+
+template<>
+auto advent<2024, 1>::Parse() -> std::shared_ptr<const Parsed> {
+  auto parse_phase = Phase("parse");
   std::vector<i32> list1, list2;
   absl::flat_hash_map<i32, u64> appears;
   i32 i;
@@ -19,17 +26,29 @@ auto advent<2024, 1>::solve() -> Result {
     list2.push_back(i);
     appears[i]++;
   }
+  return std::make_shared<Parsed>(std::move(list1), std::move(list2), std::move(appears));
+}
+
+template<>
+auto advent<2024, 1>::Solve(const Parsed& parsed) -> Result {
+  // Only the lists are copied, part 1 sorts them in place.
+  std::vector<i32> list1 = parsed.list1, list2 = parsed.list2;
+  const auto& appears = parsed.appears;
 
   // Part 1
+  auto part1_phase = Phase("part1");
   absl::c_sort(list1);
   absl::c_sort(list2);
   auto dist = [](auto a, auto b) { return labs(a - b); };
   auto distances = std::views::zip_transform(dist, list1, list2);
   u64 part1 = std::reduce(distances.cbegin(), distances.cend());
+  part1_phase.Stop();
 
+  // Part 2
+  auto part2_phase = Phase("part2");
   u64 part2 = 0;
   for (auto n : list1) {
-    if (appears.contains(n)) part2 += static_cast<u64>(n) * appears[n];
+    if (auto it = appears.find(n); it != appears.end()) part2 += static_cast<u64>(n) * it->second;
   }
 
   return aoc::result(part1, part2);
@@ -1,6 +1,6 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
-namespace {
+namespace aoc_2024_02 {
 
 using Report = std::vector<i32>;
 using Reports = std::vector<Report>;
@@ -20,17 +20,29 @@ bool IsSafe(const Report& report, const u32 skip = std::numeric_limits<u32>::max
   return true;
 }
 
-}  // namespace
+}  // namespace aoc_2024_02
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2024, 02>::solve() -> Result {
-  i32 x;
+struct advent<2024, 2>::Parsed {
+  aoc_2024_02::Reports reports;
+};
+
+template<>
+auto advent<2024, 2>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_02;
   Reports reports;
   for (const auto line : input | std::views::split('\n')) {
     aoc::util::FasterScanList(line, reports.emplace_back());
   }
+  return std::make_shared<Parsed>(std::move(reports));
+}
+
+template<>
+auto advent<2024, 2>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_02;
+  const auto& [reports] = parsed;
 
   // Part 1
   u64 part1 = 0;
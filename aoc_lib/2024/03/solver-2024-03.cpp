@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2024_03 {
 
 RE2 InstructionPattern(R"(((?:mul\([\d,]+\)|do\(\)|don't\(\))))");
 
@@ -27,15 +27,27 @@ void ParseInstructions(absl::string_view input, i64& part1, i64& part2) {
   }
 }
 
-}  // namespace
+}  // namespace aoc_2024_03
 
 namespace fmt {}  // namespace fmt
 
+// Instructions are executed while they are scanned, so there is nothing to parse ahead.
 template<>
-auto advent<2024, 03>::solve() -> Result {
+struct advent<2024, 3>::Parsed {
+  std::string_view memory;
+};
+
+template<>
+auto advent<2024, 3>::Parse() -> std::shared_ptr<const Parsed> {
+  return std::make_shared<Parsed>(input);
+}
+
+template<>
+auto advent<2024, 3>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_03;
   // Part 1 & 2
   i64 part1 = 0, part2 = 0;
-  ParseInstructions(input, part1, part2);
+  ParseInstructions(parsed.memory, part1, part2);
 
   return aoc::result(part1, part2);
 }
@@ -1,6 +1,6 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
-namespace {
+namespace aoc_2024_04 {
 
 using Grid = std::vector<absl::string_view>;
 
@@ -12,14 +12,26 @@ bool FindWordMAS(const Grid& grid, const i64 mi, const i64 mj, const i64 si, con
   return grid[mi][mj] == 'M' && grid[si][sj] == 'S';
 }
 
-}  // namespace
+}  // namespace aoc_2024_04
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2024, 04>::solve() -> Result {
-  const Grid grid = absl::StrSplit(input, '\n');
+struct advent<2024, 4>::Parsed {
+  aoc_2024_04::Grid grid;
+};
 
+template<>
+auto advent<2024, 4>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_04;
+  Grid grid = absl::StrSplit(input, '\n');
+  return std::make_shared<Parsed>(std::move(grid));
+}
+
+template<>
+auto advent<2024, 4>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_04;
+  const auto& [grid] = parsed;
   const u64 height = grid.size();
   const u64 width = grid[0].size();
 
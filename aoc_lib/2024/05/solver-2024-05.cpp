@@ -1,6 +1,6 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
-namespace {
+namespace aoc_2024_05 {
 
 using Rules = absl::flat_hash_map<u32, absl::flat_hash_set<u32>>;
 using Pages = std::vector<u32>;
@@ -24,12 +24,19 @@ u32 FixPages(const Pages& pages, const Rules& rules) {
   return 0;
 }
 
-}  // namespace
+}  // namespace aoc_2024_05
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2024, 5>::solve() -> Result {
+struct advent<2024, 5>::Parsed {
+  aoc_2024_05::Rules rules;
+  aoc_2024_05::PageSets page_sets;
+};
+
+template<>
+auto advent<2024, 5>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_05;
   Rules rules;
   PageSets page_sets;
   bool rules_done = false;
@@ -48,6 +55,13 @@ auto advent<2024, 5>::solve() -> Result {
     aoc::util::FastScanList(line, pages, ",");
     page_sets.emplace_back(pages.begin(), pages.end());
   }
+  return std::make_shared<Parsed>(std::move(rules), std::move(page_sets));
+}
+
+template<>
+auto advent<2024, 5>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_05;
+  const auto& [rules, page_sets] = parsed;
 
   // Parts 1 & 2
   u64 part1 = 0;
@@ -58,7 +72,7 @@ auto advent<2024, 5>::solve() -> Result {
       u32 page = pages[i];
       for (u32 j = i + 1; j < pages.size(); j++) {
         u32 following = pages[j];
-        if (rules[following].contains(page)) {
+        if (auto it = rules.find(following); it != rules.end() && it->second.contains(page)) {
           correct = false;
           break;
         }
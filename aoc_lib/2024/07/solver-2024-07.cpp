@@ -1,6 +1,7 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_parallel.h>
 
-namespace {
+namespace aoc_2024_07 {
 
 using Operand = u64;
 using Operands = std::vector<Operand>;
@@ -23,12 +24,32 @@ bool IsValid(
   return false;
 }
 
-}  // namespace
+// Sums of the goals in equations [begin, end) that part 1 can reach, and of those only part 2 can.
+std::pair<Operand, Operand> SumValid(const Equations& equations, const i64 begin, const i64 end) {
+  std::pair<Operand, Operand> sums{0, 0};
+  for (i64 e = begin; e < end; e++) {
+    const auto& [goal, operands] = equations[e];
+    if (IsValid(goal, operands, operands.size() - 1, false)) {
+      sums.first += goal;
+    } else {
+      if (IsValid(goal, operands, operands.size() - 1, true)) sums.second += goal;
+    }
+  }
+  return sums;
+}
+
+}  // namespace aoc_2024_07
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2024, 7>::solve() -> Result {
+struct advent<2024, 7>::Parsed {
+  aoc_2024_07::Equations equations;
+};
+
+template<>
+auto advent<2024, 7>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_07;
   Equations equations;
   for (auto line : input | std::views::split('\n')) {
     Equation equation;
@@ -43,16 +64,28 @@ auto advent<2024, 7>::solve() -> Result {
         std::ranges::subrange((*parts_it).begin() + 1, (*parts_it).end()), equation.second);
     equations.emplace_back(equation.first, equation.second);
   }
+  return std::make_shared<Parsed>(std::move(equations));
+}
+
+template<>
+auto advent<2024, 7>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_07;
+  const auto& [equations] = parsed;
 
   // Part 1 & Part 2
-  Operand part1 = 0, part2 = 0;
-  for (const auto& [goal, operands] : equations) {
-    if (IsValid(goal, operands, operands.size() - 1, false)) {
-      part1 += goal;
-    } else {
-      if (IsValid(goal, operands, operands.size() - 1, true)) part2 += goal;
-    }
-  }
+  // With one thread the chunks and their partial sums only add overhead, so the loop runs as is.
+  using Sums = std::pair<Operand, Operand>;
+  aoc::parallel::ThreadPool& pool = aoc::parallel::DefaultPool();
+  const i64 num_equations = equations.size();
+  auto [part1, part2] =
+      pool.NumThreads() == 1
+          ? SumValid(equations, 0, num_equations)
+          : aoc::parallel::ParallelReduce(
+                pool, num_equations, 64, Sums{0, 0},
+                [&](i64 begin, i64 end) { return SumValid(equations, begin, end); },
+                [](const Sums& a, const Sums& b) {
+                  return Sums{a.first + b.first, a.second + b.second};
+                });
   part2 += part1;
 
   return aoc::result(part1, part2);
@@ -1,6 +1,6 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
-namespace {
+namespace aoc_2024_08 {
 
 using AntennaList = std::vector<i32>;
 using AntennaSet = absl::flat_hash_set<i32>;
@@ -16,11 +16,20 @@ bool TryAddAntinode(
   return true;
 }
 
-}  // namespace
+}  // namespace aoc_2024_08
 
 namespace fmt {}  // namespace fmt
 
-template<> auto advent<2024, 8>::solve() -> Result {
+template<>
+struct advent<2024, 8>::Parsed {
+  u32 height;
+  u32 width;
+  aoc_2024_08::Antennas antennas;
+};
+
+template<>
+auto advent<2024, 8>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_08;
   const u32 width = input.find_first_of('\n');
   const u32 height = (input.size() + 1) / width - 1;
   Antennas antennas;
@@ -31,6 +40,13 @@ template<> auto advent<2024, 8>::solve() -> Result {
     antennas[*it].push_back(static_cast<i32>(std::distance(input.begin(), it)));
     ++it;
   }
+  return std::make_shared<Parsed>(height, width, std::move(antennas));
+}
+
+template<>
+auto advent<2024, 8>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_08;
+  const auto& [height, width, antennas] = parsed;
 
   // Part 1 & Part 2
   AntennaSet antinodes1, antinodes2;
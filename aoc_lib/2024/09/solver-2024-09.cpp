@@ -1,6 +1,6 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
-namespace {
+namespace aoc_2024_09 {
 
 using Block = struct {
   u64 id;
@@ -37,14 +37,20 @@ u64 CalcCheckSum(const Blocks &blocks) {
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2024_09
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 9>::solve() -> Result {
+struct advent<2024, 9>::Parsed {
+  aoc_2024_09::Disk disk;
+};
+
+template<>
+auto advent<2024, 9>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_09;
   Disk disk;
   disk.reserve(input.size());
   bool is_file = true;
@@ -54,6 +60,13 @@ auto advent<2024, 9>::solve() -> Result {
     id += is_file;
     is_file = !is_file;
   }
+  return std::make_shared<Parsed>(std::move(disk));
+}
+
+template<>
+auto advent<2024, 9>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_09;
+  const auto& [disk] = parsed;
 
   // Part 1
   Disk disk1{disk};
@@ -1,23 +1,34 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_10 {
 
 using Altitude = u16;
 using Row = std::vector<Altitude>;
 using Map = std::vector<Row>;
-using Trailheads = std::vector<aoc::Pos>;
-using Path = std::pair<std::vector<aoc::Pos>, Altitude>;
+using Trailheads = std::vector<aoc::PackedPos>;
+// Paths live in the solve's arena: they're copied at every step.
+using Trail = std::pmr::vector<aoc::PackedPos>;
+using Path = std::pair<Trail, Altitude>;
 
-}  // namespace
+}  // namespace aoc_2024_10
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 10>::solve() -> Result {
+struct advent<2024, 10>::Parsed {
+  u64 height;
+  u64 width;
+  aoc_2024_10::Map map;
+  aoc_2024_10::Trailheads trailheads;
+};
+
+template<>
+auto advent<2024, 10>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_10;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   u64 height = lines.size();
   u64 width = lines.at(0).size();
@@ -29,43 +40,51 @@ auto advent<2024, 10>::solve() -> Result {
       char ch = lines.at(i).at(j);
       row.push_back(ch - '0');
       if (ch == '0') {
-        trailheads.emplace_back(i, j);
+        trailheads.push_back(aoc::PackedPos(aoc::Pos(i, j)));
       }
     }
     map.push_back(row);
   }
+  return std::make_shared<Parsed>(height, width, std::move(map), std::move(trailheads));
+}
+
+template<>
+auto advent<2024, 10>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_10;
+  const auto& [height, width, map, trailheads] = parsed;
 
   // Part 1 & Part 2
   u64 part1 = 0;
   u64 part2 = 0;
+  // Trail ends reached from the current trailhead, by linear index.
+  aoc::GridBitset<> ends(height * width);
   for (const auto& pos : trailheads) {
-    std::deque<Path> paths;
-    Path start{{pos}, 0};
-    paths.push_back(start);
-    absl::flat_hash_set<aoc::Pos> visited;
-    absl::flat_hash_set<aoc::Pos> ends;
-    absl::flat_hash_set<Path> unique_paths;
+    std::pmr::vector<Path> paths(&arena);
+    paths.emplace_back(Trail({pos}, &arena), 0);
+    ends.Clear();
+    aoc::pmr::flat_hash_set<Path> unique_paths(&arena);
     while (!paths.empty()) {
-      auto path = paths.back();
+      Path path = std::move(paths.back());
       paths.pop_back();
-      auto tail = path.first.back();
+      auto tail = path.first.back().ToPos();
       for (auto dir : aoc::kAllDirs) {
         auto new_pos = tail + aoc::MoveDir(dir);
         if (aoc::util::IsOutOfMap(height, width, new_pos)) continue;
         auto new_alt = map.at(new_pos.i).at(new_pos.j);
         if (new_alt != path.second + 1) continue;
 
-        Path new_path{path.first, new_alt};
-        new_path.first.push_back(new_pos);
+        // Copies keep the default resource unless given the arena explicitly.
+        Trail new_trail(path.first, &arena);
+        new_trail.emplace_back(new_pos);
         if (new_alt == 9) {
-          ends.insert(new_pos);
-          unique_paths.insert(new_path);
+          ends.Insert(new_pos.i * width + new_pos.j);
+          unique_paths.emplace(std::move(new_trail), new_alt);
           continue;
         }
-        paths.push_back(new_path);
+        paths.emplace_back(std::move(new_trail), new_alt);
       }
     }
-    part1 += ends.size();
+    part1 += ends.Count();
     part2 += unique_paths.size();
   }
 
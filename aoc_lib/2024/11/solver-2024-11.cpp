@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_11 {
 
 using Stone = u64;
 using SplitStones = std::pair<Stone, Stone>;
@@ -38,19 +38,32 @@ u64 Blink(Stone stone, u32 times, Cache &cache) {
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2024_11
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 11>::solve() -> Result {
+struct advent<2024, 11>::Parsed {
+  aoc_2024_11::Stones stones;
+};
+
+template<>
+auto advent<2024, 11>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_11;
   Stones stones = aoc::util::TokenizeInput<Stone>(input, [](auto token) {
     auto result = scn::scan<u64>(token, "{}");
     CHECK(result) << "Couldn't parse '" << token << "'.";
     return result->value();
   }, " ");
+  return std::make_shared<Parsed>(std::move(stones));
+}
+
+template<>
+auto advent<2024, 11>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_11;
+  const auto& [stones] = parsed;
 
   // Part 1
   u64 part1 = 0;
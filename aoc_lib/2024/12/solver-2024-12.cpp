@@ -1,98 +1,110 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_12 {
 using Tile = char;
-using Row = std::vector<Tile>;
-using Map = std::vector<Row>;
-using BoolRow = std::vector<bool>;
-using BoolMap = std::vector<BoolRow>;
-using Fences = absl::flat_hash_map<aoc::Dir, absl::flat_hash_set<aoc::Pos>>;
+// Bordered by a tile no plot uses, so every map edge is a fence.
+using Map = aoc::Grid<Tile>;
+constexpr Tile kOutside = '.';
+// Fence tiles by side of the plot they're on, as a set and in the order they were found.
+struct Fences {
+  aoc::GridBitset<4> set;
+  std::array<std::vector<i64>, 4> found;
+};
 
-std::tuple<u64, u64, u64> ScanPlot(const Map &map, u64 height, u64 width, i64 i, i64 j, BoolMap& scanned) {
+// `fences` is scratch space, reused across plots.
+std::tuple<u64, u64, u64> ScanPlot(
+    const Map &map, i64 start, aoc::GridBitset<>& scanned, Fences& fences) {
   u64 area = 0;
   u64 perimeter = 0;
-  Tile tile = map.at(i).at(j);
-  std::deque<aoc::Pos> q;
-  q.emplace_back(i, j);
-  scanned[i][j] = true;
-  Fences fences;
+  Tile tile = map[start];
+  const auto offsets = map.Offsets();
+  std::deque<i64> q;
+  q.push_back(start);
+  scanned.Insert(start);
+  fences.set.Clear();
+  for (auto& found : fences.found) found.clear();
   while (!q.empty()) {
     auto pos = q.back();
     q.pop_back();
     area++;
-    for (aoc::Dir dir : aoc::kAllDirs) {
-      auto new_pos = pos + aoc::MoveDir(dir);
-      if (aoc::util::IsOutOfMap(height, width, new_pos)) {
+    for (u32 d = 0; d < aoc::kAllDirs.size(); d++) {
+      auto new_pos = pos + offsets[d];
+      if (map[new_pos] != tile) {
         perimeter++;
-        fences[dir].insert(new_pos);
+        fences.set.Insert(new_pos, d);
+        fences.found[d].push_back(new_pos);
         continue;
       }
-      if (map.at(new_pos.i).at(new_pos.j) != tile) {
-        perimeter++;
-        fences[dir].insert(new_pos);
-        continue;
-      }
-      if (scanned.at(new_pos.i).at(new_pos.j)) continue;
+      if (!scanned.Insert(new_pos)) continue;
       q.push_front(new_pos);
-      scanned[new_pos.i][new_pos.j] = true;
     }
   }
   u64 sides = 0;
-  for (auto dir : aoc::kAllDirs) {
-    auto& fence = fences[dir];
-    while (!fence.empty()) {
-      auto start = *fence.begin();
-      fence.erase(start);
+  for (u32 d = 0; d < aoc::kAllDirs.size(); d++) {
+    auto dir = aoc::kAllDirs[d];
+    for (auto start : fences.found[d]) {
+      if (!fences.set.Contains(start, d)) continue;
+      fences.set.Erase(start, d);
       sides++;
       // Look left for continuous fence.
-      auto left_move = aoc::MoveDir(aoc::TurnLeft(dir));
+      auto left_move = map.Offset(aoc::TurnLeft(dir));
       auto pos = start;
       while (true) {
         pos = pos + left_move;
-        if (!fence.contains(pos)) break;
-        fence.erase(pos);
+        if (!fences.set.Contains(pos, d)) break;
+        fences.set.Erase(pos, d);
       }
       // Look right for continuous fence.
-      auto right_move = aoc::MoveDir(aoc::TurnRight(dir));
+      auto right_move = map.Offset(aoc::TurnRight(dir));
       pos = start;
       while(true) {
         pos = pos + right_move;
-        if (!fence.contains(pos)) break;
-        fence.erase(pos);
+        if (!fences.set.Contains(pos, d)) break;
+        fences.set.Erase(pos, d);
       }
     }
   }
   return {area, perimeter, sides};
 }
 
-}  // namespace
+}  // namespace aoc_2024_12
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 12>::solve() -> Result {
-  Map map = aoc::util::TokenizeInput<Row>(input, [](auto line){
-    return Row{line.begin(), line.end()};
-  });
-  u64 height = map.size();
-  u64 width = map.at(0).size();
+struct advent<2024, 12>::Parsed {
+  aoc_2024_12::Map map;
+};
+
+template<>
+auto advent<2024, 12>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_12;
+  Map map(input, [](char ch) { return ch; }, 1, kOutside);
+  return std::make_shared<Parsed>(std::move(map));
+}
+
+template<>
+auto advent<2024, 12>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_12;
+  const auto& [map] = parsed;
 
   // Part 1 & Part 2
   u64 part1 = 0;
   u64 part2 = 0;
 
-  BoolMap scanned;
-  for (u64 i = 0; i < height; i++) scanned.emplace_back(width, false);
+  aoc::GridBitset<> scanned(map.Size());
+  Fences fences{aoc::GridBitset<4>(map.Size()), {}};
 
   u64 area, perimeter, sides;
-  for (i64 i = 0; i < height; i++) {
-    for (i64 j = 0; j < width; j++) {
-      if (scanned.at(i).at(j)) continue;
-      std::tie(area, perimeter, sides) = ScanPlot(map, height, width, i, j, scanned);
+  for (i64 i = 0; i < map.Height(); i++) {
+    for (i64 j = 0; j < map.Width(); j++) {
+      const i64 start = map.Index(i, j);
+      if (scanned.Contains(start)) continue;
+      std::tie(area, perimeter, sides) = ScanPlot(map, start, scanned, fences);
       part1 += area * perimeter;
       part2 += area * sides;
     }
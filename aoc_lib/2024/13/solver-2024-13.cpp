@@ -1,9 +1,9 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 #include "re2/re2.h"
 
-namespace {
+namespace aoc_2024_13 {
 
 RE2 InputPattern(R"(Button A: X\+(\d+), Y\+(\d+)\nButton B: X\+(\d+), Y\+(\d+)\nPrize: X=(\d+), Y=(\d+))");
 using Arcade = std::tuple<i64, i64, i64, i64, i64, i64>;
@@ -28,21 +28,32 @@ bool SolveArcade(const Arcade &arcade, i64 &tokens, bool is_part2) {
   return true;
 }
 
-}  // namespace
+}  // namespace aoc_2024_13
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 13>::solve() -> Result {
-  std::vector<absl::string_view> parts = absl::StrSplit(input, "\n\n", absl::SkipWhitespace());
-  Arcades arcades;
-  absl::c_transform(parts, std::back_inserter(arcades), [](absl::string_view part) {
+struct advent<2024, 13>::Parsed {
+  aoc_2024_13::Arcades arcades;
+};
+
+template<>
+auto advent<2024, 13>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_13;
+  Arcades arcades = aoc::util::TokenizeInput<Arcade>(input, [](absl::string_view part) {
     i64 ax, ay, bx, by, gx, gy;
     CHECK(RE2::FullMatch(part, InputPattern, &ax, &ay, &bx, &by, &gx, &gy)) << "Could parse '" << part << "'";
     return std::make_tuple(ax, ay, bx, by, gx, gy);
-  });
+  }, "\n\n");
+  return std::make_shared<Parsed>(std::move(arcades));
+}
+
+template<>
+auto advent<2024, 13>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_13;
+  const auto& [arcades] = parsed;
 
   // Part 1 & Part 2
   u64 part1 = 0, part2 = 0;
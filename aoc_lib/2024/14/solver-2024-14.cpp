@@ -1,9 +1,9 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2024_14 {
 
 RE2 InputPattern(R"(p=(-?\d+),(-?\d+) v=(-?\d+),(-?\d+))");
 using Robot = std::pair<aoc::Pos, aoc::Pos>;
@@ -51,19 +51,33 @@ bool DetectRobotConcentration(u32 fence, u32 required, const Robots &robots) {
   return false;
 }
 
-}  // namespace
+}  // namespace aoc_2024_14
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 14>::solve() -> Result {
+struct advent<2024, 14>::Parsed {
+  aoc_2024_14::Robots robots;
+};
+
+template<>
+auto advent<2024, 14>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_14;
   Robots robots = aoc::util::TokenizeInput<Robot>(input, [](auto line) {
     i64 px, py, vx, vy;
     CHECK(RE2::FullMatch(line, InputPattern, &px, &py, &vx, &vy)) << "Could not parse '" << line << "'.";
     return std::make_pair(aoc::Pos{py, px}, aoc::Pos{vy, vx});
   });
+  return std::make_shared<Parsed>(std::move(robots));
+}
+
+template<>
+auto advent<2024, 14>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_14;
+  // Copied: the robots are moved in place.
+  auto robots = parsed.robots;
 
   u32 height = 103, width = 101;
 
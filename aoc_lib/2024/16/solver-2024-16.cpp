@@ -1,113 +1,86 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_search.h>
 
-#include <absl/container/btree_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_16 {
 
 enum class Tile : char {
   EMPTY = '.',
   WALL = '#',
 };
-using Row = std::vector<Tile>;
-using Map = std::vector<Row>;
-using PosDir = std::tuple<aoc::Pos, aoc::Dir>;
-using ScorePosDir = std::tuple<i64, aoc::Pos, aoc::Dir>;
-using State = std::priority_queue<ScorePosDir, std::vector<ScorePosDir>, std::greater<>>;
-
-std::tuple<bool, aoc::Pos> TryMove(const Map &map, const aoc::Pos &from, aoc::Dir dir) {
-  auto new_pos = from + aoc::MoveDir(dir);
-  return {map.at(new_pos.i).at(new_pos.j) == Tile::EMPTY, new_pos};
-}
+using Map = aoc::Grid<Tile>;
+using Search = aoc::search::ShortestPaths<4, aoc::search::Record::kAllPaths>;
 
 std::tuple<u64, u64> SolveMap(const Map &map) {
-  u64 height = map.size(), width = map.at(0).size();
-  aoc::Pos start{static_cast<i64>(height) - 2, 1}, end{1, static_cast<i64>(width) - 2};
-  aoc::Dir start_dir{aoc::Dir::E};
-  State pq;
-  pq.emplace(0, start, start_dir);
-  absl::flat_hash_map<PosDir, absl::flat_hash_set<PosDir>> predecessor;
-  absl::btree_map<PosDir, u64> scores;
-  scores[{start, start_dir}] = 0;
-  absl::flat_hash_map<PosDir, i64> visited{};
-  i64 end_score = std::numeric_limits<i64>::max();
-  while (!pq.empty()) {
-    const auto [score, pos, dir] = pq.top();
-    pq.pop();
-    if (pos == end) continue;
-    PosDir pos_dir{pos, dir};
-    for (auto d : aoc::kAllDirs) {
-      if (d == aoc::OppositeDir(dir)) continue;
-      auto [can_move, new_pos] = TryMove(map, pos, d);
-      if (!can_move) continue;
-      u64 extra_score = (dir != d) ? 1001 : 1;
-      u64 new_score = score + extra_score;
-      PosDir new_pos_dir{new_pos, d};
-      if (scores.contains(new_pos_dir) && scores.at(new_pos_dir) < new_score) continue;
-      if (!scores.contains(new_pos_dir) || scores.at(new_pos_dir) > new_score) {
-        scores[new_pos_dir] = new_score;
-        predecessor[new_pos_dir].clear();
-      }
-      predecessor[new_pos_dir].insert(pos_dir);
-      pq.emplace(new_score, new_pos, d);
-    }
-  }
-  PosDir end_n{end, aoc::Dir::N};
-  PosDir end_e{end, aoc::Dir::E};
-  u64 best_score = std::min(scores.at(end_e), scores.at(end_n));
-  std::deque<PosDir> q;
-  if (scores.at(end_n) == best_score) q.push_back(end_n);
-  if (scores.at(end_e) == best_score) q.push_back(end_e);
-  absl::flat_hash_set<aoc::Pos> best_seats;
-  while (!q.empty()) {
-    auto pos_dir = q.front();
-    q.pop_front();
-    auto pos = std::get<0>(pos_dir);
-    best_seats.insert(pos);
-    if (pos == start) continue;
-    for (const auto &pred : predecessor.at(pos_dir)) {
-      q.push_back(pred);
-    }
+  i64 start = map.Index(map.Height() - 2, 1), end = map.Index(1, map.Width() - 2);
+  const auto offsets = map.Offsets();
+  Search search(map.Size());
+  // Both end directions can tie at the best score, so the search runs on until it settles a state
+  // past the first end state it settled rather than stopping there.
+  aoc::search::Cost end_score = aoc::search::kUnreachable;
+  // Moving on costs 1, turning and moving 1001; the reindeer never turns back.
+  search.Run(
+      {{start, aoc::DirIndex(aoc::Dir::E)}},
+      [&](const aoc::search::State &from, auto &&edge) {
+        for (u32 d = 0; d < 4; d++) {
+          if (d == ((from.dir + 2) & 3)) continue;
+          i64 new_pos = from.index + offsets[d];
+          if (map[new_pos] != Tile::EMPTY) continue;
+          edge({new_pos, d}, d == from.dir ? 1 : 1001);
+        }
+      },
+      [&](const aoc::search::State &state) {
+        aoc::search::Cost score = search.Distance(state);
+        if (state.index == end) end_score = std::min(end_score, score);
+        return score > end_score;
+      });
+  u64 score_n = search.Distance(end, aoc::Dir::N);
+  u64 score_e = search.Distance(end, aoc::Dir::E);
+  CHECK(score_n != aoc::search::kUnreachable || score_e != aoc::search::kUnreachable)
+      << "The end can't be reached.";
+  u64 best_score = std::min(score_e, score_n);
+  aoc::GridBitset<> best_seats(map.Size());
+  auto visit = [&](const aoc::search::State &state) { best_seats.Insert(state.index); };
+  aoc::search::State end_n{end, aoc::DirIndex(aoc::Dir::N)}, end_e{end, aoc::DirIndex(aoc::Dir::E)};
+  if (score_n == best_score && score_e == best_score) {
+    search.ForEachOnPaths({end_n, end_e}, visit);
+  } else {
+    search.ForEachOnPaths({score_n == best_score ? end_n : end_e}, visit);
   }
 
-  return {best_score, best_seats.size()};
+  return {best_score, best_seats.Count()};
 }
 
-}  // namespace
+}  // namespace aoc_2024_16
 
 namespace fmt {
 
 template<>
-struct formatter<Tile> : formatter<char> {
-  auto format(Tile tile, format_context &ctx) const {
+struct formatter<aoc_2024_16::Tile> : formatter<char> {
+  auto format(aoc_2024_16::Tile tile, format_context &ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(tile), ctx);
   }
 };
-template<>
-struct formatter<std::vector<Tile>> : formatter<string_view> {
-  auto format(std::vector<Tile> row, format_context &ctx) const {
-    return formatter<string_view>::format(fmt::format("{}", join(row, "")), ctx);
-  }
-};
-template<>
-struct formatter<Map> : formatter<string_view> {
-  auto format(const Map &map, format_context &ctx) const {
-    return formatter<string_view>::format(fmt::format("{}", join(map, "\n")), ctx);
-  }
-};
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 16>::solve() -> Result {
-  Map map = aoc::util::TokenizeInput<Row>(input, [](auto line) {
-    Row row;
-    absl::c_transform(line, std::back_inserter(row), [](char ch) { return (ch == '#') ? Tile::WALL : Tile::EMPTY; });
-    return row;
-  });
+struct advent<2024, 16>::Parsed {
+  aoc_2024_16::Map map;
+};
 
+template<>
+auto advent<2024, 16>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_16;
+  Map map(input, [](char ch) { return (ch == '#') ? Tile::WALL : Tile::EMPTY; });
+  return std::make_shared<Parsed>(std::move(map));
+}
+
+template<>
+auto advent<2024, 16>::Solve(const Parsed& parsed) -> Result {
   // Part 1 & Part 2
-  auto [part1, part2] = SolveMap(map);
+  auto [part1, part2] = SolveMap(parsed.map);
 
   return aoc::result(part1, part2);
 }
@@ -1,9 +1,9 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 #include <re2/re2.h>
 
-namespace {
+namespace aoc_2024_17 {
 
 RE2 RegisterPattern(R"(Register .: (\d+))");
 enum class Op : u8 {
@@ -49,14 +49,21 @@ void Execute(Op op, u8 operand, Registers &regs, Output &output, u16 &instructio
   instruction += 2;
 }
 
-}  // namespace
+}  // namespace aoc_2024_17
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 17>::solve() -> Result {
+struct advent<2024, 17>::Parsed {
+  std::vector<u64> regs;
+  std::vector<u8> program;
+};
+
+template<>
+auto advent<2024, 17>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_17;
   std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
   CHECK(lines.size() == 4) << "Unexpected number of lines: " << lines.size();
   std::vector<u64> regs(3, 0);
@@ -67,6 +74,15 @@ auto advent<2024, 17>::solve() -> Result {
   auto program_str = lines[3].substr(lines[3].find(' ') + 1);
   std::vector<u8> program;
   aoc::util::ScanList(program_str, program, ",");
+  return std::make_shared<Parsed>(std::move(regs), std::move(program));
+}
+
+template<>
+auto advent<2024, 17>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_17;
+  const auto& program = parsed.program;
+  // Copied: the registers are updated while executing.
+  auto regs = parsed.regs;
 
   // Part 1
   u16 instruction = 0;
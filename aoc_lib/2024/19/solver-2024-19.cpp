@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_19 {
 
 using Pattern = absl::string_view;
 using Patterns = std::vector<Pattern>;
@@ -23,17 +23,31 @@ u64 Formable(const Pattern &pattern, const Patterns &towels, Cache &cache) {
   return solutions;
 }
 
-}  // namespace
+}  // namespace aoc_2024_19
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 19>::solve() -> Result {
+struct advent<2024, 19>::Parsed {
+  aoc_2024_19::Patterns towels;
+  aoc_2024_19::Patterns patterns;
+};
+
+template<>
+auto advent<2024, 19>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_19;
   std::vector<absl::string_view> parts = absl::StrSplit(input, "\n\n", absl::SkipWhitespace());
   Patterns towels = absl::StrSplit(parts.at(0), ", ", absl::SkipWhitespace());
   Patterns patterns = absl::StrSplit(parts.at(1), "\n", absl::SkipWhitespace());
+  return std::make_shared<Parsed>(std::move(towels), std::move(patterns));
+}
+
+template<>
+auto advent<2024, 19>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_19;
+  const auto& [towels, patterns] = parsed;
 
   // Part 1 & Part 2
   u64 part1 = 0, part2 = 0;
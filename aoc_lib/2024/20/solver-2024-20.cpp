@@ -1,9 +1,10 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_search.h>
 
 #include <absl/container/btree_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_20 {
 
 enum class Tile : char {
   EMPTY = '.',
@@ -12,123 +13,109 @@ enum class Tile : char {
   END = 'E',
 };
 
-using Row = std::vector<Tile>;
-using Map = std::vector<Row>;
-using Path = std::vector<aoc::Pos>;
-
-std::tuple<bool, aoc::Pos> TryMove(const Map &map,
-                                   u32 height,
-                                   u32 width,
-                                   const aoc::Pos &from,
-                                   aoc::Dir dir) {
-  auto new_pos = from + aoc::MoveDir(dir);
-  if (aoc::util::IsOutOfMap(height, width, new_pos)) return {false, new_pos};
-  auto tile = map[new_pos.i][new_pos.j];
-  if (tile == Tile::WALL) return {false, new_pos};
-  return {true, new_pos};
-}
+// Longest cheat of any part. The map gets a border of walls this wide, so no cheat leaves it.
+constexpr i32 kMaxCheat = 20;
+
+using Map = aoc::Grid<Tile>;
+using Search = aoc::search::ShortestPaths<>;
 
-Path SolveNoCheat(const Map &map, u32 height, u32 width, aoc::Pos &start, aoc::Pos &end) {
-  std::vector<aoc::Pos> result{start};
-  aoc::Pos pos, prev;
-  pos = start;
-  bool started = false;
-  while (pos != end) {
-    for (aoc::Dir d : aoc::kAllDirs) {
-      auto [can_move, new_pos] = TryMove(map, height, width, pos, d);
-      if (!can_move) continue;
-      if (started && new_pos == prev) continue;
-      started = true;
-      result.push_back(new_pos);
-      prev = pos;
-      pos = new_pos;
+// Distance of every track tile from `source` without cheating, -1 on walls and unreachable tiles.
+std::vector<i32> SolveNoCheat(const Map &map, i64 source) {
+  const auto offsets = map.Offsets();
+  Search search(map.Size());
+  search.Bfs({{source}}, [&](const aoc::search::State &from, auto &&edge) {
+    for (i64 offset : offsets) {
+      i64 new_pos = from.index + offset;
+      if (map[new_pos] != Tile::WALL) edge({new_pos}, 1);
     }
+  });
+  std::vector<i32> distances(map.Size(), -1);
+  for (i64 pos = 0; pos < map.Size(); pos++) {
+    aoc::search::Cost distance = search.Distance({pos});
+    if (distance != aoc::search::kUnreachable) distances[pos] = static_cast<i32>(distance);
   }
-  return result;
+  return distances;
 }
 
+// A cheat from `a` to `b` saves the race without cheats minus the best race through it:
+// start to `a`, the cheat, then `b` to the end. That holds whether or not the track forks.
 absl::btree_map<u32, u32> SolveWithCheats(const Map &map,
-                                          u32 height,
-                                          u32 width,
-                                          const Path &no_cheat_path,
+                                          const std::vector<i32> &distance_from_start,
+                                          const std::vector<i32> &distance_from_end,
+                                          i32 no_cheat,
                                           i32 budget) {
+  CHECK(budget <= kMaxCheat) << "Cheat of " << budget << " leaves the map.";
   absl::btree_map<u32, u32> result{};
-  const auto &end = no_cheat_path.back();
-  u32 no_cheat_dist = no_cheat_path.size() - 1;
-  absl::flat_hash_set<std::pair<aoc::Pos, aoc::Pos>>
-      already_counted;
-  absl::flat_hash_map<aoc::Pos, u32> distance_from_end;
-  for (u32 p = 0; p <= no_cheat_dist; p++) {
-    distance_from_end[no_cheat_path.at(p)] = no_cheat_dist - p;
+  // Every (offset, steps) within the budget; each pair of tiles is visited once.
+  std::vector<std::pair<i64, i32>> cheats;
+  for (i32 di = -budget; di <= budget; di++) {
+    i32 j_budget = budget - abs(di);
+    for (i32 dj = -j_budget; dj <= j_budget; dj++) {
+      if (di == 0 && dj == 0) continue;
+      cheats.emplace_back(di * map.Stride() + dj, abs(di) + abs(dj));
+    }
   }
-  for (const auto &cheat_at : no_cheat_path) {
-    if (cheat_at == end) break;
-    for (i32 di = -budget; di <= budget; di++) {
-      i32 j_budget = budget - abs(di);
-      for (i32 dj = -j_budget; dj <= j_budget; dj++) {
-        if (di == 0 && dj == 0) continue;
-        aoc::Pos new_pos{cheat_at.i + di, cheat_at.j + dj};
-        if (aoc::util::IsOutOfMap(height, width, new_pos)) continue;
-        if (map.at(new_pos.i).at(new_pos.j) == Tile::WALL) continue;
-        std::pair<aoc::Pos, aoc::Pos> pos_pair = std::make_pair(cheat_at, new_pos);
-        i32 cheat_steps = abs(di) + abs(dj);
-        if (already_counted.contains(pos_pair)) continue;
-        if (distance_from_end.at(cheat_at) > distance_from_end.at(new_pos) + cheat_steps) {
-          u32 savings = distance_from_end.at(cheat_at) - distance_from_end.at(new_pos) - cheat_steps;
-          result[savings]++;
-          already_counted.insert(pos_pair);
-        }
+  for (i64 cheat_at = 0; cheat_at < map.Size(); cheat_at++) {
+    i32 before = distance_from_start[cheat_at];
+    if (before < 0) continue;
+    for (auto [offset, cheat_steps] : cheats) {
+      i32 after = distance_from_end[cheat_at + offset];
+      if (after < 0) continue;
+      if (no_cheat > before + cheat_steps + after) {
+        result[no_cheat - before - cheat_steps - after]++;
       }
     }
   }
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2024_20
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 20>::solve() -> Result {
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
-  u32 height = lines.size();
-  u32 width = lines.at(0).size();
-  Map map;
-  aoc::Pos start, end;
-  for (u32 i = 0; i < height; i++) {
-    map.emplace_back();
-    for (u32 j = 0; j < width; j++) {
-      char ch = lines.at(i).at(j);
-      switch (ch) {
-        case '.': map[i].push_back(Tile::EMPTY);
-          break;
-        case '#': map[i].push_back(Tile::WALL);
-          break;
-        case 'S': map[i].push_back(Tile::START);
-          start.i = i;
-          start.j = j;
-          break;
-        case 'E': map[i].push_back(Tile::END);
-          end.i = i;
-          end.j = j;
-          break;
-        default: CHECK(false) << "Unexpected character in map '" << ch << "'.";
-      }
+struct advent<2024, 20>::Parsed {
+  aoc_2024_20::Map map;
+  i64 start, end;
+};
+
+template<>
+auto advent<2024, 20>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_20;
+  Map map(input, [](char ch) {
+    switch (ch) {
+      case '.': return Tile::EMPTY;
+      case '#': return Tile::WALL;
+      case 'S': return Tile::START;
+      case 'E': return Tile::END;
+      default: CHECK(false) << "Unexpected character in map '" << ch << "'.";
     }
-  }
+    return Tile::WALL;
+  }, kMaxCheat, Tile::WALL);
+  i64 start = map.Find(Tile::START);
+  i64 end = map.Find(Tile::END);
+  return std::make_shared<Parsed>(std::move(map), start, end);
+}
+
+template<>
+auto advent<2024, 20>::Solve(const Parsed& parsed) -> Result {
+  const auto& [map, start, end] = parsed;
 
   // Part 1
-  auto no_cheat_path = SolveNoCheat(map, height, width, start, end);
-  auto cheat_saves_1 = SolveWithCheats(map, height, width, no_cheat_path, 2);
+  auto distance_from_start = SolveNoCheat(map, start);
+  auto distance_from_end = SolveNoCheat(map, end);
+  i32 no_cheat = distance_from_end[start];
+  CHECK(no_cheat >= 0) << "The end can't be reached from the start.";
+  auto cheat_saves_1 = SolveWithCheats(map, distance_from_start, distance_from_end, no_cheat, 2);
   u64 part1 = 0;
   for (auto it = cheat_saves_1.lower_bound(100); it != cheat_saves_1.end(); it++) {
     part1 += it->second;
   }
 
   // Part 2
-  auto cheat_saves_2 = SolveWithCheats(map, height, width, no_cheat_path, 20);
+  auto cheat_saves_2 = SolveWithCheats(map, distance_from_start, distance_from_end, no_cheat, 20);
   u64 part2 = 0;
   for (auto it = cheat_saves_2.lower_bound(100); it != cheat_saves_2.end(); it++) {
     part2 += it->second;
@@ -1,9 +1,9 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_21 {
 
 using Codes = std::vector<absl::string_view>;
 using KeyPad = absl::flat_hash_map<char, aoc::Pos>;
@@ -183,19 +183,30 @@ bool Compare(const Route &a, const Route &b, const RouteMap &dir_route_map, Comp
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2024_21
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 21>::solve() -> Result {
-  auto parsing_start = std::chrono::high_resolution_clock::now();
+struct advent<2024, 21>::Parsed {
+  std::vector<absl::string_view> codes;
+};
 
+template<>
+auto advent<2024, 21>::Parse() -> std::shared_ptr<const Parsed> {
+  auto parse_phase = Phase("parse");
   std::vector<absl::string_view> codes = absl::StrSplit(input, "\n", absl::SkipWhitespace());
-  auto prework_all_start = std::chrono::high_resolution_clock::now();
+  return std::make_shared<Parsed>(std::move(codes));
+}
+
+template<>
+auto advent<2024, 21>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_21;
+  const auto& [codes] = parsed;
 
+  auto routes_phase = Phase("routes");
   KeyPad num_key_pad{
       {'7', {0, 0}},
       {'8', {0, 1}},
@@ -222,17 +233,16 @@ auto advent<2024, 21>::solve() -> Result {
   std::vector<char> num_keys = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A'};
   std::vector<char> dir_keys = {'^', 'v', '<', '>', 'A'};
   RouteMap num_route_map = GetAllValidRoutes(num_key_pad, num_keys);
-  fflush(stdout);
   RouteMap dir_route_map = GetAllValidRoutes(dir_key_pad, dir_keys);
-  auto prework_best_start = std::chrono::high_resolution_clock::now();
+  routes_phase.Stop();
+
+  auto best_num_phase = Phase("best_num");
   BestRouteMap best_num_route_map, best_dir_route_map;
   CompareCache compare_cache{};
   for (auto &it : num_route_map) {
-    auto best_start = std::chrono::high_resolution_clock::now();
     CHECK(it.second.size() <= 2) << "Too many routes for [" << it.first.first << "," << it.first.second << "].";
     if (it.second.size() < 2) {
       best_num_route_map[it.first] = it.second.at(0);
-//      fmt::print("{} -> {}\n", it.first, best_num_route_map[it.first]);
       continue;
     } else if (Compare(it.second.at(0), it.second.at(1), dir_route_map, compare_cache)) {
       best_num_route_map[it.first] = it.second.at(0);
@@ -241,22 +251,14 @@ auto advent<2024, 21>::solve() -> Result {
       best_num_route_map[it.first] = it.second.at(1);
       std::erase(num_route_map[it.first], it.second.at(0));
     }
-    auto best_end = std::chrono::high_resolution_clock::now();
-    auto best_duration = (long double) std::chrono::duration_cast<std::chrono::nanoseconds>(
-        best_end - best_start).count();
-    if (best_duration > 1'000'000)
-      fmt::print("{} -> {} - {:0.5f} sec\n",
-                 it.first,
-                 best_num_route_map[it.first],
-                 best_duration / 1.0e9l);
-    fflush(stdout);
   }
-  auto prework_num_end = std::chrono::high_resolution_clock::now();
+  best_num_phase.Stop();
+
+  auto best_dir_phase = Phase("best_dir");
   for (const auto &it : dir_route_map) {
     CHECK(it.second.size() <= 2) << "Too many routes for [" << it.first.first << "," << it.first.second << "].";
     if (it.second.size() < 2) {
       best_dir_route_map[it.first] = it.second.at(0);
-//      fmt::print("{} -> {}\n", it.first, best_dir_route_map[it.first]);
       continue;
     } else if (Compare(it.second.at(0), it.second.at(1), dir_route_map, compare_cache)) {
       best_dir_route_map[it.first] = it.second.at(0);
@@ -265,15 +267,12 @@ auto advent<2024, 21>::solve() -> Result {
       best_dir_route_map[it.first] = it.second.at(1);
       std::erase(dir_route_map[it.first], it.second.at(0));
     }
-    fmt::print("{} -> {}\n", it.first, best_dir_route_map[it.first]);
-    fflush(stdout);
   }
-  auto prework_dir_end = std::chrono::high_resolution_clock::now();
+  best_dir_phase.Stop();
 
   // Part 1 & Part 2
   u64 part1 = 0, part2 = 0;
   LenCache len_cache{};
-  std::chrono::nanoseconds part_1_dur(0), part_2_dur(0);
   for (auto code : codes) {
     u64 code_value = 0;
     for (char ch : code) {
@@ -281,27 +280,15 @@ auto advent<2024, 21>::solve() -> Result {
       code_value = 10 * code_value + ch - '0';
     }
     std::string sequence = GetBestKeySequence(code, best_num_route_map);
-    auto part_1_start = std::chrono::high_resolution_clock::now();
-    part1 += code_value * DFSForCode(sequence, best_dir_route_map, 2, len_cache);
-    auto part_2_start = std::chrono::high_resolution_clock::now();
-    part_1_dur += std::chrono::duration_cast<std::chrono::nanoseconds>(part_2_start - part_1_start);
-    part2 += code_value * DFSForCode(sequence, best_dir_route_map, 25, len_cache);
-    auto part_2_end = std::chrono::high_resolution_clock::now();
-    part_2_dur += std::chrono::duration_cast<std::chrono::nanoseconds>(part_2_end - part_2_start);
+    {
+      auto part1_phase = Phase("part1");
+      part1 += code_value * DFSForCode(sequence, best_dir_route_map, 2, len_cache);
+    }
+    {
+      auto part2_phase = Phase("part2");
+      part2 += code_value * DFSForCode(sequence, best_dir_route_map, 25, len_cache);
+    }
   }
-  fmt::print(
-      "Parsing: {:0.5f} sec\nPrework all: {:0.5f} sec\nPrework num: {:0.5f} sec\nPrework dir: {:0.5f} sec\nPart 1: {:0.5f} sec\nPart 2: {:0.5f} sec\n",
-      (long double) std::chrono::duration_cast<std::chrono::nanoseconds>(prework_all_start - parsing_start).count()
-          / 1.0e9l,
-      (long double) std::chrono::duration_cast<std::chrono::nanoseconds>(prework_best_start - prework_all_start).count()
-          / 1.0e9l,
-      (long double) std::chrono::duration_cast<std::chrono::nanoseconds>(prework_num_end - prework_best_start).count()
-          / 1.0e9l,
-      (long double) std::chrono::duration_cast<std::chrono::nanoseconds>(prework_dir_end - prework_num_end).count()
-          / 1.0e9l,
-      (long double) part_1_dur.count() / 1.0e9l,
-      (long double) part_2_dur.count() / 1.0e9l);
-  fflush(stdout);
 
   return aoc::result(part1, part2);
 }
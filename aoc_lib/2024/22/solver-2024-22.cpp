@@ -1,8 +1,9 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_parallel.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_22 {
 
 using Secret = u32;
 using DiffSeq = u32;
@@ -13,45 +14,112 @@ inline Secret GetNextSecret(Secret secret) {
   return (secret ^ (secret << 11)) & 0xFFFFFF;
 }
 
-}  // namespace
+// Runs the 2000 secrets after `secret` and calls `sell(diff_seq, price)` on every price after the
+// first four changes. Returns the last secret.
+template<typename Sell>
+Secret RunBuyer(Secret secret, Sell&& sell) {
+  DiffSeq diff_seq{0};
+  auto old_price = secret % 10;
+  for (u16 i = 0; i < 2000; i++) {
+    secret = GetNextSecret(secret);
+    auto price = secret % 10;
+    auto price_diff = price - old_price + 9;
+    old_price = price;
+    diff_seq <<= 5;
+    diff_seq |= price_diff;
+    if (i < 3) continue; else diff_seq &= 0xFFFFF;
+    sell(diff_seq, price);
+  }
+  return secret;
+}
+
+// Both parts over every buyer in turn, with one table of totals.
+std::pair<u64, u64> SolveSerial(const std::vector<Secret>& initial_secrets) {
+  u64 part1 = 0;
+  std::vector<u32> seen(0xFFFFF, std::numeric_limits<u32>::max());
+  std::vector<u32> bought(0xFFFFF, 0);
+  for (u32 buyer = 0; buyer < initial_secrets.size(); buyer++) {
+    part1 += RunBuyer(initial_secrets[buyer], [&](const DiffSeq diff_seq, const u32 price) {
+      if (seen[diff_seq] == buyer) return;
+      seen[diff_seq] = buyer;
+      bought[diff_seq] += price;
+    });
+  }
+  return {part1, *absl::c_max_element(bought)};
+}
+
+// Both parts with the buyers split over `pool`. Every chunk totals its own buyers, then adds the
+// sequences it saw to the shared totals. Its tables are megabytes, so there's one chunk per
+// thread; integer sums come out the same anyway.
+std::pair<u64, u64> SolveParallel(
+    aoc::parallel::ThreadPool& pool, const std::vector<Secret>& initial_secrets) {
+  std::vector<std::atomic<u32>> bought(0xFFFFF);
+  i64 num_buyers = initial_secrets.size();
+  i64 threads = pool.NumThreads();
+  u64 part1 = aoc::parallel::ParallelReduce(
+      pool, num_buyers, (num_buyers + threads - 1) / threads, u64{0},
+      [&](i64 begin, i64 end) {
+        u64 secrets = 0;
+        // Last buyer of the chunk to see each sequence, counted from 1 so that 0 is none yet.
+        std::vector<u32> seen(0xFFFFF, 0);
+        std::vector<u32> chunk_bought(0xFFFFF, 0);
+        std::vector<DiffSeq> chunk_seqs;
+        chunk_seqs.reserve(19 * 19 * 19 * 19);
+        for (i64 buyer = begin; buyer < end; buyer++) {
+          u32 local_buyer = buyer - begin + 1;
+          secrets += RunBuyer(initial_secrets[buyer], [&](const DiffSeq diff_seq, const u32 price) {
+            if (seen[diff_seq] == local_buyer) return;
+            if (seen[diff_seq] == 0) chunk_seqs.push_back(diff_seq);
+            seen[diff_seq] = local_buyer;
+            chunk_bought[diff_seq] += price;
+          });
+        }
+        for (DiffSeq seq : chunk_seqs) {
+          bought[seq].fetch_add(chunk_bought[seq], std::memory_order_relaxed);
+        }
+        return secrets;
+      },
+      std::plus<>{});
+  u64 part2 = 0;
+  for (const auto& total : bought) {
+    part2 = std::max<u64>(part2, total.load(std::memory_order_relaxed));
+  }
+  return {part1, part2};
+}
+
+}  // namespace aoc_2024_22
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 22>::solve() -> Result {
+struct advent<2024, 22>::Parsed {
+  std::vector<aoc_2024_22::Secret> initial_secrets;
+};
+
+template<>
+auto advent<2024, 22>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_22;
   std::vector<Secret> initial_secrets = aoc::util::TokenizeInput<Secret>(input, [](auto line) {
     Secret val;
     CHECK(std::from_chars(line.data(), line.data() + line.size(), val).ec == std::errc{})
             << "Unable to parse '" << line << "'.";
     return val;
   });
+  return std::make_shared<Parsed>(std::move(initial_secrets));
+}
+
+template<>
+auto advent<2024, 22>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_22;
+  const auto& [initial_secrets] = parsed;
 
   // Part 1 & Part 2
-  u64 part1 = 0;
-  DiffSeq diff_seq{0};
-  std::vector<u32> seen(0xFFFFF, std::numeric_limits<u32>::max());
-  std::vector<u32> bought(0xFFFFF, 0);
-  for (u32 buyer = 0; buyer < initial_secrets.size(); buyer++) {
-    Secret secret = initial_secrets.at(buyer);
-    auto old_price = secret % 10;
-    for (u16 i = 0; i < 2000; i++) {
-      secret = GetNextSecret(secret);
-      auto price = secret % 10;
-      auto price_diff = price - old_price + 9;
-      old_price = price;
-      diff_seq <<= 5;
-      diff_seq |= price_diff;
-      if (i < 3) continue; else diff_seq &= 0xFFFFF;
-
-      if (seen.at(diff_seq) == buyer) continue;
-      seen[diff_seq] = buyer;
-      bought[diff_seq] += price;
-    }
-    part1 += secret;
-  }
-  u64 part2 = *absl::c_max_element(bought);
+  // With one thread the per-chunk tables and atomic totals only add overhead.
+  aoc::parallel::ThreadPool& pool = aoc::parallel::DefaultPool();
+  const auto [part1, part2] = pool.NumThreads() == 1 ? SolveSerial(initial_secrets)
+                                                     : SolveParallel(pool, initial_secrets);
 
   return aoc::result(part1, part2);
 }
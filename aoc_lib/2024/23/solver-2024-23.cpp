@@ -1,117 +1,121 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_graph.h>
 
-#include <absl/container/btree_map.h>
-#include <absl/container/btree_set.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_23 {
 
-using Computer = absl::string_view;
-using Computers = absl::btree_set<Computer>;
-using Connection = absl::btree_set<Computer>;
-using Connections = absl::btree_set<Connection>;
-using ConnectedWith = absl::btree_map<Computer, Computers>;
+using Id = u32;
 
-Computer ChoosePivot(const ConnectedWith &connected_with, const Computers &p, const Computers &x) {
-  u32 most_connections = 0;
-  Computer pivot;
-  for (auto u : p) {
-    u32 connections = connected_with.at(u).size();
-    if (most_connections < connections) {
-      most_connections = connections;
-      pivot = u;
+// Whether two computers are connected, as a bit matrix over their ids, so the clique search tests
+// a link in constant time rather than by scanning a neighbour list.
+class Links {
+ public:
+  Links() = default;
+  explicit Links(const aoc::CsrGraph &graph)
+      : _size(graph.NumNodes()), _linked(u64{_size} * _size) {
+    for (Id a = 0; a < _size; a++) {
+      for (const Id b : graph.Neighbors(a)) _linked[u64{a} * _size + b] = true;
     }
   }
-  for (auto u : x) {
-    u32 connections = connected_with.at(u).size();
-    if (most_connections < connections) {
-      most_connections = connections;
-      pivot = u;
-    }
-  }
-  return pivot;
-}
+  [[nodiscard]] bool operator()(Id a, Id b) const { return _linked[u64{a} * _size + b]; }
 
-void BronKerbosch2(const ConnectedWith &connected_with,
-                   Computers r,
-                   Computers p,
-                   Computers x,
-                   std::vector<Computers> &solutions) {
-  if (p.empty() && x.empty()) {
-    solutions.emplace_back(r.begin(), r.end());
+ private:
+  u32 _size{0};
+  std::vector<bool> _linked;
+};
+
+// Bron–Kerbosch with a pivot: grows `r` by the computers of `p`, all linked to every one of `r`,
+// into the cliques that don't extend by a computer of `x`, and keeps the largest in `best`.
+// Branches that can't outgrow `best` are cut.
+void MaxClique(const aoc::CsrGraph &graph, const Links &linked, std::vector<Id> &r,
+               std::vector<Id> p, std::vector<Id> x, std::vector<Id> &best) {
+  if (r.size() + p.size() <= best.size()) return;
+  if (p.empty()) {
+    if (x.empty()) best = r;
     return;
   }
-  auto u = ChoosePivot(connected_with, p, x);
-  Computers p_copy = p;
-  for (auto v : p_copy) {
-    if (connected_with.at(u).contains(v)) continue;
-    Computers ri = r;
-    ri.insert(v);
-    std::vector<Computer> pl;
-    absl::c_set_intersection(p, connected_with.at(v), std::back_inserter(pl));
-    Computers pi{pl.begin(), pl.end()};
-    std::vector<Computer> xl;
-    absl::c_set_intersection(x, connected_with.at(v), std::back_inserter(xl));
-    Computers xi{xl.begin(), xl.end()};
-    BronKerbosch2(connected_with, ri, pi, xi, solutions);
-    p.erase(v);
-    x.insert(v);
+  Id pivot = p.front();
+  const auto consider = [&](Id u) {
+    if (graph.Degree(u) > graph.Degree(pivot)) pivot = u;
+  };
+  absl::c_for_each(p, consider);
+  absl::c_for_each(x, consider);
+  std::vector<Id> branches;
+  absl::c_copy_if(p, std::back_inserter(branches), [&](Id v) { return !linked(pivot, v); });
+  for (const Id v : branches) {
+    const auto linked_to_v = [&](Id w) { return linked(v, w); };
+    std::vector<Id> pv, xv;
+    absl::c_copy_if(p, std::back_inserter(pv), linked_to_v);
+    absl::c_copy_if(x, std::back_inserter(xv), linked_to_v);
+    r.push_back(v);
+    MaxClique(graph, linked, r, std::move(pv), std::move(xv), best);
+    r.pop_back();
+    std::erase(p, v);
+    x.push_back(v);
   }
 }
 
-}  // namespace
-
-namespace fmt {
+}  // namespace aoc_2024_23
 
-}  // namespace fmt
+template<>
+struct advent<2024, 23>::Parsed {
+  aoc::Interner ids;
+  aoc::CsrGraph graph;
+  aoc_2024_23::Links linked;
+};
 
 template<>
-auto advent<2024, 23>::solve() -> Result {
-  std::vector<absl::string_view> lines = absl::StrSplit(input, "\n", absl::SkipWhitespace());
-  Connections connections;
-  Computers computers;
-  ConnectedWith connected_with;
-  for (auto line : lines) {
-    std::vector<Computer> comps = absl::StrSplit(line, "-", absl::SkipWhitespace());
-    CHECK(comps.size() == 2) << "Unexpected number of computers in connection '" << line << "'.";
-    computers.insert(comps.at(0));
-    computers.insert(comps.at(1));
-    connections.emplace(comps.begin(), comps.end());
-    connected_with[comps.at(0)].insert(comps.at(1));
-    connected_with[comps.at(1)].insert(comps.at(0));
+auto advent<2024, 23>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_23;
+  aoc::Interner ids;
+  std::vector<std::pair<Id, Id>> edges;
+  for (absl::string_view line : aoc::util::Tokens(input)) {
+    auto dash = line.find('-');
+    CHECK(dash != absl::string_view::npos && line.find('-', dash + 1) == absl::string_view::npos)
+        << "Unexpected number of computers in connection '" << line << "'.";
+    edges.emplace_back(ids.Intern(line.substr(0, dash)), ids.Intern(line.substr(dash + 1)));
   }
+  aoc::CsrGraph graph = aoc::CsrGraph::Undirected(ids.Size(), edges);
+  Links linked(graph);
+  return std::make_shared<Parsed>(std::move(ids), std::move(graph), std::move(linked));
+}
+
+template<>
+auto advent<2024, 23>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_23;
+  const auto& [ids, graph, linked] = parsed;
+  const auto historian = [&ids](Id id) { return ids.Name(id).starts_with('t'); };
 
   // Part 1
-  Connections interconnections;
-  for (const auto &comp : computers) {
-    if (comp.at(0) != 't') continue;
-    std::vector<Computer> others(connected_with.at(comp).begin(), connected_with.at(comp).end());
-    for (u32 i = 0; i < others.size(); i++) {
-      for (u32 j = i + 1; j < others.size(); j++) {
-        Connection connection{};
-        connection.insert(others.at(i));
-        connection.insert(others.at(j));
-        if (connections.contains(connection)) {
-          connection.insert(comp);
-          interconnections.insert(connection);
-        }
+  // Each triangle is counted once, from its smallest id.
+  u64 part1 = 0;
+  for (Id a = 0; a < graph.NumNodes(); a++) {
+    for (const Id b : graph.Neighbors(a)) {
+      if (b < a) continue;
+      for (const Id c : graph.Neighbors(b)) {
+        if (c < b || !linked(a, c)) continue;
+        if (historian(a) || historian(b) || historian(c)) part1++;
       }
     }
   }
-  u64 part1 = interconnections.size();
 
   // Part 2
-  std::vector<Computers> cliques;
-  BronKerbosch2(connected_with, {}, computers, {}, cliques);
-  u32 max_clique_size = 0;
-  Computers clique;
-  for (const auto& c : cliques) {
-    if (c.size() > max_clique_size) {
-      max_clique_size = c.size();
-      clique = c;
-    }
+  // A clique lies within one component, so each is searched on its own, largest first, and
+  // components no larger than the best clique so far are skipped.
+  const auto components = aoc::ConnectedComponents(graph);
+  std::vector<std::vector<Id>> members(components.sizes.size());
+  for (Id id = 0; id < graph.NumNodes(); id++) members[components.of[id]].push_back(id);
+  absl::c_sort(members, [](const auto &a, const auto &b) { return a.size() > b.size(); });
+  std::vector<Id> clique, r;
+  for (auto &component : members) {
+    if (component.size() <= clique.size()) break;
+    MaxClique(graph, linked, r, std::move(component), {}, clique);
   }
-  auto part2 = absl::StrJoin(clique, ",");
+  std::vector<absl::string_view> names;
+  for (const Id id : clique) names.push_back(ids.Name(id));
+  absl::c_sort(names);
+  auto part2 = absl::StrJoin(names, ",");
 
   return aoc::result(part1, part2);
 }
@@ -1,27 +1,23 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_graph.h>
 
-#include <absl/container/btree_map.h>
-#include <absl/container/btree_set.h>
 #include <fmt/format.h>
-#include <re2/re2.h>
 
-namespace {
+namespace aoc_2024_24 {
 
 enum class Op : char {
   AND = '&',
   OR = '|',
   XOR = '^',
 };
-using GateId = absl::string_view;
-using Gate = struct GateStr {
-  std::pair<GateId, GateId> inputs;
-  GateId output;
+using Id = u32;
+constexpr Id kNone = aoc::Interner::kNotFound;
+// The gate driving a wire, or none for the x and y input wires.
+struct Gate {
+  std::pair<Id, Id> inputs{kNone, kNone};
   Op op{Op::AND};
+  [[nodiscard]] bool IsInput() const { return inputs.first == kNone; }
 };
-using ValMap = absl::btree_map<GateId, bool>;
-using GateIdSet = absl::btree_set<GateId>;
-using GateIdList = std::vector<GateId>;
-using GateDefs = absl::btree_map<GateId, Gate>;
 
 bool ApplyOp(Op op, bool a, bool b) {
   switch (op) {
@@ -31,103 +27,41 @@ bool ApplyOp(Op op, bool a, bool b) {
   }
 }
 
-u64 SetToNum(const GateIdList &ids, const ValMap &values) {
-  u64 result = 0;
-  u64 index = 1;
-  for (auto id : ids) {
-    if (values.contains(id) && values.at(id)) result |= index;
-    index <<= 1;
-  }
-  return result;
-}
-void NumToSet(u64 value, const GateIdList &ids, ValMap &values) {
-  for (auto id : ids) {
-    values[id] = value & 1;
-    value >>= 1;
-  }
-}
-
-void CalcValues(const GateDefs &gates, const GateIdSet &ids, ValMap &values, GateIdSet &used) {
-  GateIdSet todo{};
-  used.clear();
-  for (auto id : ids) {
-    if (values.contains(id)) continue;
-    todo.insert(id);
-  }
-  while (!todo.empty()) {
-    GateIdSet done{};
-    for (auto id : todo) {
-      const auto &gate = gates.at(id);
-      if (values.contains(gate.inputs.first) && values.contains(gate.inputs.second)) {
-        values[gate.output] = ApplyOp(gate.op, values.at(gate.inputs.first), values.at(gate.inputs.second));
-        used.insert(gate.output);
-        done.insert(gate.output);
-      }
-    }
-    for (auto id : done) todo.erase(id);
-  }
-}
-void CalcGates(const GateDefs &gates, const GateIdList &gate_ids, ValMap &values, GateIdSet &used) {
-  std::deque<GateId> todo{gate_ids.begin(), gate_ids.end()};
-  used.clear();
-  GateIdSet done{};
-  while (!todo.empty()) {
-    for (auto id : todo) {
-      if (done.contains(id)) continue;
-      const auto &gate = gates.at(id);
-      if (values.contains(gate.inputs.first) && values.contains(gate.inputs.second)) {
-        values[gate.output] = ApplyOp(gate.op, values.at(gate.inputs.first), values.at(gate.inputs.second));
-        used.insert(gate.output);
-        done.insert(gate.output);
-        continue;
-      }
-      if (!values.contains(gate.inputs.first)) {
-        todo.push_front(gate.inputs.first);
-      }
-      if (!values.contains(gate.inputs.second)) {
-        todo.push_front(gate.inputs.second);
-      }
-      break;
-    }
-    std::deque<GateId> new_todo;
-    for (auto id : todo) if (!done.contains(id)) new_todo.push_back(id);
-    std::swap(todo, new_todo);
-  }
-}
-
-bool IsValid(const GateDefs &gates, GateId id) {
-  if (!gates.contains(id)) return true;
-  const auto &gate = gates.at(id);
-  if (id.at(0) == 'z' && id != "z45") {
+// Whether the gate driving `id` fits a ripple-carry adder whose last carry is `last_z`: sums are
+// XORs into z, the XORs of x and y feed no OR, and the ANDs of x and y, past the half adder of
+// bit 0, feed only ORs. `wires` has an arc from every wire to the gates it feeds.
+bool IsValid(const aoc::Interner &ids, const std::vector<Gate> &gates, const aoc::CsrGraph &wires,
+             Id last_z, Id id) {
+  const auto &gate = gates[id];
+  if (gate.IsInput()) return true;
+  const auto name = [&ids](Id wire) { return ids.Name(wire); };
+  const auto feeds = [&](Op op) {
+    return absl::c_any_of(wires.Neighbors(id), [&](Id out) { return gates[out].op == op; });
+  };
+  const auto [a, b] = gate.inputs;
+  if (name(id).at(0) == 'z' && id != last_z) {
     return gate.op == Op::XOR;
   }
   if (gate.op == Op::XOR) {
-    if (gate.output.at(0) != 'z') {
-      if (gate.inputs.first.at(0) != 'x' && gate.inputs.first.at(0) != 'y') return false;
-      for (const auto &other : gates) {
-        if (other.second.inputs.first != id && other.second.inputs.second != id) continue;
-        if (other.second.op == Op::OR) return false;
-      }
+    if (name(id).at(0) != 'z') {
+      if (name(a).at(0) != 'x' && name(a).at(0) != 'y') return false;
+      if (feeds(Op::OR)) return false;
     }
   } else if (gate.op == Op::AND) {
-    if ((gate.inputs.first.at(0) == 'x' || gate.inputs.second.at(0) == 'x') &&
-        gate.inputs.first != "x00" && gate.inputs.second != "x00") {
-      for (const auto &other : gates) {
-        if (other.second.inputs.first != id && other.second.inputs.second != id) continue;
-        if (other.second.op != Op::OR) return false;
-      }
+    if ((name(a).at(0) == 'x' || name(b).at(0) == 'x') && name(a) != "x00" && name(b) != "x00") {
+      if (feeds(Op::AND) || feeds(Op::XOR)) return false;
     }
   }
   return true;
 }
 
-}  // namespace
+}  // namespace aoc_2024_24
 
 namespace fmt {
 
 template<>
-struct formatter<Op> : formatter<char> {
-  auto format(Op op, format_context &ctx) const {
+struct formatter<aoc_2024_24::Op> : formatter<char> {
+  auto format(aoc_2024_24::Op op, format_context &ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(op), ctx);
   }
 };
@@ -135,25 +69,32 @@ struct formatter<Op> : formatter<char> {
 }  // namespace fmt
 
 template<>
-auto advent<2024, 24>::solve() -> Result {
+struct advent<2024, 24>::Parsed {
+  aoc::Interner ids;
+  // By wire id.
+  std::vector<aoc_2024_24::Gate> gates;
+  std::vector<bool> values;
+  // An arc from every wire to the gates it feeds.
+  aoc::CsrGraph wires;
+  // The output wires, from z00 up.
+  std::vector<aoc_2024_24::Id> zs;
+};
+
+template<>
+auto advent<2024, 24>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_24;
   std::vector<absl::string_view> parts = absl::StrSplit(input, "\n\n", absl::SkipWhitespace());
 
-  ValMap values{};
-  GateIdSet all_gate_ids{};
-  GateIdList xs{};
-  GateIdList ys{};
-  for (auto line : absl::StrSplit(parts.at(0), "\n", absl::SkipWhitespace())) {
+  aoc::Interner ids;
+  std::vector<std::pair<Id, bool>> initial;
+  for (absl::string_view line : aoc::util::Tokens(parts.at(0))) {
     CHECK(line.size() == 6) << "Unexpected format for line '" << line << "'.";
-    auto gate_id = line.substr(0, 3);
-    values[gate_id] = line.at(5) == '1';
-    all_gate_ids.insert(gate_id);
-    if (gate_id.at(0) == 'x') xs.push_back(gate_id);
-    else if (gate_id.at(0) == 'y') ys.push_back(gate_id);
+    initial.emplace_back(ids.Intern(line.substr(0, 3)), line.at(5) == '1');
   }
 
-  GateIdList zs{};
-  GateDefs all_gates{};
-  for (auto line : absl::StrSplit(parts.at(1), "\n", absl::SkipWhitespace())) {
+  std::vector<std::pair<Id, Gate>> defs;
+  std::vector<std::pair<Id, Id>> arcs;
+  for (absl::string_view line : aoc::util::Tokens(parts.at(1))) {
     Gate gate;
     u32 gate_len = 3;
     switch (line.at(4)) {
@@ -166,29 +107,56 @@ auto advent<2024, 24>::solve() -> Result {
         break;
       default: CHECK(false) << "Unexpected gate format '" << line << "'.";
     }
-    gate.inputs = std::make_pair(line.substr(0, 3), line.substr(5 + gate_len, 3));
-    gate.output = line.substr(12 + gate_len, 3);
-    all_gates[gate.output] = gate;
-    all_gate_ids.insert(gate.output);
-    if (gate.output.at(0) == 'z') zs.push_back(gate.output);
+    gate.inputs = {ids.Intern(line.substr(0, 3)), ids.Intern(line.substr(5 + gate_len, 3))};
+    const Id output = ids.Intern(line.substr(12 + gate_len, 3));
+    defs.emplace_back(output, gate);
+    arcs.emplace_back(gate.inputs.first, output);
+    arcs.emplace_back(gate.inputs.second, output);
+  }
+
+  std::vector<Gate> gates(ids.Size());
+  std::vector<bool> values(ids.Size());
+  std::vector<Id> zs;
+  for (const auto& [id, value] : initial) values[id] = value;
+  for (const auto &[output, gate] : defs) {
+    gates[output] = gate;
+    if (ids.Name(output).at(0) == 'z') zs.push_back(output);
   }
-  absl::c_sort(xs);
-  absl::c_sort(ys);
-  absl::c_sort(zs);
+  absl::c_sort(zs, [&ids](Id a, Id b) { return ids.Name(a) < ids.Name(b); });
+  aoc::CsrGraph wires(ids.Size(), arcs);
+  return std::make_shared<Parsed>(
+      std::move(ids), std::move(gates), std::move(values), std::move(wires), std::move(zs));
+}
+
+template<>
+auto advent<2024, 24>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_24;
+  const auto& [ids, gates, _, wires, zs] = parsed;
+  // Copied: part 1 fills in the values of the computed gates.
+  auto values = parsed.values;
 
   // Part 1
-  GateIdSet used{};
-  CalcGates(all_gates, zs, values, used);
-  u64 part1 = SetToNum(zs, values);
+  const auto order = aoc::TopologicalOrder(wires);
+  CHECK(order.has_value()) << "The gates form a loop.";
+  for (const Id id : *order) {
+    const auto &gate = gates[id];
+    if (!gate.IsInput()) {
+      values[id] = ApplyOp(gate.op, values[gate.inputs.first], values[gate.inputs.second]);
+    }
+  }
+  u64 part1 = 0;
+  for (u64 bit = 0; bit < zs.size(); bit++) {
+    if (values[zs[bit]]) part1 |= u64{1} << bit;
+  }
 
   // Part 2
-  GateIdSet invalid{};
-  for (auto id : all_gate_ids) {
-    if (!IsValid(all_gates, id)) {
-      invalid.insert(id);
+  std::vector<absl::string_view> invalid;
+  for (Id id = 0; id < ids.Size(); id++) {
+    if (!IsValid(ids, gates, wires, zs.empty() ? kNone : zs.back(), id)) {
+      invalid.push_back(ids.Name(id));
     }
   }
-//  absl::string_view part2{absl::StrJoin(invalid, ",")};
+  absl::c_sort(invalid);
 
   return aoc::result(part1, absl::StrJoin(invalid, ","));
 }
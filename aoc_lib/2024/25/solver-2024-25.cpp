@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2024_25 {
 
 using Column = u8;
 using Schematic = std::vector<Column>;
@@ -29,14 +29,20 @@ bool IsFit(const auto &lock, const auto &key) {
   return true;
 }
 
-}  // namespace
+}  // namespace aoc_2024_25
 
 namespace fmt {
 
 }  // namespace fmt
 
 template<>
-auto advent<2024, 25>::solve() -> Result {
+struct advent<2024, 25>::Parsed {
+  aoc_2024_25::Schematics keys, locks;
+};
+
+template<>
+auto advent<2024, 25>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2024_25;
   std::vector<absl::string_view> blocks = absl::StrSplit(input, "\n\n", absl::SkipWhitespace());
 
   Schematics keys, locks;
@@ -44,6 +50,13 @@ auto advent<2024, 25>::solve() -> Result {
     auto [is_key, schematic] = ParseKey(block);
     if (is_key) keys.push_back(schematic); else locks.push_back(schematic);
   }
+  return std::make_shared<Parsed>(std::move(keys), std::move(locks));
+}
+
+template<>
+auto advent<2024, 25>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2024_25;
+  const auto& [keys, locks] = parsed;
 
   // Part 1
   u64 part1 = 0;
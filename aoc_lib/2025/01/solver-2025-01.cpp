@@ -1,24 +1,37 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {}  // namespace
+namespace aoc_2025_01 {}  // namespace aoc_2025_01
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 01>::solve() -> Result {
+struct advent<2025, 01>::Parsed {
   std::vector<i32> rotations;
+};
+
+template<>
+auto advent<2025, 01>::Parse() -> std::shared_ptr<const Parsed> {
+  auto parse_phase = Phase("parse");
+  auto parsed = std::make_shared<Parsed>();
   i32 i;
   for (auto line : input | std::views::split('\n')) {
     const auto line_start = std::ranges::data(line);
     const auto line_end = line_start + std::ranges::size(line);
     fast_float::from_chars(line_start + 1, line_end, i);
     if (*line_start == 'L') i = -i;
-    rotations.push_back(i);
+    parsed->rotations.push_back(i);
   }
+  return parsed;
+}
+
+template<>
+auto advent<2025, 01>::Solve(const Parsed& parsed) -> Result {
+  const auto& [rotations] = parsed;
 
   // Part 1 & Part 2
+  auto parts_phase = Phase("parts");
   u64 part1 = 0, part2 = 0;
   i32 dial = 50, new_dial;
   for (i32 rotation : rotations) {
@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_02 {
 
 using Id = u64;
 using Range = std::pair<Id, Id>;
@@ -55,20 +55,35 @@ u64 CountInvalid(u64 start, u64 end, bool all_splits) {
   return absl::c_accumulate(invalid_ids, 0ll);
 }
 
-}  // namespace
+}  // namespace aoc_2025_02
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 02>::solve() -> Result {
-  Ranges ranges;
+struct advent<2025, 02>::Parsed {
+  aoc_2025_02::Ranges ranges;
+};
+
+template<>
+auto advent<2025, 02>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_02;
+  auto parse_phase = Phase("parse");
+  auto parsed = std::make_shared<Parsed>();
   for (auto line : input | std::views::split(',')) {
     std::vector<Id> result;
     aoc::util::FastScanList(line, result, "-");
-    ranges.emplace_back(result[0], result[1]);
+    parsed->ranges.emplace_back(result[0], result[1]);
   }
+  return parsed;
+}
+
+template<>
+auto advent<2025, 02>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_02;
+  const auto& [ranges] = parsed;
 
   // Part 1 & Part 2
+  auto parts_phase = Phase("parts");
   u64 part1 = 0, part2 = 0;
   for (const Range& range : ranges) {
     part1 += CountInvalid(range.first, range.second, false);
@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_03 {
 
 using Bank = std::string_view;
 using Banks = std::vector<Bank>;
@@ -20,19 +20,35 @@ u64 ScanBank(std::string_view bank, u32 bak_size, u32 needed) {
   return joltage;
 }
 
-}  // namespace
+}  // namespace aoc_2025_03
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 03>::solve() -> Result {
-  Banks banks = input | std::views::split('\n') | std::views::transform([](auto rng) {
-                  return std::string_view(&*std::ranges::begin(rng), std::ranges::distance(rng));
-                }) |
-                std::ranges::to<Banks>();
+struct advent<2025, 03>::Parsed {
+  aoc_2025_03::Banks banks;
+};
+
+template<>
+auto advent<2025, 03>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_03;
+  auto parse_phase = Phase("parse");
+  auto parsed = std::make_shared<Parsed>();
+  parsed->banks = input | std::views::split('\n') | std::views::transform([](auto rng) {
+                    return std::string_view(&*std::ranges::begin(rng), std::ranges::distance(rng));
+                  }) |
+                  std::ranges::to<Banks>();
+  return parsed;
+}
+
+template<>
+auto advent<2025, 03>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_03;
+  const auto& [banks] = parsed;
   i32 bank_size = static_cast<i32>(banks[0].length());
 
   // Part 1 & 2
+  auto parts_phase = Phase("parts");
   u64 part1 = 0, part2 = 0;
   for (auto bank : banks) {
     part1 += ScanBank(bank, bank_size, 2);
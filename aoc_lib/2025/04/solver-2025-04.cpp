@@ -2,7 +2,7 @@
 
 #include <Eigen/Dense>
 
-namespace {
+namespace aoc_2025_04 {
 
 using Map = Eigen::Array<u32, Eigen::Dynamic, Eigen::Dynamic>;
 
@@ -29,12 +29,22 @@ u64 RemoveAccessible(Map& map) {
   return result;
 }
 
-}  // namespace
+}  // namespace aoc_2025_04
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 04>::solve() -> Result {
+struct advent<2025, 04>::Parsed {
+  u32 height;
+  u32 width;
+  aoc_2025_04::Map map;
+};
+
+template<>
+auto advent<2025, 04>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_04;
+  auto parse_phase = Phase("parse");
+  auto parsed = std::make_shared<Parsed>();
   u32 width = input.find_first_of('\n');
   u32 height = input.size() / width;
   Map map(height, width);
@@ -47,10 +57,26 @@ auto advent<2025, 04>::solve() -> Result {
     }
     map(i, j++) = c == '.' ? 0 : 1;
   }
+  parsed->height = height;
+  parsed->width = width;
+  parsed->map = std::move(map);
+  return parsed;
+}
 
+template<>
+auto advent<2025, 04>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_04;
+  const auto& [height, width, map] = parsed;
+
+  // Part 1
+  auto part1_phase = Phase("part1");
   Map new_map = GetFreedomMap(map, height, width);
   u64 accessible = RemoveAccessible(new_map);
   u64 part1 = accessible;
+  part1_phase.Stop();
+
+  // Part 2
+  auto part2_phase = Phase("part2");
   u64 part2 = 0;
   while (accessible > 0) {
     part2 += accessible;
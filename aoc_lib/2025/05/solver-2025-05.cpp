@@ -1,20 +1,28 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_05 {
 
 using Id = u64;
 using Ids = std::vector<Id>;
 using IdRanges = absl::btree_map<Id, Id>;
 
-}  // namespace
+}  // namespace aoc_2025_05
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 05>::solve() -> Result {
+struct advent<2025, 05>::Parsed {
+  aoc_2025_05::Ids ids;
+  aoc_2025_05::IdRanges ranges;
+};
+
+template<>
+auto advent<2025, 05>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_05;
+  auto parse_phase = Phase("parse");
   Ids ids;
   IdRanges ranges;
   bool ranges_done = false;
@@ -36,8 +44,16 @@ auto advent<2025, 05>::solve() -> Result {
     fast_float::from_chars(line_start, line_end, id);
     ids.emplace_back(id);
   }
+  return std::make_shared<Parsed>(std::move(ids), std::move(ranges));
+}
+
+template<>
+auto advent<2025, 05>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_05;
+  const auto& [ids, ranges] = parsed;
 
   // Part 1
+  auto part1_phase = Phase("part1");
   u64 part1 = 0;
   for (auto id : ids) {
     for (auto it = ranges.begin(); it != ranges.upper_bound(id); it++) {
@@ -47,8 +63,10 @@ auto advent<2025, 05>::solve() -> Result {
       }
     }
   }
+  part1_phase.Stop();
 
   // Part 2
+  auto part2_phase = Phase("part2");
   u64 part2 = 0;
   IdRanges disjoint;
   for (auto [from, to] : ranges) {
@@ -1,8 +1,8 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_06 {
 
 enum Op : char {
   ADDITION = '+',
@@ -13,13 +13,13 @@ using NumRow = std::vector<u64>;
 using Sheet = std::vector<NumRow>;
 using OpList = std::vector<Op>;
 
-}  // namespace
+}  // namespace aoc_2025_06
 
 namespace fmt {
 
 template<>
-struct formatter<Op> : formatter<char> {
-  auto format(const Op op, format_context& ctx) const {
+struct formatter<aoc_2025_06::Op> : formatter<char> {
+  auto format(const aoc_2025_06::Op op, format_context& ctx) const {
     return formatter<char>::format(aoc::ToUnderlying(op), ctx);
   }
 };
@@ -27,10 +27,19 @@ struct formatter<Op> : formatter<char> {
 }  // namespace fmt
 
 template<>
-auto advent<2025, 06>::solve() -> Result {
+struct advent<2025, 06>::Parsed {
+  aoc_2025_06::Sheet sheet;
+  aoc_2025_06::OpList ops;
+  std::vector<std::string_view> lines;
+};
+
+template<>
+auto advent<2025, 06>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_06;
+  auto parse_phase = Phase("parse");
   Sheet sheet;
   OpList ops;
-  std::vector<std::string> lines = absl::StrSplit(input, "\n");
+  std::vector<std::string_view> lines = absl::StrSplit(input, "\n");
   for (auto line : lines) {
     if (line[0] == '*' || line[0] == '+') {
       for (auto c : line) {
@@ -42,8 +51,16 @@ auto advent<2025, 06>::solve() -> Result {
     sheet.emplace_back();
     aoc::util::FastScanList(line, sheet.back());
   }
+  return std::make_shared<Parsed>(std::move(sheet), std::move(ops), std::move(lines));
+}
+
+template<>
+auto advent<2025, 06>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_06;
+  const auto& [sheet, ops, lines] = parsed;
 
   // Part 1
+  auto part1_phase = Phase("part1");
   u64 part1 = 0;
   for (u32 j = 0; j < ops.size(); j++) {
     auto op = ops[j];
@@ -56,8 +73,10 @@ auto advent<2025, 06>::solve() -> Result {
     }
     part1 += sum;
   }
+  part1_phase.Stop();
 
   // Part 2
+  auto part2_phase = Phase("part2");
   u64 part2 = 0;
   u64 j_from = 0, j_to;
   u32 num_rows = lines.size() - 1;
@@ -1,20 +1,29 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_07 {
 
 using TrapRow = absl::flat_hash_set<u32>;
 using Traps = absl::flat_hash_map<u32, TrapRow>;
 using Beams = absl::btree_map<u32, u64>;
 
-}  // namespace
+}  // namespace aoc_2025_07
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 07>::solve() -> Result {
+struct advent<2025, 07>::Parsed {
+  u32 start;
+  u32 height;
+  aoc_2025_07::Traps traps;
+};
+
+template<>
+auto advent<2025, 07>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_07;
+  auto parse_phase = Phase("parse");
   u32 row = 0;
   u32 start = input.find('S');
   u32 j_start = start;
@@ -34,17 +43,25 @@ auto advent<2025, 07>::solve() -> Result {
     j_end++;
     row++;
   }
-  u32 height = row;
+  return std::make_shared<Parsed>(start, row, std::move(traps));
+}
+
+template<>
+auto advent<2025, 07>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_07;
+  const auto& [start, height, traps] = parsed;
 
   // Part 1
+  auto part1_phase = Phase("part1");
   u64 part1 = 0;
   Beams beams;
   beams[start] = 1;
 
   for (u32 i = 2; i < height; i += 2) {
     Beams new_beams;
+    auto row_traps = traps.find(i);
     for (auto [col, num_beams] : beams) {
-      if (traps[i].contains(col)) {
+      if (row_traps != traps.end() && row_traps->second.contains(col)) {
         new_beams[col - 1] += num_beams;
         new_beams[col + 1] += num_beams;
         part1++;
@@ -54,8 +71,10 @@ auto advent<2025, 07>::solve() -> Result {
     }
     std::swap(beams, new_beams);
   }
+  part1_phase.Stop();
 
   // Part 2
+  auto part2_phase = Phase("part2");
   u64 part2 =
       absl::c_accumulate(beams, 0ll, [](auto sum, const auto& pair) { return sum + pair.second; });
 
@@ -5,13 +5,13 @@
 #include <fmt/format.h>
 #include <Eigen/Core>
 
-namespace {
+namespace aoc_2025_08 {
 
 using Junction = Eigen::Array<u64, 3, 1>;
 using Junctions = std::vector<Junction>;
 using Distances = absl::btree_map<u64, std::pair<u32, u32>>;
 
-}  // namespace
+}  // namespace aoc_2025_08
 
 namespace fmt {
 
@@ -22,15 +22,30 @@ struct formatter<T, std::enable_if_t<std::is_base_of_v<Eigen::Array<T, 3, 1>, T>
 }  // namespace fmt
 
 template<>
-auto advent<2025, 8>::solve() -> Result {
+struct advent<2025, 8>::Parsed {
+  aoc_2025_08::Junctions junctions;
+};
+
+template<>
+auto advent<2025, 8>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_08;
+  auto parse_phase = Phase("parse");
   Junctions junctions;
   for (auto line : input | std::views::split('\n')) {
     std::vector<u64> numbers;
-    aoc::util::FasterScanList(line, numbers, 1);
+    aoc::util::FasterScanList(line, numbers, ',');
     junctions.push_back(Eigen::Map<Junction>(numbers.data()));
     const auto& foo = junctions.back();
   }
+  return std::make_shared<Parsed>(std::move(junctions));
+}
+
+template<>
+auto advent<2025, 8>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_08;
+  const auto& [junctions] = parsed;
 
+  auto distances_phase = Phase("distances");
   Distances distances;
   for (u32 i = 0; i < junctions.size() - 1; i++) {
     for (u32 j = i + 1; j < junctions.size(); j++) {
@@ -40,8 +55,10 @@ auto advent<2025, 8>::solve() -> Result {
       distances[d] = std::make_pair(i, j);
     }
   }
+  distances_phase.Stop();
 
   // Part 1 & 2
+  auto parts_phase = Phase("parts");
   u64 part1 = 1;
   u64 part2;
   std::vector<u32> junction_to_set;
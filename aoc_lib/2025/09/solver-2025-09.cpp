@@ -1,10 +1,10 @@
-#include <aoc.h>
+#include <aoc_core.h>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/btree_set.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_09 {
 
 enum Orientation : char {
   VER = 'V',
@@ -100,12 +100,21 @@ void FindPerimeter(const Sgmts& segments, i64 min_x, i64 width, Perimeter& perim
   } while (i != start);
 }
 
-}  // namespace
+}  // namespace aoc_2025_09
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 9>::solve() -> Result {
+struct advent<2025, 9>::Parsed {
+  aoc_2025_09::Tiles tiles;
+  aoc_2025_09::Perimeter perimeter;
+  i64 width;
+};
+
+template<>
+auto advent<2025, 9>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_09;
+  auto parse_phase = Phase("parse");
   //  GetInput(true);
   Tiles tiles;
   PlacedSegments vertical, horizontal;
@@ -153,8 +162,16 @@ auto advent<2025, 9>::solve() -> Result {
 
   Perimeter perimeter;
   FindPerimeter(sgmts, min_x, max_x + 10, perimeter);
+  return std::make_shared<Parsed>(std::move(tiles), std::move(perimeter), max_x + 10);
+}
+
+template<>
+auto advent<2025, 9>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_09;
+  const auto& [tiles, perimeter, width] = parsed;
 
   // Part 1 & 2
+  auto parts_phase = Phase("parts");
   u64 part1 = 0, part2 = 0;
   for (u32 i = 0; i < tiles.size() - 1; i++) {
     for (u32 j = i + 1; j < tiles.size(); j++) {
@@ -165,7 +182,7 @@ auto advent<2025, 9>::solve() -> Result {
       }
       if (part2 < area &&
           IsRectInside(
-              perimeter, max_x + 10, std::min(tiles[i].first, tiles[j].first),
+              perimeter, width, std::min(tiles[i].first, tiles[j].first),
               std::min(tiles[i].second, tiles[j].second), std::max(tiles[i].first, tiles[j].first),
               std::max(tiles[i].second, tiles[j].second))) {
         part2 = area;
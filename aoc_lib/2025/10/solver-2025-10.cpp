@@ -1,9 +1,10 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_parallel.h>
 
 #include <absl/container/btree_map.h>
 #include <fmt/format.h>
 
-namespace {
+namespace aoc_2025_10 {
 
 using Lights = u32;
 using Button = u32;
@@ -12,7 +13,9 @@ using Joltages = std::vector<u32>;
 using Machine = std::tuple<Lights, Buttons, Joltages>;
 using Machines = std::vector<Machine>;
 using ButtonCombsByNumPressed = absl::flat_hash_map<u32, std::vector<u64>>;
-using Patterns = std::vector<absl::flat_hash_map<Joltages, u64>>;
+// Joltages while solving, in the machine's arena.
+using Goal = std::pmr::vector<u32>;
+using Patterns = std::pmr::vector<aoc::pmr::flat_hash_map<Goal, u64>>;
 
 Lights ParseLights(std::string_view input, u64& index) {
   Lights lights = 0;
@@ -59,12 +62,13 @@ Joltages ParseJoltages(std::string_view input, u64& index) {
 }
 
 Patterns GetAllPatterns(
-    const ButtonCombsByNumPressed& button_combinations, const Buttons& buttons, u32 num_joltages) {
-  Patterns result(1 << num_joltages, {});
+    const ButtonCombsByNumPressed& button_combinations, const Buttons& buttons, u32 num_joltages,
+    std::pmr::memory_resource* arena) {
+  Patterns result(1 << num_joltages, arena);
   u32 num_buttons = buttons.size();
   for (u32 num_pressed = 0; num_pressed <= num_buttons; num_pressed++) {
     for (const auto& buttons_pressed : button_combinations.at(num_pressed)) {
-      Joltages pattern(num_joltages, 0);
+      Goal pattern(num_joltages, 0, arena);
       for (u32 b = 0; b < num_buttons; b++) {
         if (buttons_pressed & (1 << b))
           for (u32 j = 0; j < num_joltages; j++)
@@ -80,8 +84,8 @@ Patterns GetAllPatterns(
   return result;
 }
 
-using Cache = absl::flat_hash_map<Joltages, u64>;
-u64 SolveForPattern(const Patterns& patterns, const Joltages& goal, Cache& cache) {
+using Cache = aoc::pmr::flat_hash_map<Goal, u64>;
+u64 SolveForPattern(const Patterns& patterns, const Goal& goal, Cache& cache) {
   if (absl::c_all_of(goal, [](auto x) { return x == 0; })) return 0;
   if (cache.contains(goal)) return cache.at(goal);
   u64 result = 1'000'000;
@@ -91,7 +95,7 @@ u64 SolveForPattern(const Patterns& patterns, const Joltages& goal, Cache& cache
   }
   for (const auto& [pattern, cost] : patterns[goal_parity]) {
     bool valid = true;
-    Joltages new_goal(goal);
+    Goal new_goal(goal, goal.get_allocator());
     for (u32 i = 0; i < goal.size(); i++) {
       if ((goal[i] < pattern[i])) {  //} || ((goal[i] % 2) != (pattern[i] % 2))) {
         valid = false;
@@ -110,17 +114,27 @@ u64 SolveForPattern(const Patterns& patterns, const Joltages& goal, Cache& cache
 u64 SolveForButtonsAndPattern(
     const ButtonCombsByNumPressed& button_combinations, const Buttons& buttons,
     const Joltages& pattern) {
-  Patterns patterns = GetAllPatterns(button_combinations, buttons, pattern.size());
-  Cache cache;
-  return SolveForPattern(patterns, pattern, cache);
+  // Machines are solved in parallel, so each gets an arena of its own.
+  aoc::Arena arena;
+  Patterns patterns = GetAllPatterns(button_combinations, buttons, pattern.size(), &arena);
+  Cache cache(&arena);
+  return SolveForPattern(patterns, Goal(pattern.begin(), pattern.end(), &arena), cache);
 }
 
-}  // namespace
+}  // namespace aoc_2025_10
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 10>::solve() -> Result {
+struct advent<2025, 10>::Parsed {
+  aoc_2025_10::Machines machines;
+  u32 max_buttons;
+};
+
+template<>
+auto advent<2025, 10>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_10;
+  auto parse_phase = Phase("parse");
   Machines machines;
   Lights machine_lights;
   Buttons machine_buttons;
@@ -141,8 +155,16 @@ auto advent<2025, 10>::solve() -> Result {
     machines.emplace_back(machine_lights, machine_buttons, machine_joltages);
     if (max_buttons < machine_buttons.size()) max_buttons = machine_buttons.size();
   }
+  return std::make_shared<Parsed>(std::move(machines), max_buttons);
+}
+
+template<>
+auto advent<2025, 10>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_10;
+  const auto& [machines, max_buttons] = parsed;
 
   // Part 1
+  auto part1_phase = Phase("part1");
   u64 part1 = 0;
   ButtonCombsByNumPressed button_combinations;
   button_combinations[0].push_back({});
@@ -166,12 +188,22 @@ auto advent<2025, 10>::solve() -> Result {
       }
     }
   }
+  part1_phase.Stop();
 
   // Part 2
-  u64 part2 = 0;
-  for (const auto& [_, buttons, want_joltages] : machines) {
-    part2 += SolveForButtonsAndPattern(button_combinations, buttons, want_joltages);
-  }
+  auto part2_phase = Phase("part2");
+  // A machine per chunk: their costs vary too much for larger ones to balance.
+  u64 part2 = aoc::parallel::ParallelReduce(
+      machines.size(), 1, u64{0},
+      [&](i64 begin, i64 end) {
+        u64 presses = 0;
+        for (i64 m = begin; m < end; m++) {
+          const auto& [_, buttons, want_joltages] = machines[m];
+          presses += SolveForButtonsAndPattern(button_combinations, buttons, want_joltages);
+        }
+        return presses;
+      },
+      std::plus<>{});
 
   return aoc::result(part1, part2);
 }
@@ -1,80 +1,90 @@
-#include <aoc.h>
+#include <aoc_core.h>
+#include <aoc_graph.h>
 
 #include <fmt/format.h>
-#include <stack>
 
-namespace {
+namespace aoc_2025_11 {
 
-using Device = std::string_view;
-using Devices = absl::flat_hash_set<Device>;
-using Connections = absl::flat_hash_map<Device, Devices>;
-std::string_view YOU{"you"}, OUT{"out"}, SVR{"svr"}, DAC{"dac"}, FFT{"fft"};
-using Cache = absl::flat_hash_map<std::pair<std::string_view, std::string_view>, u64>;
+using Device = u32;
+constexpr Device kNone = aoc::Interner::kNotFound;
 
-u64 CountPaths(const Connections& connections, std::string_view from, std::string_view to) {
-  u64 result = 0;
-  if (!connections.contains(from)) return 0;
-  std::stack<std::string_view> stack;
-  stack.push(from);
-  while (!stack.empty()) {
-    auto id = stack.top();
-    stack.pop();
-    if (id == to) {
-      result++;
+// The number of paths from every device to `to` that don't pass through `out`, by summing over
+// the devices in reverse topological `order`.
+std::vector<u64> PathsTo(
+    const aoc::CsrGraph& connections, std::span<const Device> order, Device to, Device out) {
+  std::vector<u64> paths(connections.NumNodes(), 0);
+  if (to == kNone) return paths;
+  for (auto device : order | std::views::reverse) {
+    if (device == to) {
+      paths[device] = 1;
       continue;
     }
-    if (id != OUT) stack.push_range(connections.at(id));
+    if (device == out) continue;
+    for (auto next : connections.Neighbors(device)) paths[device] += paths[next];
   }
-  return result;
+  return paths;
 }
 
-u64 CountPaths(
-    const Connections& connections, std::string_view from, std::string_view to, Cache& cache) {
-  auto cache_key = std::make_pair(from, to);
-  if (cache.contains(cache_key)) return cache[cache_key];
-
-  u64 result = 0;
-  for (auto next : connections.at(from)) {
-    if (next == to) {
-      result++;
-      continue;
-    }
-    if (next == OUT) continue;
-    result += CountPaths(connections, next, to, cache);
-  }
-  cache[cache_key] = result;
-  return result;
-}
-
-}  // namespace
+}  // namespace aoc_2025_11
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 11>::solve() -> Result {
-  Connections connections;
+struct advent<2025, 11>::Parsed {
+  aoc::Interner devices;
+  aoc::CsrGraph connections;
+};
+
+template<>
+auto advent<2025, 11>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_11;
+  auto parse_phase = Phase("parse");
+  aoc::Interner devices;
+  std::vector<std::pair<Device, Device>> arcs;
   for (auto line : input | std::views::split('\n')) {
     bool is_first = true;
-    std::string_view from_id;
+    Device from_id = kNone;
     for (auto token : line | std::views::split(' ')) {
       if (is_first) {
-        from_id = std::string_view(token.begin(), token.begin() + 3);
+        from_id = devices.Intern(std::string_view(token.begin(), token.begin() + 3));
         is_first = false;
         continue;
       }
-      connections[from_id].emplace(token.begin(), token.end());
+      arcs.emplace_back(from_id, devices.Intern(std::string_view(token.begin(), token.end())));
     }
   }
+  // A device listed twice as an output of another still makes a single path.
+  absl::c_sort(arcs);
+  arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+  aoc::CsrGraph connections(devices.Size(), arcs);
+  return std::make_shared<Parsed>(std::move(devices), std::move(connections));
+}
+
+template<>
+auto advent<2025, 11>::Solve(const Parsed& parsed) -> Result {
+  using namespace aoc_2025_11;
+  const auto& [devices, connections] = parsed;
+  const Device you = devices.Find("you"), out = devices.Find("out"), svr = devices.Find("svr"),
+               dac = devices.Find("dac"), fft = devices.Find("fft");
+
+  const auto order = aoc::TopologicalOrder(connections);
+  CHECK(order.has_value()) << "The devices are connected in a loop.";
+  const auto paths = [](const std::vector<u64>& paths_to, Device from) -> u64 {
+    return from == kNone ? 0 : paths_to[from];
+  };
 
   // Part 1
-  u64 part1 = CountPaths(connections, YOU, OUT);
+  auto part1_phase = Phase("part1");
+  const auto to_out = PathsTo(connections, *order, out, out);
+  u64 part1 = paths(to_out, you);
+  part1_phase.Stop();
 
   // Part 2
-  Cache cache;
-  u64 part2 = CountPaths(connections, SVR, FFT, cache) * CountPaths(connections, FFT, DAC, cache) *
-                  CountPaths(connections, DAC, OUT, cache) +
-              CountPaths(connections, SVR, DAC, cache) * CountPaths(connections, DAC, FFT, cache) *
-                  CountPaths(connections, FFT, OUT, cache);
+  auto part2_phase = Phase("part2");
+  const auto to_dac = PathsTo(connections, *order, dac, out);
+  const auto to_fft = PathsTo(connections, *order, fft, out);
+  u64 part2 = paths(to_fft, svr) * paths(to_dac, fft) * paths(to_out, dac) +
+              paths(to_dac, svr) * paths(to_fft, dac) * paths(to_out, fft);
 
   return aoc::result(part1, part2);
 }
@@ -3,7 +3,7 @@
 #include <fmt/format.h>
 #include <Eigen/Core>
 
-namespace {
+namespace aoc_2025_12 {
 
 using Present = Eigen::Matrix3i;
 using AllPresents = std::vector<Present>;
@@ -36,12 +36,20 @@ void ParseArea(std::string_view input, u64& index, Areas& areas) {
   index = std::distance(input.data(), ptr);
 }
 
-}  // namespace
+}  // namespace aoc_2025_12
 
 namespace fmt {}  // namespace fmt
 
 template<>
-auto advent<2025, 12>::solve() -> Result {
+struct advent<2025, 12>::Parsed {
+  aoc_2025_12::Areas areas;
+  aoc_2025_12::Vector6 present_areas;
+};
+
+template<>
+auto advent<2025, 12>::Parse() -> std::shared_ptr<const Parsed> {
+  using namespace aoc_2025_12;
+  auto parse_phase = Phase("parse");
   u64 index = 0;
   AllPresents all_presents;
   ParsePresent(input, index, all_presents);
@@ -56,18 +64,27 @@ auto advent<2025, 12>::solve() -> Result {
     ParseArea(input, index, areas);
   }
 
-  Eigen::Array<u32, 6, 1> present_areas;
+  Vector6 present_areas;
   for (u32 i = 0; i < all_presents.size(); i++) {
     present_areas(i) = all_presents[i].sum();
   }
+  return std::make_shared<Parsed>(std::move(areas), present_areas);
+}
+
+template<>
+auto advent<2025, 12>::Solve(const Parsed& parsed) -> Result {
+  const auto& [areas, present_areas] = parsed;
 
   // Part 1
+  auto part1_phase = Phase("part1");
   u64 part1 = 0;
   for (const auto& [w, h, n] : areas) {
     if (h * w >= (present_areas * n).sum()) part1++;
   }
+  part1_phase.Stop();
 
   // Part 2
+  auto part2_phase = Phase("part2");
   u64 part2 = 0;
 
   return aoc::result(part1, part2);
@@ -1,132 +1,175 @@
-#include "aoc.h"
+#include "aoc_core.h"
 
-namespace aoc::util {
+#include <cstring>
+#include <filesystem>
+#include <thread>
 
-template<typename T>
-u32 NumDigits(T x) {
-  u32 digits = 0;
-  while (x) {
-    x /= 10;
-    digits++;
-  }
-  return digits;
-}
+#if __has_include(<sys/mman.h>)
+#define AOC_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-// partial specialization optimization for 64-bit numbers
-template<>
-u32 NumDigits(u64 x) {
-  if (x >= 10000000000) {
-    if (x >= 100000000000000) {
-      if (x >= 10000000000000000) {
-        if (x >= 100000000000000000) {
-          if (x >= 1000000000000000000) {
-            if (x >= 10000000000000000000u) {
-              return 20;
-            }
-            return 19;
-          }
-          return 18;
-        }
-        return 17;
-      }
-      if (x >= 1000000000000000)
-        return 16;
-      return 15;
-    }
-    if (x >= 1000000000000) {
-      if (x >= 10000000000000)
-        return 14;
-      return 13;
-    }
-    if (x >= 100000000000)
-      return 12;
-    return 11;
-  }
-  if (x >= 100000) {
-    if (x >= 10000000) {
-      if (x >= 100000000) {
-        if (x >= 1000000000)
-          return 10;
-        return 9;
-      }
-      return 8;
-    }
-    if (x >= 1000000)
-      return 7;
-    return 6;
-  }
-  if (x >= 100) {
-    if (x >= 1000) {
-      if (x >= 10000)
-        return 5;
-      return 4;
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace aoc {
+
+void InputFile::Load(const std::string& path, InputMode mode) {
+  Reset();
+#ifdef AOC_HAVE_MMAP
+  if (mode == InputMode::kMapped) {
+    int fd = open(path.c_str(), O_RDONLY);
+    CHECK(fd >= 0) << fmt::format("Could not open path {}\n", path) << std::endl;
+    struct stat st{};
+    CHECK(fstat(fd, &st) == 0) << fmt::format("Could not stat path {}\n", path) << std::endl;
+    _mapping_size = static_cast<size_t>(st.st_size);
+    if (_mapping_size > 0) {
+      void* mapping = mmap(nullptr, _mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      CHECK(mapping != MAP_FAILED) << fmt::format("Could not map path {}\n", path) << std::endl;
+      madvise(mapping, _mapping_size, MADV_SEQUENTIAL);
+      _mapping = static_cast<const char*>(mapping);
     }
-    return 3;
+    close(fd);
+    _contents = std::string_view(_mapping, _mapping_size);
+    return;
   }
-  if (x >= 10)
-    return 2;
-  return 1;
+#endif
+  std::ifstream f(path, std::ios::binary);
+  CHECK(f.is_open()) << fmt::format("Could not open path {}\n", path) << std::endl;
+  std::stringstream ss;
+  ss << f.rdbuf();
+  _buffer = std::move(ss).str();
+  _contents = _buffer;
 }
 
-// partial specialization optimization for 32-bit numbers
-template<>
-u32 NumDigits(u32 x) {
-  if (x >= 10'000) {
-    if (x >= 10'000'000) {
-      if (x >= 100'000'000) {
-        if (x >= 1'000'000'000)
-          return 10;
-        return 9;
-      }
-      return 8;
-    }
-    if (x >= 100000) {
-      if (x >= 1000000)
-        return 7;
-      return 6;
-    }
-    return 5;
-  }
-  if (x >= 100) {
-    if (x >= 1000)
-      return 4;
-    return 3;
+void InputFile::Reset() {
+#ifdef AOC_HAVE_MMAP
+  if (_mapping != nullptr) munmap(const_cast<char*>(_mapping), _mapping_size);
+#endif
+  _mapping = nullptr;
+  _mapping_size = 0;
+  _buffer.clear();
+  _contents = {};
+}
+
+namespace {
+
+// 64-bit hash of `bytes` that, unlike absl::Hash, is the same in every process, so it can name
+// files that outlive the run.
+u64 StableHash(const std::string_view bytes) {
+  constexpr u64 kMul = 0xff51afd7ed558ccd;
+  u64 h = 0x9e3779b97f4a7c15 ^ bytes.size();
+  size_t i = 0;
+  for (; i + sizeof(u64) <= bytes.size(); i += sizeof(u64)) {
+    u64 word;
+    std::memcpy(&word, bytes.data() + i, sizeof(u64));
+    h = (h ^ word) * kMul;
+    h ^= h >> 32;
   }
-  if (x >= 10)
-    return 2;
-  return 1;
+  u64 tail = 0;
+  // An empty view may have a null data(), which memcpy must not get even for 0 bytes.
+  if (i < bytes.size()) std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+  h = (h ^ tail) * kMul;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53;
+  h ^= h >> 33;
+  return h;
 }
 
-template<typename T>
-u32 NumBits(T x) {
-  u32 bits = 0;
-  while (x) {
-    if (x & 1) bits++;
-    x >>= 1;
+// Hash of the running executable, read once. Where the executable can't be read back this falls
+// back to the time this file was compiled, which only changes with a full rebuild.
+u64 BuildId() {
+  static const u64 id = [] {
+    std::ifstream f("/proc/self/exe", std::ios::binary);
+    if (!f.is_open()) return StableHash(__DATE__ " " __TIME__);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return StableHash(ss.view());
+  }();
+  return id;
+}
+
+// Tells apart the processes that may share a cache directory.
+int ProcessId() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+}  // namespace
+
+ResultCache::ResultCache(std::string directory, const Mode mode)
+    : _directory(std::move(directory)), _mode(mode) {
+  // Hashes the executable now rather than inside the first timed lookup.
+  BuildId();
+}
+
+std::string ResultCache::Key(const int year, const int day, const std::string_view input) const {
+  return fmt::format("{}-{:02}-{:016x}-{:016x}", year, day, StableHash(input), BuildId());
+}
+
+// An entry is a "<size1> <size2>" header line followed by both answers back to back, so answers
+// may span several lines. Anything that doesn't parse is a miss.
+std::optional<ResultCache::Result> ResultCache::Lookup(const std::string& key) const {
+  if (_mode == Mode::kRefresh) return std::nullopt;
+  std::ifstream f(std::filesystem::path(_directory) / key, std::ios::binary);
+  if (!f.is_open()) return std::nullopt;
+  size_t size1 = 0;
+  size_t size2 = 0;
+  if (!(f >> size1 >> size2) || f.get() != '\n') return std::nullopt;
+  std::string part1(size1, '\0');
+  std::string part2(size2, '\0');
+  if (!f.read(part1.data(), size1) || !f.read(part2.data(), size2)) return std::nullopt;
+  return Result{std::move(part1), std::move(part2)};
+}
+
+// The cache only saves time, so failing to write an entry is not an error.
+void ResultCache::Store(const std::string& key, const Result& result) const {
+  const auto& [part1, part2] = result;
+  std::error_code ec;
+  std::filesystem::create_directories(_directory, ec);
+  const auto path = std::filesystem::path(_directory) / key;
+  auto tmp = path;
+  tmp += fmt::format(
+      ".{}-{}.tmp", ProcessId(), std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+    if (!f.is_open()) return;
+    f << part1.size() << ' ' << part2.size() << '\n' << part1 << part2;
+    if (!f.flush()) return;
   }
-  return bits;
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) std::filesystem::remove(tmp, ec);
 }
-// partial specialization optimization for 64-bit numbers
-template<>
-u32 NumBits(u64 x) {
-  u64 count = x - ((x >> 1) & 0x5555555555555555);
-  count = ((count >> 2) & 0x3333333333333333) + (count & 0x3333333333333333);
-  count = ((count >> 4) + count) & 0x0F0F0F0F0F0F0F0F;
-  count = ((count >> 8) + count) & 0x00FF00FF00FF00FF;
-  count = ((count >> 16) + count) & 0x0000FFFF0000FFFF;
-  count = ((count >> 32) + count) & 0x00000000FFFFFFFF;
-  return count;
+
+void* Arena::do_allocate(const size_t bytes, const size_t alignment) {
+  _allocations++;
+  _bytes += bytes;
+  return _monotonic->allocate(bytes, alignment);
 }
-// partial specialization optimization for 32-bit numbers
-template<>
-u32 NumBits(u32 x) {
-  u32 count = x - ((x >> 1) & 0x55555555);
-  count = ((count >> 2) & 0x33333333) + (count & 0x33333333);
-  count = ((count >> 4) + count) & 0x0F0F0F0F;
-  count = ((count >> 8) + count) & 0x00FF00FF;
-  count = ((count >> 16) + count) & 0x0000FFFF;
-  return count;
+
+void Arena::Reset() {
+  _monotonic.reset();
+  if (_bytes > _block_size) {
+    _block_size = std::bit_ceil(_bytes);
+    _block = std::make_unique_for_overwrite<std::byte[]>(_block_size);
+  }
+  if (_block) {
+    _monotonic.emplace(_block.get(), _block_size, std::pmr::new_delete_resource());
+  } else {
+    _monotonic.emplace(std::pmr::new_delete_resource());
+  }
+  _allocations = 0;
+  _bytes = 0;
 }
 
-} // namespace aoc::util
+}  // namespace aoc
 
@@ -0,0 +1,1021 @@
+// The parts of aoc.h that most days need, without Eigen and fmt's color and ostream support, for
+// solvers that want to compile faster. aoc.h is this plus those.
+#ifndef ADVENTOFCODE_AOC_CORE_HPP
+#define ADVENTOFCODE_AOC_CORE_HPP
+
+#include <absl/algorithm/container.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
+#include <absl/log/check.h>
+#include <absl/strings/str_split.h>
+#include <absl/strings/substitute.h>
+
+#include <fast_float/fast_float.h>
+
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include <scn/scan.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <ranges>
+#include <sstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Convenience aliases
+using i8 = std::int8_t;
+using i16 = std::int16_t;
+using i32 = std::int32_t;
+using i64 = std::int64_t;
+
+using u8 = std::uint8_t;
+using u16 = std::uint16_t;
+using u32 = std::uint32_t;
+using u64 = std::uint64_t;
+
+// For products of u64s and answers that don't fit them. fmt formats these natively and, in the GNU
+// dialect CMake compiles with, they're std::integral and have std::numeric_limits.
+__extension__ using i128 = __int128;
+__extension__ using u128 = unsigned __int128;
+
+namespace aoc {
+
+// How advent::GetInput loads its file. kMapped exposes the file through a read-only mmap without
+// copying; kCopy reads it into an owned std::string (also used where mmap is not available).
+enum class InputMode {
+  kMapped,
+  kCopy,
+};
+
+// Owns the bytes of an input file for as long as solvers hold views into it, hence not copyable
+// or movable.
+class InputFile {
+  const char* _mapping{nullptr};
+  size_t _mapping_size{0};
+  std::string _buffer;
+  std::string_view _contents;
+
+ public:
+  InputFile() = default;
+  InputFile(const InputFile&) = delete;
+  InputFile& operator=(const InputFile&) = delete;
+  ~InputFile() { Reset(); }
+
+  void Load(const std::string& path, InputMode mode = InputMode::kMapped);
+  // Takes ownership of in-memory contents, e.g. a generated input.
+  void Assign(std::string contents) {
+    Reset();
+    _buffer = std::move(contents);
+    _contents = _buffer;
+  }
+  void Reset();
+  [[nodiscard]] std::string_view Contents() const { return _contents; }
+};
+
+// Answers of previous runs on disk, one file per (year, day, input hash, build id). The build id
+// identifies the running executable, so rebuilding any solver invalidates every entry. Entries are
+// written to a temporary file and renamed into place, so concurrent days can share a cache.
+class ResultCache {
+ public:
+  using Result = std::tuple<std::string, std::string>;
+
+  enum class Mode {
+    // Returns stored answers and stores new ones.
+    kUse,
+    // Ignores stored answers but stores the new ones over them.
+    kRefresh,
+  };
+
+  explicit ResultCache(std::string directory, Mode mode = Mode::kUse);
+
+  // Name of the entry for `input`, to pass to Lookup and Store.
+  [[nodiscard]] std::string Key(int year, int day, std::string_view input) const;
+  [[nodiscard]] std::optional<Result> Lookup(const std::string& key) const;
+  void Store(const std::string& key, const Result& result) const;
+
+ private:
+  std::string _directory;
+  Mode _mode;
+};
+
+// Drops trailing whitespace (and any other non-printable bytes) without copying.
+inline std::string_view TrimInput(const std::string_view str) {
+  auto it = std::find_if(str.rbegin(), str.rend(), absl::ascii_isprint);
+  return str.substr(0, static_cast<size_t>(str.rend() - it));
+}
+
+// Durations of named solver phases (e.g. "parse", "part1"), accumulated per name in the order
+// they were first recorded. Recording is off by default, so an unused ScopedPhase costs a branch.
+class PhaseTimes {
+  std::vector<std::pair<std::string_view, std::chrono::nanoseconds>> _phases;
+  bool _enabled{false};
+
+ public:
+  void Enable(const bool enabled = true) { _enabled = enabled; }
+  [[nodiscard]] bool Enabled() const { return _enabled; }
+  void Clear() { _phases.clear(); }
+  void Add(const std::string_view name, const std::chrono::nanoseconds duration) {
+    for (auto& [phase, total] : _phases) {
+      if (phase == name) {
+        total += duration;
+        return;
+      }
+    }
+    _phases.emplace_back(name, duration);
+  }
+  [[nodiscard]] const auto& Phases() const { return _phases; }
+};
+
+// Times from construction until Stop() or destruction, whichever comes first. The name is not
+// copied and should be a string literal.
+class ScopedPhase {
+  using Clock = std::chrono::steady_clock;
+
+  PhaseTimes* _times;
+  std::string_view _name;
+  Clock::time_point _start;
+
+ public:
+  ScopedPhase(PhaseTimes& times, const std::string_view name)
+      : _times(times.Enabled() ? &times : nullptr), _name(name) {
+    if (_times) _start = Clock::now();
+  }
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+  ~ScopedPhase() { Stop(); }
+
+  void Stop() {
+    if (!_times) return;
+    _times->Add(_name, Clock::now() - _start);
+    _times = nullptr;
+  }
+};
+
+// Scratch memory for one solve, as a std::pmr::memory_resource: allocating bumps a pointer,
+// deallocating does nothing and Reset() drops everything at once. Reset() also grows the first
+// block to what was used since the last one, so a repeated solve goes to the heap only once.
+// Not thread-safe: every thread of a parallel loop needs an Arena of its own.
+class Arena : public std::pmr::memory_resource {
+  std::unique_ptr<std::byte[]> _block;
+  size_t _block_size{0};
+  std::optional<std::pmr::monotonic_buffer_resource> _monotonic;
+  u64 _allocations{0};
+  u64 _bytes{0};
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void*, size_t, size_t) override {}
+  [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+ public:
+  Arena() { Reset(); }
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void Reset();
+  // Allocations and bytes requested since the last Reset().
+  [[nodiscard]] u64 Allocations() const { return _allocations; }
+  [[nodiscard]] u64 Bytes() const { return _bytes; }
+};
+
+// absl hash containers that allocate from a std::pmr::memory_resource such as an Arena.
+namespace pmr {
+
+template<typename K, typename V>
+using flat_hash_map = absl::flat_hash_map<K, V,
+                                          absl::container_internal::hash_default_hash<K>,
+                                          absl::container_internal::hash_default_eq<K>,
+                                          std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+template<typename K>
+using flat_hash_set = absl::flat_hash_set<K,
+                                          absl::container_internal::hash_default_hash<K>,
+                                          absl::container_internal::hash_default_eq<K>,
+                                          std::pmr::polymorphic_allocator<K>>;
+
+}  // namespace pmr
+
+}  // namespace aoc
+
+template<int YEAR, int DAY>
+struct advent {
+  static constexpr int year = YEAR;
+  static constexpr int day = DAY;
+
+  using Result = std::tuple<std::string, std::string>;
+
+  void GetInput(
+      bool example = false, int example_index = 1,
+      aoc::InputMode mode = aoc::InputMode::kMapped) {
+    LoadInput(
+        fmt::format(
+            "./aoc_lib/{}/{:02}/{}.txt", year, day,
+            example ? fmt::format("example{}", example_index) : "input"),
+        mode);
+  }
+
+  // Solves the file at `path` instead of one under aoc_lib/.
+  void LoadInput(const std::string& path, aoc::InputMode mode = aoc::InputMode::kMapped) {
+    input_file.Load(path, mode);
+    input = aoc::TrimInput(input_file.Contents());
+  }
+
+  // Solves `contents` instead of a file under aoc_lib/.
+  void SetInput(std::string contents) {
+    input_file.Assign(std::move(contents));
+    input = aoc::TrimInput(input_file.Contents());
+  }
+
+  void print() {
+    GetInput();
+    const auto [part1, part2] = solve();
+    fmt::print("{}/{:02d} -> Part 1: {:20}\tPart 2: {:20}\n", year, day, part1, part2);
+  }
+
+  // Typed result of parsing `input`, defined by each day next to its solver. It stays opaque
+  // outside the solver's translation unit, so harnesses can hold on to it without its definition.
+  // It may hold views into `input`, so it must not outlive this advent.
+  struct Parsed;
+
+  auto Parse() -> std::shared_ptr<const Parsed>;
+
+  auto Solve(const Parsed& parsed) -> Result;
+
+  auto solve() -> Result {
+    arena.Reset();
+    return Solve(*Parse());
+  }
+
+  // Answers for the loaded input from `cache` when it has them, otherwise solved and stored.
+  auto solve(const aoc::ResultCache& cache, bool* cached = nullptr) -> Result {
+    const std::string key = cache.Key(year, day, input);
+    auto result = cache.Lookup(key);
+    if (cached != nullptr) *cached = result.has_value();
+    if (result) return *std::move(result);
+    result = solve();
+    cache.Store(key, *result);
+    return *std::move(result);
+  }
+
+  auto PartOne() -> std::string;
+
+  auto PartTwo() -> std::string;
+
+  aoc::PhaseTimes& Phases() { return phase_times; }
+
+  // Scratch memory of Solve(), reset by solve(). Whatever Parse() returns must not live in it.
+  aoc::Arena& Scratch() { return arena; }
+
+ private:
+  aoc::ScopedPhase Phase(const std::string_view name) { return {phase_times, name}; }
+
+  aoc::InputFile input_file;
+  std::string_view input;
+  aoc::PhaseTimes phase_times;
+  aoc::Arena arena;
+};
+
+namespace aoc {
+
+struct Pos {
+  i64 i;
+  i64 j;
+  constexpr Pos() : i(0), j(0) {}
+  constexpr Pos(const i64 _i, const i64 _j) : i(_i), j(_j) {}
+  constexpr Pos(const Pos& o) = default;
+  explicit Pos(absl::string_view str) {
+    auto result = scn::scan<i64, i64>(str, "{},{}");
+    CHECK(result) << "Can't parse '" << str << "'.";
+    std::tie(i, j) = result->values();
+  }
+  static Pos FromLinearMap(const i64 index, const i64 width) {
+    auto [i, j] = std::div(index, width + 1);
+    return {i, j};
+  }
+  constexpr bool operator==(const Pos& r) const { return i == r.i && j == r.j; }
+  constexpr Pos operator+(const Pos& r) const { return {i + r.i, j + r.j}; }
+  constexpr Pos operator-(const Pos& r) const { return {i - r.i, j - r.j}; }
+  constexpr Pos operator*(const i64 x) const { return {i * x, j * x}; }
+  constexpr bool operator<(const Pos& r) const { return i < r.i || (i == r.i && j < r.j); }
+  std::string toString() const { return fmt::format("{},{}", i, j); }
+  template<typename H>
+  friend H AbslHashValue(H h, const Pos& p) {
+    return H::combine(std::move(h), p.i, p.j);
+  }
+};
+
+// Pos in four bytes, for maps whose coordinates fit in i16. Sets and maps keyed by it take a
+// quarter of the memory of Pos keys and hash a single u32.
+struct PackedPos {
+  i16 i{0};
+  i16 j{0};
+  constexpr PackedPos() = default;
+  constexpr PackedPos(const i16 _i, const i16 _j) : i(_i), j(_j) {}
+  explicit constexpr PackedPos(const Pos& pos)
+      : i(static_cast<i16>(pos.i)), j(static_cast<i16>(pos.j)) {
+    DCHECK(pos.i == i && pos.j == j) << "Pos " << pos.toString() << " doesn't fit.";
+  }
+  [[nodiscard]] constexpr Pos ToPos() const { return {i, j}; }
+  // Both coordinates as one integer, i in the high half.
+  [[nodiscard]] constexpr u32 Bits() const {
+    return static_cast<u32>(static_cast<u16>(i)) << 16 | static_cast<u16>(j);
+  }
+  constexpr bool operator==(const PackedPos& r) const { return Bits() == r.Bits(); }
+  constexpr PackedPos operator+(const PackedPos& r) const {
+    return {static_cast<i16>(i + r.i), static_cast<i16>(j + r.j)};
+  }
+  constexpr PackedPos operator-(const PackedPos& r) const {
+    return {static_cast<i16>(i - r.i), static_cast<i16>(j - r.j)};
+  }
+  constexpr PackedPos operator*(const i16 x) const {
+    return {static_cast<i16>(i * x), static_cast<i16>(j * x)};
+  }
+  constexpr bool operator<(const PackedPos& r) const { return i < r.i || (i == r.i && j < r.j); }
+  std::string toString() const { return fmt::format("{},{}", i, j); }
+  template<typename H>
+  friend H AbslHashValue(H h, const PackedPos& p) {
+    return H::combine(std::move(h), p.Bits());
+  }
+};
+
+enum class Dir : char {
+  N = '^',
+  E = '>',
+  S = 'v',
+  W = '<',
+};
+inline Dir ParseDir(const char ch) {
+  switch (ch) {
+    case '^': return Dir::N;
+    case '>': return Dir::E;
+    case 'v': return Dir::S;
+    case '<': return Dir::W;
+    default: CHECK(false) << "Unknown Dir representation '" << ch << "'.";
+  }
+  return Dir::N;
+}
+static constexpr std::array kAllDirs{Dir::N, Dir::E, Dir::S, Dir::W};
+
+enum class Dir8 : char {
+  N = '^',
+  NE = '7',
+  E = '>',
+  SE = 'J',
+  S = 'v',
+  SW = 'L',
+  W = '<',
+  NW = 'F',
+};
+static constexpr std::array kAllDir8s{Dir8::N, Dir8::NE, Dir8::E, Dir8::SE,
+                                      Dir8::S, Dir8::SW, Dir8::W, Dir8::NW};
+
+// Position of every Dir in kAllDirs, and of every Dir8 in kAllDir8s, looked up by its character.
+// Turning is then a rotation of the position, so none of the helpers below branch.
+static constexpr auto kDirIndex = [] {
+  std::array<u8, 128> index{};
+  for (u8 d = 0; d < kAllDirs.size(); d++) index[static_cast<u8>(kAllDirs[d])] = d;
+  return index;
+}();
+static constexpr auto kDir8Index = [] {
+  std::array<u8, 128> index{};
+  for (u8 d = 0; d < kAllDir8s.size(); d++) index[static_cast<u8>(kAllDir8s[d])] = d;
+  return index;
+}();
+constexpr u8 DirIndex(const Dir dir) { return kDirIndex[static_cast<u8>(dir) & 0x7F]; }
+constexpr u8 Dir8Index(const Dir8 dir) { return kDir8Index[static_cast<u8>(dir) & 0x7F]; }
+
+// Steps in kAllDirs and kAllDir8s order.
+static constexpr std::array<Pos, 4> kDirMoves{{{-1, 0}, {0, 1}, {1, 0}, {0, -1}}};
+static constexpr std::array<Pos, 8> kDir8Moves{
+    {{-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}}};
+
+constexpr Pos MoveDir(const Dir dir) { return kDirMoves[DirIndex(dir)]; }
+constexpr Dir OppositeDir(const Dir dir) { return kAllDirs[(DirIndex(dir) + 2) & 3]; }
+constexpr Dir TurnLeft(const Dir dir) { return kAllDirs[(DirIndex(dir) + 3) & 3]; }
+constexpr Dir TurnRight(const Dir dir) { return kAllDirs[(DirIndex(dir) + 1) & 3]; }
+constexpr Pos MoveDir8(const Dir8 dir) { return kDir8Moves[Dir8Index(dir)]; }
+
+// Cells of a height x width map, stored contiguously in row-major order and addressed by Pos or
+// by linear index. Rows are Stride() cells apart, so the neighbour of a cell in any direction is
+// a fixed Offset() away. An optional border of sentinel cells surrounds the map, which lets
+// searches read the neighbours of every cell in the map without bounds checks.
+// Grid<const char> can also view a puzzle input in place; the '\n' ending each line then stands
+// in for the eastern border, but there is none to the north or south.
+template<typename T>
+class Grid {
+  static_assert(
+      !std::is_same_v<std::remove_const_t<T>, bool>, "std::vector<bool> cells aren't contiguous.");
+
+  i64 _height{0};
+  i64 _width{0};
+  i64 _border{0};
+  i64 _stride{0};
+  i64 _size{0};
+  std::vector<std::remove_const_t<T>> _cells;
+  // The first cell of the border, or of the map without one. Points into `_cells` unless viewing.
+  T* _data{nullptr};
+
+  // Leaves the map itself filled with `border_fill` too.
+  void Allocate(const i64 height, const i64 width, const i64 border, const T& border_fill) {
+    CHECK(height >= 0 && width >= 0 && border >= 0) << "Invalid grid size.";
+    _height = height;
+    _width = width;
+    _border = border;
+    _stride = width + 2 * border;
+    _size = (height + 2 * border) * _stride;
+    _cells.assign(_size, border_fill);
+    _data = _cells.data();
+  }
+
+ public:
+  Grid() = default;
+  Grid(
+      const i64 height, const i64 width, const T& fill = T{}, const i64 border = 0,
+      const T& border_fill = T{}) {
+    Allocate(height, width, border, border_fill);
+    for (i64 i = 0; i < height; i++) std::fill_n(_data + Index(i, 0), width, fill);
+  }
+  // Maps every character of the lines of `input`, which must all be as long, through `transform`.
+  template<typename F>
+  Grid(const std::string_view input, F&& transform, const i64 border = 0,
+       const T& border_fill = T{}) {
+    const i64 width = static_cast<i64>(std::min(input.find('\n'), input.size()));
+    const i64 height = (static_cast<i64>(input.size()) + 1) / (width + 1);
+    CHECK(height * (width + 1) - 1 == static_cast<i64>(input.size())) << "Ragged grid input.";
+    Allocate(height, width, border, border_fill);
+    // Through locals: stores to char cells could alias the members, forcing reloads.
+    const char* line = input.data();
+    T* row = _data + Index(0, 0);
+    const i64 stride = _stride;
+    for (i64 i = 0; i < height; i++, line += width + 1, row += stride) {
+      for (i64 j = 0; j < width; j++) row[j] = transform(line[j]);
+    }
+  }
+  // Views `input` without copying it, so it must outlive the grid. Every line, the last one too,
+  // must end in '\n': those are the eastern border, so a step east from any cell stays in the view.
+  // There's no border north or south, so steps that way need Contains() first.
+  explicit Grid(const std::string_view input)
+    requires std::is_same_v<T, const char>
+  {
+    CHECK(!input.empty() && input.back() == '\n') << "Grid views need the trailing '\\n'.";
+    _width = static_cast<i64>(input.find('\n'));
+    _height = static_cast<i64>(input.size()) / (_width + 1);
+    CHECK(_height * (_width + 1) == static_cast<i64>(input.size())) << "Ragged grid input.";
+    _stride = _width + 1;
+    _size = static_cast<i64>(input.size());
+    _data = input.data();
+  }
+  Grid(const Grid& o)
+      : _height(o._height), _width(o._width), _border(o._border), _stride(o._stride),
+        _size(o._size), _cells(o._cells), _data(o._cells.empty() ? o._data : _cells.data()) {}
+  // Moving a vector keeps its buffer, so `_data` stays valid.
+  Grid(Grid&& o) = default;
+  Grid& operator=(Grid o) {
+    std::swap(_height, o._height);
+    std::swap(_width, o._width);
+    std::swap(_border, o._border);
+    std::swap(_stride, o._stride);
+    std::swap(_size, o._size);
+    std::swap(_cells, o._cells);
+    std::swap(_data, o._data);
+    return *this;
+  }
+
+  [[nodiscard]] i64 Height() const { return _height; }
+  [[nodiscard]] i64 Width() const { return _width; }
+  [[nodiscard]] i64 Border() const { return _border; }
+  [[nodiscard]] i64 Stride() const { return _stride; }
+  // Number of linear indices, border included.
+  [[nodiscard]] i64 Size() const { return _size; }
+
+  [[nodiscard]] i64 Index(const i64 i, const i64 j) const {
+    return (i + _border) * _stride + j + _border;
+  }
+  [[nodiscard]] i64 Index(const Pos& pos) const { return Index(pos.i, pos.j); }
+  [[nodiscard]] Pos ToPos(const i64 index) const {
+    return {index / _stride - _border, index % _stride - _border};
+  }
+  // Whether `pos` is in the map proper, not its border.
+  [[nodiscard]] bool Contains(const Pos& pos) const {
+    return pos.i >= 0 && pos.i < _height && pos.j >= 0 && pos.j < _width;
+  }
+
+  // Linear index change of one step in `dir`.
+  [[nodiscard]] i64 Offset(const Dir dir) const {
+    const Pos move = MoveDir(dir);
+    return move.i * _stride + move.j;
+  }
+  [[nodiscard]] i64 Offset(const Dir8 dir) const {
+    const Pos move = MoveDir8(dir);
+    return move.i * _stride + move.j;
+  }
+  // Offsets of every direction, in kAllDirs order.
+  [[nodiscard]] std::array<i64, 4> Offsets() const { return {-_stride, 1, _stride, -1}; }
+  // Offsets of every direction, in kAllDir8s order.
+  [[nodiscard]] std::array<i64, 8> Offsets8() const {
+    return {-_stride, 1 - _stride, 1, _stride + 1, _stride, _stride - 1, -1, -_stride - 1};
+  }
+
+  T& operator[](const i64 index) { return _data[index]; }
+  const T& operator[](const i64 index) const { return _data[index]; }
+  T& operator[](const Pos& pos) { return _data[Index(pos)]; }
+  const T& operator[](const Pos& pos) const { return _data[Index(pos)]; }
+
+  // Cells of row `i` of the map, without the border.
+  [[nodiscard]] std::span<T> Row(const i64 i) {
+    return {_data + Index(i, 0), static_cast<size_t>(_width)};
+  }
+  [[nodiscard]] std::span<const T> Row(const i64 i) const {
+    return {_data + Index(i, 0), static_cast<size_t>(_width)};
+  }
+
+  // Linear index of the first cell, border included, that holds `value`, or -1.
+  [[nodiscard]] i64 Find(const T& value) const {
+    const T* found = std::find(_data, _data + _size, value);
+    return found == _data + _size ? -1 : found - _data;
+  }
+};
+
+// Set of (linear index, direction) pairs of a Grid of `size` cells, a bit each. Words of 64 bits
+// carry the epoch they were last written in and read as empty in any other, so Clear() is O(1)
+// and the set can be reused by repeated searches on the same map. A narrower `Epoch` saves memory
+// at the cost of a real reset every time it wraps around.
+template<u32 NDirs = 1, std::unsigned_integral Epoch = u32>
+class GridBitset {
+  std::vector<u64> _words;
+  std::vector<Epoch> _epochs;
+  Epoch _epoch{1};
+  i64 _count{0};
+
+  [[nodiscard]] static i64 Key(const i64 index, const u32 dir) { return index * NDirs + dir; }
+
+ public:
+  GridBitset() = default;
+  explicit GridBitset(const i64 size)
+      : _words((size * NDirs + 63) / 64, 0), _epochs(_words.size(), 0) {}
+
+  [[nodiscard]] bool Contains(const i64 index, const u32 dir = 0) const {
+    const i64 key = Key(index, dir);
+    return _epochs[key >> 6] == _epoch && (_words[key >> 6] >> (key & 63) & 1);
+  }
+  // Adds the pair and returns whether it was missing, like the `second` of a set's insert.
+  bool Insert(const i64 index, const u32 dir = 0) {
+    const i64 key = Key(index, dir);
+    u64& word = _words[key >> 6];
+    if (_epochs[key >> 6] != _epoch) {
+      _epochs[key >> 6] = _epoch;
+      word = 0;
+    }
+    const u64 bit = u64{1} << (key & 63);
+    if (word & bit) return false;
+    word |= bit;
+    _count++;
+    return true;
+  }
+  void Erase(const i64 index, const u32 dir = 0) {
+    if (!Contains(index, dir)) return;
+    const i64 key = Key(index, dir);
+    _words[key >> 6] &= ~(u64{1} << (key & 63));
+    _count--;
+  }
+  bool Contains(const i64 index, const Dir dir) const
+    requires(NDirs == 4)
+  {
+    return Contains(index, DirIndex(dir));
+  }
+  bool Insert(const i64 index, const Dir dir)
+    requires(NDirs == 4)
+  {
+    return Insert(index, DirIndex(dir));
+  }
+  void Erase(const i64 index, const Dir dir)
+    requires(NDirs == 4)
+  {
+    Erase(index, DirIndex(dir));
+  }
+
+  // Number of pairs in the set.
+  [[nodiscard]] i64 Count() const { return _count; }
+  void Clear() {
+    _count = 0;
+    if (++_epoch != 0) return;
+    // Once the epochs wrap around, the ones left over from before have to be reset for real.
+    absl::c_fill(_epochs, 0);
+    _epoch = 1;
+  }
+};
+
+// A `T` for every (linear index, direction) pair of a Grid of `size` cells, default constructed
+// until first written. Like GridBitset, it's cleared in O(1) by moving on to a new epoch.
+template<typename T, u32 NDirs = 1, std::unsigned_integral Epoch = u32>
+class GridStateArray {
+  std::vector<T> _values;
+  std::vector<Epoch> _epochs;
+  Epoch _epoch{1};
+
+  [[nodiscard]] static i64 Key(const i64 index, const u32 dir) { return index * NDirs + dir; }
+
+ public:
+  GridStateArray() = default;
+  explicit GridStateArray(const i64 size) : _values(size * NDirs), _epochs(size * NDirs, 0) {}
+
+  [[nodiscard]] bool Contains(const i64 index, const u32 dir = 0) const {
+    return _epochs[Key(index, dir)] == _epoch;
+  }
+  // The value of the pair, or nullptr if it hasn't been written since the last Clear().
+  [[nodiscard]] const T* Find(const i64 index, const u32 dir = 0) const {
+    const i64 key = Key(index, dir);
+    return _epochs[key] == _epoch ? &_values[key] : nullptr;
+  }
+  // The value of the pair, reset to T{} first if it hasn't been written since the last Clear().
+  T& operator()(const i64 index, const u32 dir = 0) {
+    const i64 key = Key(index, dir);
+    if (_epochs[key] != _epoch) {
+      _epochs[key] = _epoch;
+      _values[key] = T{};
+    }
+    return _values[key];
+  }
+  bool Contains(const i64 index, const Dir dir) const
+    requires(NDirs == 4)
+  {
+    return Contains(index, DirIndex(dir));
+  }
+  const T* Find(const i64 index, const Dir dir) const
+    requires(NDirs == 4)
+  {
+    return Find(index, DirIndex(dir));
+  }
+  T& operator()(const i64 index, const Dir dir)
+    requires(NDirs == 4)
+  {
+    return (*this)(index, DirIndex(dir));
+  }
+
+  // Number of grid cells, as given to the constructor.
+  [[nodiscard]] i64 Size() const { return static_cast<i64>(_values.size() / NDirs); }
+  void Clear() {
+    if (++_epoch != 0) return;
+    absl::c_fill(_epochs, 0);
+    _epoch = 1;
+  }
+};
+
+template<typename T1, typename T2>
+auto result(T1 t1, T2 t2) -> std::tuple<std::string, std::string> {
+  return std::tuple{fmt::format("{}", t1), fmt::format("{}", t2)};
+}
+
+template<typename E>
+auto ToUnderlying(E e) {
+  return static_cast<std::underlying_type_t<E>>(e);
+}
+
+inline i32 signum(const i32 val) { return (0 < val) - (val < 0); }
+
+static constexpr std::array<u64, 20> kTenPowers{
+    1u,
+    10u,
+    100u,
+    1'000u,
+    10'000u,
+    100'000u,
+    1'000'000u,
+    10'000'000u,
+    100'000'000u,
+    1'000'000'000u,
+    10'000'000'000u,
+    100'000'000'000u,
+    1'000'000'000'000u,
+    10'000'000'000'000u,
+    100'000'000'000'000u,
+    1'000'000'000'000'000u,
+    10'000'000'000'000'000u,
+    100'000'000'000'000'000u,
+    1'000'000'000'000'000'000u,
+    10'000'000'000'000'000'000u};
+
+namespace util {
+
+inline bool IsInMap(const u64 height, const u64 width, const Pos& pos) {
+  return pos.i >= 0 && pos.i < height && pos.j >= 0 && pos.j < width;
+}
+inline bool IsOutOfMap(const u64 height, const u64 width, const Pos& pos) {
+  return pos.i < 0 || pos.i >= height || pos.j < 0 || pos.j >= width;
+}
+
+template<typename T>
+void ScanList(
+    const absl::string_view input, std::vector<T>& list, const absl::string_view separator = " ") {
+  absl::c_transform(absl::StrSplit(input, separator), std::back_inserter(list), [](auto token) {
+    auto result = scn::scan<T>(token, "{}");
+    CHECK(result) << "Can't parse token '" << token << "'.";
+    return result->value();
+  });
+}
+template<typename T, std::ranges::contiguous_range R>
+void FastScanList(R&& input, std::vector<T>& list, std::string_view delimiter = " ") {
+  for (auto subrange :
+       input | std::views::split(delimiter) |
+           std::views::filter([](const auto& subrange) { return !subrange.empty(); })) {
+    T x;
+    auto result = fast_float::from_chars(
+        std::ranges::data(subrange), std::ranges::data(subrange) + std::ranges::size(subrange), x);
+    CHECK(result.ec == std::errc()) << "Couldn't parse '" << std::ranges::data(subrange) << "'.";
+    list.push_back(x);
+  }
+}
+// Eight bytes starting at `ptr`, the first in the lowest byte. Bytes at or past `end` read as zero.
+inline u64 LoadEightBytes(const char* ptr, const char* end) {
+  u64 chunk = 0;
+  if (end - ptr >= static_cast<std::ptrdiff_t>(sizeof(u64))) {
+    std::memcpy(&chunk, ptr, sizeof(u64));
+  } else {
+    std::memcpy(&chunk, ptr, end - ptr);
+  }
+  return chunk;
+}
+
+// Number of leading bytes of `chunk` (loaded by LoadEightBytes) that are ASCII digits. A byte's
+// carry out of the +6 can only corrupt later bytes, so the first non-digit is always found.
+inline u32 CountLeadingDigits(const u64 chunk) {
+  const u64 high = chunk & 0xF0F0F0F0F0F0F0F0;
+  const u64 low = ((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4;
+  return std::countr_zero((high | low) ^ 0x3333333333333333) / 8;
+}
+
+// Value of the first `len` (1 to 8) digits of `chunk`, combining digit pairs, then quads, then
+// octets in three multiplies (SWAR: SIMD within a register).
+inline u64 ParseLeadingDigits(u64 chunk, const u32 len) {
+  chunk = (chunk - 0x3030303030303030) << (8 * (8 - len));
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+  chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+  return (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFF;
+}
+
+// Parses every integer of `input` into `list`. Numbers are separated by runs of `separator`; signed
+// types also accept a leading '-'. The output is sized up front from a count of separators and
+// written through a pointer, and digits are converted eight at a time. i128 and u128 accumulate in
+// a u128, every other type in a u64.
+template<std::integral T, std::ranges::contiguous_range R>
+void FasterScanList(R&& input, std::vector<T>& list, const char separator = ' ') {
+  static_assert(std::endian::native == std::endian::little, "SWAR parsing assumes little endian.");
+  using Wide = std::conditional_t<(sizeof(T) > sizeof(u64)), u128, u64>;
+  const char* ptr = std::ranges::data(input);
+  const char* const end = ptr + std::ranges::size(input);
+  const std::size_t first = list.size();
+  list.resize(first + std::count(ptr, end, separator) + 1);
+  T* out = list.data() + first;
+  while (true) {
+    while (ptr < end && *ptr == separator) ptr++;
+    if (ptr == end) break;
+    const char* const number = ptr;
+    const bool negative = std::is_signed_v<T> && *ptr == '-';
+    if (negative) ptr++;
+    const char* const digits = ptr;
+    u64 chunk = LoadEightBytes(ptr, end);
+    u32 len = CountLeadingDigits(chunk);
+    Wide value = len > 0 ? ParseLeadingDigits(chunk, len) : 0;
+    ptr += len;
+    // Only numbers longer than eight digits loop, and only those can overflow.
+    bool overflow = false;
+    while (len == 8 && ptr < end) {
+      chunk = LoadEightBytes(ptr, end);
+      len = CountLeadingDigits(chunk);
+      if (len > 0) {
+        overflow |= __builtin_mul_overflow(value, kTenPowers[len], &value);
+        overflow |= __builtin_add_overflow(value, ParseLeadingDigits(chunk, len), &value);
+      }
+      ptr += len;
+    }
+    const std::string_view token(number, ptr - number);
+    CHECK(ptr > digits && (ptr == end || *ptr == separator)) << "Couldn't parse '" << token << "'.";
+    const Wide max = static_cast<Wide>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    CHECK(!overflow && value <= max) << "Out of range '" << token << "'.";
+    *out++ = negative ? static_cast<T>(0 - value) : static_cast<T>(value);
+  }
+  list.resize(out - list.data());
+}
+
+// Start of the first `separator` in [first, last), or `last` if there is none. memchr finds the
+// candidates; the C library vectorizes it, so long lines are skipped a register at a time.
+inline const char* FindSeparator(
+    const char* first, const char* last, const std::string_view separator) {
+  if (separator.size() == 1) {
+    const void* found = std::memchr(first, separator[0], last - first);
+    return found != nullptr ? static_cast<const char*>(found) : last;
+  }
+  while (last - first >= static_cast<std::ptrdiff_t>(separator.size())) {
+    const auto* found = static_cast<const char*>(
+        std::memchr(first, separator[0], last - first - separator.size() + 1));
+    if (found == nullptr) break;
+    if (std::memcmp(found + 1, separator.data() + 1, separator.size() - 1) == 0) return found;
+    first = found + 1;
+  }
+  return last;
+}
+
+// The tokens of `input` between `separator`s, found lazily as the range is iterated and yielded
+// as views into `input`, so nothing is allocated. Like absl::SkipWhitespace, tokens made only of
+// whitespace are skipped.
+class Tokens : public std::ranges::view_interface<Tokens> {
+ public:
+  class Iterator {
+   public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::forward_iterator_tag;
+
+    Iterator() = default;
+    Iterator(const std::string_view input, const std::string_view separator)
+        : _next(input.data()), _last(input.data() + input.size()), _separator(separator),
+          _done(false) {
+      Advance();
+    }
+
+    std::string_view operator*() const { return _token; }
+    Iterator& operator++() {
+      Advance();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it = *this;
+      Advance();
+      return it;
+    }
+    bool operator==(const Iterator& o) const {
+      return _done == o._done && (_done || _token.data() == o._token.data());
+    }
+    bool operator==(std::default_sentinel_t) const { return _done; }
+
+   private:
+    void Advance() {
+      while (_next != nullptr) {
+        const char* found = FindSeparator(_next, _last, _separator);
+        _token = std::string_view(_next, found - _next);
+        _next = found == _last ? nullptr : found + _separator.size();
+        if (!absl::c_all_of(_token, absl::ascii_isspace)) return;
+      }
+      _done = true;
+    }
+
+    const char* _next{nullptr};
+    const char* _last{nullptr};
+    std::string_view _separator;
+    std::string_view _token;
+    bool _done{true};
+  };
+
+  Tokens() = default;
+  explicit Tokens(const std::string_view input, const std::string_view separator = "\n")
+      : _input(input), _separator(separator) {
+    CHECK(!separator.empty()) << "Can't split at an empty separator.";
+  }
+
+  [[nodiscard]] Iterator begin() const { return {_input, _separator}; }
+  [[nodiscard]] std::default_sentinel_t end() const { return {}; }
+
+ private:
+  std::string_view _input;
+  std::string_view _separator;
+};
+
+// Transforms every token of `input` in a single pass over it, without materialising the tokens.
+template<typename T, typename F>
+std::vector<T> TokenizeInput(
+    const absl::string_view input, F&& transform, const absl::string_view separator = "\n") {
+  std::vector<T> result;
+  for (const std::string_view token : Tokens(input, separator)) result.push_back(transform(token));
+  return result;
+}
+
+// a + b and a * b, or std::nullopt if the result doesn't fit in T. Both compile to the operation
+// and a branch on the overflow flag, so they're cheap enough for inner loops.
+template<typename T>
+constexpr std::optional<T> CheckedAdd(const T a, const T b) {
+  T result;
+  if (__builtin_add_overflow(a, b, &result)) return std::nullopt;
+  return result;
+}
+
+template<typename T>
+constexpr std::optional<T> CheckedMul(const T a, const T b) {
+  T result;
+  if (__builtin_mul_overflow(a, b, &result)) return std::nullopt;
+  return result;
+}
+
+// Least common multiple of `values`, folded pairwise as a / gcd(a, b) * b, so it needs neither a
+// sieve nor a factorization. For primes and factors, see aoc_primes.h.
+template<typename Range>
+auto LCM(const Range& values) {
+  using T = std::ranges::range_value_t<Range>;
+  T lcm = 1;
+  for (const T value : values) {
+    const std::optional<T> multiple = CheckedMul<T>(lcm / std::gcd(lcm, value), value);
+    CHECK(multiple.has_value()) << "The LCM overflows.";
+    lcm = *multiple;
+  }
+  return lcm;
+}
+
+// The number of decimal digits of `x`, 1 for 0. floor(log10(x)) is floor(bit_width(x) * log10(2))
+// or one more, and 1233 / 4096 is log10(2) to enough places for 64 bits: kTenPowers settles which.
+// Unsigned only, so a negative value must be cast by the caller instead of counting as 2^64 - |x|.
+template<typename T>
+  requires(std::unsigned_integral<T> || std::same_as<T, u128>)
+constexpr u32 NumDigits(const T x) {
+  if constexpr (sizeof(T) > sizeof(u64)) {
+    if (static_cast<u64>(x >> 64) == 0) return NumDigits(static_cast<u64>(x));
+    return 19 + NumDigits(x / kTenPowers[19]);
+  } else {
+    const u64 value = static_cast<u64>(x) | 1;
+    const u32 guess = (std::bit_width(value) * 1233) >> 12;
+    return guess + (value >= kTenPowers[guess]);
+  }
+}
+
+// The number of set bits of `x`. Without the popcnt instruction (x86-64 below -march=x86-64-v2)
+// std::popcount is a libgcc call, slower than counting the bits in place.
+template<typename T>
+constexpr u32 NumBits(const T x) {
+  if constexpr (sizeof(T) > sizeof(u64)) {
+    return NumBits(static_cast<u64>(x)) + NumBits(static_cast<u64>(x >> 64));
+  } else {
+    const u64 value = static_cast<std::make_unsigned_t<T>>(x);
+#if defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__))
+    return std::popcount(value);
+#else
+    u64 count = value - ((value >> 1) & 0x5555555555555555);
+    count = ((count >> 2) & 0x3333333333333333) + (count & 0x3333333333333333);
+    count = ((count >> 4) + count) & 0x0F0F0F0F0F0F0F0F;
+    return (count * 0x0101010101010101) >> 56;
+#endif
+  }
+}
+
+}  // namespace util
+
+}  // namespace aoc
+
+namespace fmt {
+
+template<>
+struct formatter<aoc::Dir> : formatter<char> {
+  auto format(const aoc::Dir dir, format_context& ctx) const {
+    return formatter<char>::format(aoc::ToUnderlying(dir), ctx);
+  }
+};
+template<>
+struct formatter<aoc::Dir8> : formatter<char> {
+  auto format(const aoc::Dir8 dir, format_context& ctx) const {
+    return formatter<char>::format(aoc::ToUnderlying(dir), ctx);
+  }
+};
+
+template<>
+struct formatter<aoc::Pos> : formatter<string_view> {
+  auto format(const aoc::Pos& p, format_context& ctx) const {
+    return formatter<string_view>::format(fmt::format("[{}, {}]", p.i, p.j), ctx);
+  }
+};
+
+// The rows of the map, without the border.
+template<typename T>
+struct formatter<aoc::Grid<T>> : formatter<string_view> {
+  auto format(const aoc::Grid<T>& grid, format_context& ctx) const {
+    std::string rows;
+    for (i64 i = 0; i < grid.Height(); i++) {
+      if (i > 0) rows += '\n';
+      rows += fmt::format("{}", join(grid.Row(i), ""));
+    }
+    return formatter<string_view>::format(rows, ctx);
+  }
+};
+
+}  // namespace fmt
+
+#endif  // ADVENTOFCODE_AOC_CORE_HPP
@@ -0,0 +1,174 @@
+#include "aoc_graph.h"
+
+#include <atomic>
+#include <numeric>
+
+namespace aoc {
+
+namespace {
+
+// Beamer et al.'s thresholds: go bottom-up once the frontier has more than 1/kAlpha of the arcs
+// out of unvisited nodes, and back top-down once it has fewer than 1/kBeta of the nodes.
+constexpr u64 kAlpha = 14;
+constexpr u64 kBeta = 24;
+// Frontier entries or nodes per parallel chunk. Levels smaller than this are a single chunk, run
+// on the calling thread, so small graphs never wait on the pool.
+constexpr i64 kGrain = 4096;
+
+// The nodes and arcs a BFS level found.
+struct Level {
+  u64 nodes{0};
+  u64 arcs{0};
+};
+
+CsrGraph Transposed(const CsrGraph& graph) {
+  std::vector<std::pair<u32, u32>> arcs;
+  arcs.reserve(graph.NumArcs());
+  for (u32 from = 0; from < graph.NumNodes(); from++) {
+    for (const u32 to : graph.Neighbors(from)) arcs.emplace_back(to, from);
+  }
+  return {graph.NumNodes(), arcs};
+}
+
+u32 FindRoot(std::vector<u32>& parent, u32 node) {
+  while (parent[node] != node) {
+    parent[node] = parent[parent[node]];
+    node = parent[node];
+  }
+  return node;
+}
+
+}  // namespace
+
+std::vector<u32> BfsDistances(parallel::ThreadPool& pool, const CsrGraph& graph, const u32 source) {
+  const u32 num_nodes = graph.NumNodes();
+  std::vector<u32> distances(num_nodes, CsrGraph::kUnreachable);
+  distances[source] = 0;
+  // Where bottom-up levels look for parents: the graph itself if its arcs go both ways.
+  std::optional<CsrGraph> transposed;
+  const CsrGraph* parents = &graph;
+
+  // The frontier is a list of nodes while top-down, and a flag per node while bottom-up.
+  std::vector<u32> frontier{source};
+  std::vector<u8> in_frontier, in_next;
+  bool bottom_up = false;
+  Level level{1, graph.Degree(source)};
+  u64 unexplored_arcs = graph.NumArcs() - level.arcs;
+
+  for (u32 depth = 1; level.nodes > 0; depth++) {
+    if (!bottom_up && level.arcs > unexplored_arcs / kAlpha) {
+      bottom_up = true;
+      in_frontier.assign(num_nodes, 0);
+      for (const u32 node : frontier) in_frontier[node] = 1;
+      if (!graph.IsSymmetric() && !transposed) parents = &transposed.emplace(Transposed(graph));
+    } else if (bottom_up && level.nodes < num_nodes / kBeta) {
+      bottom_up = false;
+      frontier.clear();
+      for (u32 node = 0; node < num_nodes; node++) {
+        if (in_frontier[node]) frontier.push_back(node);
+      }
+    }
+
+    if (bottom_up) {
+      // Every chunk only writes the distances and flags of its own nodes.
+      in_next.assign(num_nodes, 0);
+      level = parallel::ParallelReduce(
+          pool, num_nodes, kGrain, Level{},
+          [&](const i64 begin, const i64 end) {
+            Level found;
+            for (i64 node = begin; node < end; node++) {
+              if (distances[node] != CsrGraph::kUnreachable) continue;
+              for (const u32 parent : parents->Neighbors(node)) {
+                if (!in_frontier[parent]) continue;
+                distances[node] = depth;
+                in_next[node] = 1;
+                found.nodes++;
+                found.arcs += graph.Degree(node);
+                break;
+              }
+            }
+            return found;
+          },
+          [](const Level a, const Level b) { return Level{a.nodes + b.nodes, a.arcs + b.arcs}; });
+      in_frontier.swap(in_next);
+    } else {
+      frontier = parallel::ParallelReduce(
+          pool, static_cast<i64>(frontier.size()), kGrain, std::vector<u32>{},
+          [&](const i64 begin, const i64 end) {
+            std::vector<u32> found;
+            for (i64 i = begin; i < end; i++) {
+              for (const u32 next : graph.Neighbors(frontier[i])) {
+                std::atomic_ref<u32> distance(distances[next]);
+                u32 unreached = CsrGraph::kUnreachable;
+                if (distance.load(std::memory_order_relaxed) == unreached &&
+                    distance.compare_exchange_strong(unreached, depth, std::memory_order_relaxed)) {
+                  found.push_back(next);
+                }
+              }
+            }
+            return found;
+          },
+          [](std::vector<u32> a, const std::vector<u32>& b) {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+          });
+      level = {frontier.size(), 0};
+      for (const u32 node : frontier) level.arcs += graph.Degree(node);
+    }
+    unexplored_arcs -= level.arcs;
+  }
+  return distances;
+}
+
+std::vector<u32> BfsDistances(const CsrGraph& graph, const u32 source) {
+  return BfsDistances(parallel::DefaultPool(), graph, source);
+}
+
+Components ConnectedComponents(const CsrGraph& graph) {
+  const u32 num_nodes = graph.NumNodes();
+  std::vector<u32> parent(num_nodes);
+  std::iota(parent.begin(), parent.end(), 0);
+  for (u32 from = 0; from < num_nodes; from++) {
+    for (const u32 to : graph.Neighbors(from)) {
+      const u32 a = FindRoot(parent, from), b = FindRoot(parent, to);
+      // The smaller root wins, so every root is the smallest node of its component.
+      if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    }
+  }
+
+  Components components{std::vector<u32>(num_nodes), {}};
+  for (u32 node = 0; node < num_nodes; node++) {
+    const u32 root = FindRoot(parent, node);
+    if (root == node) {
+      components.of[node] = static_cast<u32>(components.sizes.size());
+      components.sizes.push_back(0);
+    } else {
+      components.of[node] = components.of[root];
+    }
+    components.sizes[components.of[node]]++;
+  }
+  return components;
+}
+
+std::optional<std::vector<u32>> TopologicalOrder(const CsrGraph& graph) {
+  const u32 num_nodes = graph.NumNodes();
+  std::vector<u32> in_degree(num_nodes, 0);
+  for (u32 from = 0; from < num_nodes; from++) {
+    for (const u32 to : graph.Neighbors(from)) in_degree[to]++;
+  }
+  // Nodes are appended once all their predecessors are, and the order doubles as the queue.
+  std::vector<u32> order;
+  order.reserve(num_nodes);
+  for (u32 node = 0; node < num_nodes; node++) {
+    if (in_degree[node] == 0) order.push_back(node);
+  }
+  for (u32 head = 0; head < order.size(); head++) {
+    for (const u32 to : graph.Neighbors(order[head])) {
+      if (--in_degree[to] == 0) order.push_back(to);
+    }
+  }
+  if (order.size() != num_nodes) return std::nullopt;
+  return order;
+}
+
+}  // namespace aoc
@@ -0,0 +1,217 @@
+#ifndef ADVENTOFCODE_AOC_GRAPH_HPP
+#define ADVENTOFCODE_AOC_GRAPH_HPP
+
+#include "aoc_core.h"
+#include "aoc_parallel.h"
+
+#include <array>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Numbers the names of a puzzle's nodes densely from 0, in order of first appearance, so graphs
+// keyed by names can live in vectors indexed by id. The names are views, usually into the input,
+// and must outlive the interner.
+//
+// Names of 1 to 3 letters of one case ("aaa", "rx", "ZZZ") are the usual AoC ids and skip hashing:
+// read as base-27 numbers with 0 for a missing letter they're a perfect hash into a 27^3 table per
+// case, allocated on first use. Any other name goes through a hash map.
+class Interner {
+ public:
+  static constexpr u32 kNotFound = std::numeric_limits<u32>::max();
+
+  // The id of `name`, numbering it first if it's new.
+  u32 Intern(const std::string_view name) {
+    if (const auto [table, key] = ShortKey(name); table < _short.size()) {
+      if (_short[table].empty()) _short[table].resize(kShortKeys, kNotFound);
+      u32& id = _short[table][key];
+      if (id == kNotFound) {
+        id = Size();
+        _names.push_back(name);
+      }
+      return id;
+    }
+    const auto [it, inserted] = _long.try_emplace(name, Size());
+    if (inserted) _names.push_back(name);
+    return it->second;
+  }
+
+  // The id of `name`, or kNotFound if it was never interned.
+  [[nodiscard]] u32 Find(const std::string_view name) const {
+    if (const auto [table, key] = ShortKey(name); table < _short.size()) {
+      return _short[table].empty() ? kNotFound : _short[table][key];
+    }
+    const auto it = _long.find(name);
+    return it == _long.end() ? kNotFound : it->second;
+  }
+
+  [[nodiscard]] std::string_view Name(const u32 id) const { return _names[id]; }
+  [[nodiscard]] const std::vector<std::string_view>& Names() const { return _names; }
+  [[nodiscard]] u32 Size() const { return static_cast<u32>(_names.size()); }
+
+ private:
+  static constexpr u32 kShortKeys = 27 * 27 * 27;
+
+  // The table (0 for lower case, 1 for upper case) and key of a short name, or table 2 for any
+  // other name.
+  static std::pair<u32, u32> ShortKey(const std::string_view name) {
+    if (name.empty() || name.size() > 3) return {2, 0};
+    const char base = name[0] >= 'a' ? 'a' : 'A';
+    u32 key = 0;
+    for (const char c : name) {
+      const u32 letter = static_cast<u8>(c - base);
+      if (letter >= 26) return {2, 0};
+      key = key * 27 + letter + 1;
+    }
+    return {base == 'A', key};
+  }
+
+  std::vector<std::string_view> _names;
+  std::array<std::vector<u32>, 2> _short;
+  absl::flat_hash_map<std::string_view, u32> _long;
+};
+
+// The adjacency lists of nodes 0 to NumNodes() - 1 packed into two arrays, compressed sparse row
+// style: the neighbours of `node` are _targets[_offsets[node]] to _targets[_offsets[node + 1] - 1].
+// Built once, by a counting sort of the arcs, and read-only after that.
+class CsrGraph {
+ public:
+  static constexpr u32 kUnreachable = std::numeric_limits<u32>::max();
+
+  CsrGraph() = default;
+  // The graph with an arc `from` -> `to` for every pair in `arcs`. A node's neighbours keep the
+  // order of its arcs.
+  CsrGraph(const u32 num_nodes, const std::span<const std::pair<u32, u32>> arcs) {
+    Build(num_nodes, arcs, [](u64, u32) {});
+  }
+
+  // The graph with arcs both ways for every pair in `edges`.
+  static CsrGraph Undirected(
+      const u32 num_nodes, const std::span<const std::pair<u32, u32>> edges) {
+    CsrGraph graph(num_nodes, BothWays(edges));
+    graph._symmetric = true;
+    return graph;
+  }
+
+  // The graph with the arcs for which `keep(from, to)` holds. On an undirected graph `keep` must
+  // treat both ways of an edge alike.
+  template<typename Keep>
+  [[nodiscard]] CsrGraph Subgraph(Keep&& keep) const {
+    std::vector<std::pair<u32, u32>> arcs;
+    arcs.reserve(NumArcs());
+    for (u32 from = 0; from < NumNodes(); from++) {
+      for (const u32 to : Neighbors(from)) {
+        if (keep(from, to)) arcs.emplace_back(from, to);
+      }
+    }
+    CsrGraph graph(NumNodes(), arcs);
+    graph._symmetric = _symmetric;
+    return graph;
+  }
+
+  [[nodiscard]] u32 NumNodes() const { return static_cast<u32>(_offsets.size() - 1); }
+  [[nodiscard]] u32 NumArcs() const { return static_cast<u32>(_targets.size()); }
+  [[nodiscard]] u32 Degree(const u32 node) const { return _offsets[node + 1] - _offsets[node]; }
+  [[nodiscard]] std::span<const u32> Neighbors(const u32 node) const {
+    return {_targets.data() + _offsets[node], _targets.data() + _offsets[node + 1]};
+  }
+  // Whether every arc has its reverse, as for graphs built by Undirected().
+  [[nodiscard]] bool IsSymmetric() const { return _symmetric; }
+
+ protected:
+  // Counting-sorts `arcs`, anything with the source and target as elements 0 and 1, and calls
+  // `place(index, slot)` with the slot in _targets each of them lands in.
+  template<typename Arc, typename Place>
+  void Build(const u32 num_nodes, const std::span<const Arc> arcs, Place&& place) {
+    _offsets.assign(num_nodes + 1, 0);
+    _targets.resize(arcs.size());
+    for (const Arc& arc : arcs) {
+      DCHECK(std::get<0>(arc) < num_nodes && std::get<1>(arc) < num_nodes)
+          << "Arc " << std::get<0>(arc) << " -> " << std::get<1>(arc) << " is out of range.";
+      _offsets[std::get<0>(arc) + 1]++;
+    }
+    for (u32 node = 0; node < num_nodes; node++) _offsets[node + 1] += _offsets[node];
+    std::vector<u32> next(_offsets.begin(), _offsets.end() - 1);
+    for (u64 index = 0; index < arcs.size(); index++) {
+      const u32 slot = next[std::get<0>(arcs[index])]++;
+      _targets[slot] = std::get<1>(arcs[index]);
+      place(index, slot);
+    }
+  }
+
+  template<typename Arc>
+  static std::vector<Arc> BothWays(const std::span<const Arc> edges) {
+    std::vector<Arc> arcs;
+    arcs.reserve(2 * edges.size());
+    for (Arc edge : edges) {
+      arcs.push_back(edge);
+      std::swap(std::get<0>(edge), std::get<1>(edge));
+      arcs.push_back(edge);
+    }
+    return arcs;
+  }
+
+  std::vector<u32> _offsets{0};
+  std::vector<u32> _targets;
+  bool _symmetric{false};
+};
+
+// A CsrGraph with a `Weight` on every arc, kept in a third array beside _targets.
+template<typename Weight>
+class WeightedCsrGraph : public CsrGraph {
+  std::vector<Weight> _weights;
+
+ public:
+  using Arc = std::tuple<u32, u32, Weight>;
+
+  WeightedCsrGraph() = default;
+  WeightedCsrGraph(const u32 num_nodes, const std::span<const Arc> arcs) : _weights(arcs.size()) {
+    Build(num_nodes, arcs, [&](const u64 index, const u32 slot) {
+      _weights[slot] = std::get<2>(arcs[index]);
+    });
+  }
+
+  static WeightedCsrGraph Undirected(const u32 num_nodes, const std::span<const Arc> edges) {
+    WeightedCsrGraph graph(num_nodes, BothWays(edges));
+    graph._symmetric = true;
+    return graph;
+  }
+
+  // The weights of the arcs to Neighbors(node), in the same order.
+  [[nodiscard]] std::span<const Weight> Weights(const u32 node) const {
+    return {_weights.data() + _offsets[node], _weights.data() + _offsets[node + 1]};
+  }
+};
+
+// The number of arcs from `source` to every node, or CsrGraph::kUnreachable. Direction-optimizing
+// (Beamer et al.): while the frontier is small each level expands it top-down, claiming
+// neighbours with a compare-and-swap; once its arcs outnumber a fraction of the unvisited nodes'
+// arcs, each unvisited node looks for a parent in the frontier instead, bottom-up, and stops at
+// the first. Large levels are split over `pool`; bottom-up levels of a graph that isn't symmetric
+// run on its transpose.
+std::vector<u32> BfsDistances(parallel::ThreadPool& pool, const CsrGraph& graph, u32 source);
+std::vector<u32> BfsDistances(const CsrGraph& graph, u32 source);
+
+struct Components {
+  // The component of every node, numbered from 0 in order of their smallest nodes.
+  std::vector<u32> of;
+  // The number of nodes in every component.
+  std::vector<u32> sizes;
+};
+
+// The connected components of an undirected graph, or the weakly connected ones of a directed
+// graph, by union-find over the arcs.
+Components ConnectedComponents(const CsrGraph& graph);
+
+// The nodes in an order where every arc goes forward, by Kahn's algorithm from the sources in
+// node order, or nullopt if the graph has a cycle.
+std::optional<std::vector<u32>> TopologicalOrder(const CsrGraph& graph);
+
+}  // namespace aoc
+
+#endif  // ADVENTOFCODE_AOC_GRAPH_HPP
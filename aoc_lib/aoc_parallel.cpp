@@ -0,0 +1,125 @@
+#include "aoc_parallel.h"
+
+namespace aoc::parallel {
+
+namespace {
+
+// Identifies the pool and worker the current thread belongs to, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local u32 current_worker = 0;
+
+// Shared by the threads working on one ForEachChunk call. Workers that only get to it after the
+// last chunk was claimed find nothing left, so it's kept alive by them rather than by the caller.
+struct ChunkLoop {
+  ChunkLoop(const i64 num_chunks, const std::function<void(i64)>* run)
+      : num_chunks(num_chunks), run(run) {}
+
+  // Claims and runs chunks until none are left. `run` is only used for a claimed chunk, and the
+  // caller can't return before that chunk is done.
+  void Drain() {
+    for (i64 chunk = next++; chunk < num_chunks; chunk = next++) {
+      (*run)(chunk);
+      if (++done == num_chunks) done.notify_all();
+    }
+  }
+
+  const i64 num_chunks;
+  const std::function<void(i64)>* run;
+  std::atomic<i64> next{0};
+  std::atomic<i64> done{0};
+};
+
+}  // namespace
+
+ThreadPool::ThreadPool(u32 num_threads) {
+  if (num_threads == 0) num_threads = 1;
+  for (u32 i = 0; i < num_threads; i++) _workers.push_back(std::make_unique<Worker>());
+  for (u32 i = 0; i < num_threads; i++) _threads.emplace_back([this, i] { Run(i); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(_mutex);
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (auto& thread : _threads) thread.join();
+}
+
+void ThreadPool::Submit(Task task) {
+  u32 index = current_pool == this ? current_worker : _next++ % NumThreads();
+  _pending++;
+  {
+    std::lock_guard lock(_workers[index]->mutex);
+    _workers[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard lock(_mutex);
+    _queued++;
+  }
+  _wake.notify_one();
+}
+
+void ThreadPool::Wait() {
+  CHECK(current_pool != this) << "ThreadPool::Wait called from one of its own workers.";
+  std::unique_lock lock(_mutex);
+  _done.wait(lock, [this] { return _pending == 0; });
+}
+
+ThreadPool& DefaultPool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+void ForEachChunk(ThreadPool& pool, const i64 num_chunks, const std::function<void(i64)>& run) {
+  if (num_chunks <= 0) return;
+  auto loop = std::make_shared<ChunkLoop>(num_chunks, &run);
+  const i64 helpers = std::min<i64>(num_chunks, pool.NumThreads()) - 1;
+  for (i64 h = 0; h < helpers; h++) pool.Submit([loop] { loop->Drain(); });
+  loop->Drain();
+  for (i64 done = loop->done; done < num_chunks; done = loop->done) loop->done.wait(done);
+}
+
+bool ThreadPool::TryPop(u32 index, Task& task) {
+  auto& worker = *_workers[index];
+  std::lock_guard lock(worker.mutex);
+  if (worker.tasks.empty()) return false;
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::TrySteal(u32 index, Task& task) {
+  for (u32 offset = 1; offset < NumThreads(); offset++) {
+    auto& victim = *_workers[(index + offset) % NumThreads()];
+    std::lock_guard lock(victim.mutex);
+    if (victim.tasks.empty()) continue;
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::Run(u32 index) {
+  current_pool = this;
+  current_worker = index;
+  Task task;
+  while (true) {
+    if (TryPop(index, task) || TrySteal(index, task)) {
+      _queued--;
+      task();
+      task = nullptr;
+      if (--_pending == 0) {
+        std::lock_guard lock(_mutex);
+        _done.notify_all();
+      }
+      continue;
+    }
+    std::unique_lock lock(_mutex);
+    _wake.wait(lock, [this] { return _stop || _queued > 0; });
+    if (_stop && _queued == 0) return;
+  }
+}
+
+}  // namespace aoc::parallel
@@ -0,0 +1,101 @@
+#ifndef ADVENTOFCODE_AOC_PARALLEL_HPP
+#define ADVENTOFCODE_AOC_PARALLEL_HPP
+
+#include "aoc_core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aoc::parallel {
+
+// Work-stealing thread pool. Every worker owns a deque: it pops its own tasks LIFO and, when
+// empty, steals FIFO from the other workers. Tasks submitted from outside the pool are spread
+// round-robin; tasks submitted from a worker go to that worker's own deque.
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(u32 num_threads = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  void Submit(Task task);
+  // Blocks until every submitted task has finished. Must not be called from a worker thread.
+  void Wait();
+  [[nodiscard]] u32 NumThreads() const { return static_cast<u32>(_workers.size()); }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool TryPop(u32 index, Task& task);
+  bool TrySteal(u32 index, Task& task);
+  void Run(u32 index);
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<std::thread> _threads;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  std::atomic<i64> _queued{0};
+  std::atomic<i64> _pending{0};
+  std::atomic<u32> _next{0};
+  bool _stop{false};
+};
+
+// The pool the library's parallel loops run on, one thread per core, started on first use.
+ThreadPool& DefaultPool();
+
+// Runs `run(chunk)` for every chunk in [0, num_chunks) and returns once all of them have finished.
+// The calling thread drains chunks alongside NumThreads() - 1 of the pool's workers, so a loop
+// started from a worker, or while the pool is busy with other days, still makes progress.
+void ForEachChunk(ThreadPool& pool, i64 num_chunks, const std::function<void(i64)>& run);
+
+// Calls `body(begin, end)` in parallel for consecutive ranges of `grain` indices covering [0, n).
+template<typename Body>
+void ParallelFor(ThreadPool& pool, const i64 n, i64 grain, Body&& body) {
+  if (n <= 0) return;
+  grain = std::max<i64>(grain, 1);
+  ForEachChunk(pool, (n + grain - 1) / grain, [&](const i64 chunk) {
+    body(chunk * grain, std::min(n, (chunk + 1) * grain));
+  });
+}
+template<typename Body>
+void ParallelFor(const i64 n, const i64 grain, Body&& body) {
+  ParallelFor(DefaultPool(), n, grain, std::forward<Body>(body));
+}
+
+// Maps consecutive ranges of `grain` indices covering [0, n) to `T`s with `chunk(begin, end)` in
+// parallel, then folds them into `init` with `combine` in index order. The ranges depend only on
+// `grain`, so the result is the same for any number of threads, even if `combine` isn't
+// associative.
+template<typename T, typename Chunk, typename Combine>
+T ParallelReduce(ThreadPool& pool, const i64 n, i64 grain, T init, Chunk&& chunk, Combine&& combine) {
+  if (n <= 0) return init;
+  grain = std::max<i64>(grain, 1);
+  std::vector<T> partials((n + grain - 1) / grain);
+  ForEachChunk(pool, static_cast<i64>(partials.size()), [&](const i64 c) {
+    partials[c] = chunk(c * grain, std::min(n, (c + 1) * grain));
+  });
+  for (auto& partial : partials) init = combine(std::move(init), std::move(partial));
+  return init;
+}
+template<typename T, typename Chunk, typename Combine>
+T ParallelReduce(const i64 n, const i64 grain, T init, Chunk&& chunk, Combine&& combine) {
+  return ParallelReduce(DefaultPool(), n, grain, std::move(init), std::forward<Chunk>(chunk),
+                        std::forward<Combine>(combine));
+}
+
+}  // namespace aoc::parallel
+
+#endif  // ADVENTOFCODE_AOC_PARALLEL_HPP
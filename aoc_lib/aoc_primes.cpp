@@ -0,0 +1,255 @@
+#include "aoc_primes.h"
+
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+
+namespace aoc::primes {
+
+namespace {
+
+// The residues mod 30 coprime to 2, 3 and 5: bit k of byte b of a sieve stands for 30b + kWheel[k].
+constexpr std::array<u64, 8> kWheel = {1, 7, 11, 13, 17, 19, 23, 29};
+// The bit of n % 30 in its byte, or -1 if n is a multiple of 2, 3 or 5.
+constexpr std::array<i8, 30> kWheelBit = [] {
+  std::array<i8, 30> bits{};
+  bits.fill(-1);
+  for (u32 k = 0; k < kWheel.size(); k++) bits[kWheel[k]] = static_cast<i8>(k);
+  return bits;
+}();
+// Bytes sieved at a time, so the segment being crossed off stays in L1.
+constexpr u64 kSegmentBytes = 32 * 1024;
+
+// The primes below `limit` by a plain sieve, for the base primes of WheelSieve.
+std::vector<u64> SmallPrimes(const u64 limit) {
+  std::vector<u8> composite(limit, 0);
+  std::vector<u64> primes;
+  for (u64 n = 2; n < limit; n++) {
+    if (composite[n]) continue;
+    primes.push_back(n);
+    for (u64 m = n * n; m < limit; m += n) composite[m] = 1;
+  }
+  return primes;
+}
+
+// A sieve of Eratosthenes of [0, Limit()) over the numbers coprime to 30, one bit each.
+class WheelSieve {
+  // Bit k of byte b is set if 30b + kWheel[k] is composite, or 1.
+  std::vector<u8> _composite;
+
+ public:
+  [[nodiscard]] u64 Limit() const { return 30 * _composite.size(); }
+
+  // Sieves on from Limit() to at least `limit`, a segment at a time.
+  void Extend(const u64 limit) {
+    const u64 old_bytes = _composite.size();
+    const u64 new_bytes = (limit + 29) / 30;
+    if (new_bytes <= old_bytes) return;
+    _composite.resize(new_bytes, 0);
+    if (old_bytes == 0) _composite[0] |= 1;
+
+    // For every base prime p and wheel bit k, the next byte holding a multiple p * q with
+    // q >= p in that bit. Those multiples are 30p apart, so p bytes.
+    struct Crossing {
+      u64 prime;
+      std::array<u64, 8> next_byte;
+    };
+    std::vector<Crossing> crossings;
+    for (const u64 p : SmallPrimes(static_cast<u64>(std::sqrt(static_cast<double>(30 * new_bytes))) + 2)) {
+      if (p < 7 || p * p >= 30 * new_bytes) continue;
+      u64 inverse = 1;
+      while (inverse * p % 30 != 1) inverse++;
+      const u64 q_min = std::max(p, (30 * old_bytes + p - 1) / p);
+      Crossing& crossing = crossings.emplace_back(Crossing{p, {}});
+      for (u32 k = 0; k < kWheel.size(); k++) {
+        const u64 q_residue = kWheel[k] * inverse % 30;
+        const u64 q = q_min + (q_residue + 30 - q_min % 30) % 30;
+        crossing.next_byte[k] = p * q / 30;
+      }
+    }
+    for (u64 segment = old_bytes; segment < new_bytes; segment += kSegmentBytes) {
+      const u64 segment_end = std::min(new_bytes, segment + kSegmentBytes);
+      for (Crossing& crossing : crossings) {
+        for (u32 k = 0; k < kWheel.size(); k++) {
+          u64 byte = crossing.next_byte[k];
+          for (; byte < segment_end; byte += crossing.prime) _composite[byte] |= 1 << k;
+          crossing.next_byte[k] = byte;
+        }
+      }
+    }
+  }
+
+  // `n` must be below Limit().
+  [[nodiscard]] bool IsPrime(const u64 n) const {
+    if (n < 7) return n == 2 || n == 3 || n == 5;
+    const i8 bit = kWheelBit[n % 30];
+    return bit >= 0 && !((_composite[n / 30] >> bit) & 1);
+  }
+
+  // Appends the primes below `limit`, which must be at most Limit().
+  void AppendPrimes(const u64 limit, std::vector<u64>& primes) const {
+    for (const u64 p : {2, 3, 5}) {
+      if (p < limit) primes.push_back(p);
+    }
+    for (u64 byte = 0; byte < (limit + 29) / 30; byte++) {
+      for (u32 mask = static_cast<u8>(~_composite[byte]); mask != 0; mask &= mask - 1) {
+        const u64 n = 30 * byte + kWheel[std::countr_zero(mask)];
+        if (n >= limit) return;
+        primes.push_back(n);
+      }
+    }
+  }
+};
+
+struct SieveCache {
+  std::shared_mutex mutex;
+  WheelSieve sieve;
+};
+
+SieveCache& Cache() {
+  static SieveCache cache;
+  return cache;
+}
+
+u64 MulMod(const u64 a, const u64 b, const u64 n) {
+  return static_cast<u64>(static_cast<u128>(a) * b % n);
+}
+
+u64 PowMod(u64 base, u64 exponent, const u64 n) {
+  u64 result = 1;
+  for (base %= n; exponent > 0; exponent >>= 1) {
+    if (exponent & 1) result = MulMod(result, base, n);
+    base = MulMod(base, base, n);
+  }
+  return result;
+}
+
+bool MillerRabin(const u64 n) {
+  if (n < 2) return false;
+  for (const u64 p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+    if (n % p == 0) return n == p;
+  }
+  const u32 s = std::countr_zero(n - 1);
+  const u64 d = (n - 1) >> s;
+  for (const u64 base : {2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL}) {
+    const u64 a = base % n;
+    if (a == 0) continue;
+    u64 x = PowMod(a, d, n);
+    if (x == 1 || x == n - 1) continue;
+    bool composite = true;
+    for (u32 r = 1; r < s && composite; r++) {
+      x = MulMod(x, x, n);
+      composite = x != n - 1;
+    }
+    if (composite) return false;
+  }
+  return true;
+}
+
+// A nontrivial factor of the odd composite `n`, by Brent's variant of Pollard's rho. The gcd is
+// taken once per batch of 128 steps on the product of the differences.
+u64 Rho(const u64 n) {
+  constexpr u64 kBatch = 128;
+  const auto diff = [](const u64 a, const u64 b) { return a > b ? a - b : b - a; };
+  for (u64 c = 1;; c++) {
+    const auto f = [n, c](const u64 x) {
+      return static_cast<u64>((static_cast<u128>(x) * x + c) % n);
+    };
+    u64 x = 0, y = 2, ys = 2, q = 1, g = 1;
+    for (u64 r = 1; g == 1; r *= 2) {
+      x = y;
+      for (u64 i = 0; i < r; i++) y = f(y);
+      for (u64 k = 0; k < r && g == 1; k += kBatch) {
+        ys = y;
+        for (u64 i = 0; i < std::min(kBatch, r - k); i++) {
+          y = f(y);
+          q = MulMod(q, diff(x, y), n);
+        }
+        g = std::gcd(q, n);
+      }
+    }
+    // The batch overshot: redo its steps one gcd at a time.
+    if (g == n) {
+      do {
+        ys = f(ys);
+        g = std::gcd(diff(x, ys), n);
+      } while (g == 1);
+    }
+    if (g != n) return g;
+  }
+}
+
+void FactorizeLarge(const u64 n, std::vector<u64>& factors) {
+  if (n == 1) return;
+  if (IsPrime(n)) {
+    factors.push_back(n);
+    return;
+  }
+  const u64 d = Rho(n);
+  FactorizeLarge(d, factors);
+  FactorizeLarge(n / d, factors);
+}
+
+}  // namespace
+
+std::vector<u64> Primes(const u64 limit) {
+  std::vector<u64> primes;
+  SieveCache& cache = Cache();
+  {
+    std::shared_lock lock(cache.mutex);
+    if (cache.sieve.Limit() >= limit) {
+      cache.sieve.AppendPrimes(limit, primes);
+      return primes;
+    }
+  }
+  std::unique_lock lock(cache.mutex);
+  cache.sieve.Extend(limit);
+  cache.sieve.AppendPrimes(limit, primes);
+  return primes;
+}
+
+std::vector<u64> SievePrimes(const u64 limit) {
+  WheelSieve sieve;
+  sieve.Extend(limit);
+  std::vector<u64> primes;
+  sieve.AppendPrimes(limit, primes);
+  return primes;
+}
+
+bool IsPrime(const u64 n) {
+  SieveCache& cache = Cache();
+  std::shared_lock lock(cache.mutex);
+  if (n < cache.sieve.Limit()) return cache.sieve.IsPrime(n);
+  lock.unlock();
+  return MillerRabin(n);
+}
+
+std::vector<std::pair<u64, u32>> Factorize(u64 n) {
+  std::vector<std::pair<u64, u32>> result;
+  if (n < 2) return result;
+  static const std::vector<u64> kSmallPrimes = Primes(1000);
+  for (const u64 p : kSmallPrimes) {
+    if (p * p > n) break;
+    if (n % p != 0) continue;
+    auto& [prime, power] = result.emplace_back(p, 0);
+    for (; n % p == 0; n /= p) power++;
+  }
+  std::vector<u64> factors;
+  // What's left has no factor below 1000, so it's a prime unless it's at least 1000^2.
+  if (n < 1000 * 1000) {
+    if (n > 1) factors.push_back(n);
+  } else {
+    FactorizeLarge(n, factors);
+  }
+  absl::c_sort(factors);
+  for (const u64 factor : factors) {
+    if (!result.empty() && result.back().first == factor) {
+      result.back().second++;
+    } else {
+      result.emplace_back(factor, 1);
+    }
+  }
+  return result;
+}
+
+}  // namespace aoc::primes
@@ -0,0 +1,29 @@
+#ifndef ADVENTOFCODE_AOC_PRIMES_HPP
+#define ADVENTOFCODE_AOC_PRIMES_HPP
+
+#include "aoc_core.h"
+
+#include <utility>
+#include <vector>
+
+namespace aoc::primes {
+
+// The primes below `limit`, in increasing order. They come from a process-wide sieve that only
+// ever grows: it's sieved in L1-sized segments over the numbers coprime to 30, one bit each, so
+// the primes below 10^9 take 33 MB and are sieved once per process. Thread-safe.
+std::vector<u64> Primes(u64 limit);
+
+// The same, but from a sieve of its own that's dropped afterwards; for measuring the sieve.
+std::vector<u64> SievePrimes(u64 limit);
+
+// Deterministic for every 64-bit `n`: a lookup in the sieve when `n` is inside it, Miller-Rabin
+// with the seven bases known to cover 2^64 otherwise.
+bool IsPrime(u64 n);
+
+// The prime factors of `n` with their powers, by increasing prime: trial division by the primes
+// below 1000, then Pollard's rho (Brent's variant) on what's left. Empty for 0 and 1.
+std::vector<std::pair<u64, u32>> Factorize(u64 n);
+
+}  // namespace aoc::primes
+
+#endif  // ADVENTOFCODE_AOC_PRIMES_HPP
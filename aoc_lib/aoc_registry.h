@@ -0,0 +1,52 @@
+#ifndef ADVENTOFCODE_AOC_REGISTRY_HPP
+#define ADVENTOFCODE_AOC_REGISTRY_HPP
+
+#include "aoc_core.h"
+#include "aoc_days.h"
+
+#include <array>
+
+namespace aoc {
+
+struct RegisteredDay {
+  int year;
+  int day;
+  // Loads the input at `path`, or the day's own input when empty, solves it and returns both parts.
+  // With a cache, answers are looked up first and `*cached` tells whether they were found.
+  std::tuple<std::string, std::string> (*solve)(
+      const std::string& path, const ResultCache* cache, bool* cached);
+  // The recorded answers of the day's own input, empty where there are none.
+  std::tuple<std::string, std::string> (*expected)();
+};
+
+template<int YEAR, int DAY>
+auto SolveDay(const std::string& path, const ResultCache* cache, bool* cached)
+    -> std::tuple<std::string, std::string> {
+  advent<YEAR, DAY> adv;
+  if (path.empty()) {
+    adv.GetInput();
+  } else {
+    adv.LoadInput(path);
+  }
+  if (cache != nullptr) return adv.solve(*cache, cached);
+  if (cached != nullptr) *cached = false;
+  return adv.solve();
+}
+
+template<int YEAR, int DAY>
+auto ExpectedAnswers() -> std::tuple<std::string, std::string> {
+  advent<YEAR, DAY> adv;
+  return {adv.PartOne(), adv.PartTwo()};
+}
+
+#ifndef AOC_REGISTER_DAY
+#define AOC_REGISTER_DAY(year, day) aoc::RegisteredDay{\
+    (year), (day), &aoc::SolveDay<(year), (day)>, &aoc::ExpectedAnswers<(year), (day)>},
+#endif // AOC_REGISTER_DAY
+
+// Every advent<YEAR, DAY> compiled into aoc_lib, in (year, day) order, as found by CMake.
+inline constexpr std::array kRegisteredDays{AOC_FOR_EACH_DAY(AOC_REGISTER_DAY)};
+
+}  // namespace aoc
+
+#endif  // ADVENTOFCODE_AOC_REGISTRY_HPP
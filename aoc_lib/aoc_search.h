@@ -0,0 +1,235 @@
+#ifndef ADVENTOFCODE_AOC_SEARCH_HPP
+#define ADVENTOFCODE_AOC_SEARCH_HPP
+
+#include "aoc_core.h"
+
+#include <array>
+#include <bit>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace aoc::search {
+
+using Cost = u32;
+inline constexpr Cost kUnreachable = std::numeric_limits<Cost>::max();
+
+// A search state: a linear Grid index, plus a direction (or any other small tag below the NDirs
+// of the search) for searches where the way a tile was entered matters.
+struct State {
+  i64 index;
+  u32 dir{0};
+  bool operator==(const State&) const = default;
+};
+
+// Monotone priority queue for integer keys: every pushed key must be at least the last popped
+// one, which holds for Dijkstra and for A* with a consistent heuristic. Values sit in one bucket
+// per highest bit in which their key differs from the last popped key, so a pop moves each value
+// at most 32 times in total instead of paying a log(n) sift.
+template<typename V>
+class RadixHeap {
+  std::array<std::vector<std::pair<Cost, V>>, 33> _buckets;
+  Cost _last{0};
+  i64 _size{0};
+
+  [[nodiscard]] static u32 Bucket(const Cost key, const Cost last) {
+    return 32 - std::countl_zero(key ^ last);
+  }
+
+ public:
+  [[nodiscard]] bool Empty() const { return _size == 0; }
+  [[nodiscard]] i64 Size() const { return _size; }
+
+  void Push(const Cost key, V value) {
+    DCHECK(key >= _last) << "Pushed key " << key << " below the last popped " << _last << ".";
+    _buckets[Bucket(key, _last)].emplace_back(key, std::move(value));
+    _size++;
+  }
+  // Removes and returns a (key, value) pair with the smallest key.
+  std::pair<Cost, V> Pop() {
+    if (_buckets[0].empty()) {
+      u32 b = 1;
+      while (_buckets[b].empty()) b++;
+      Cost new_last = kUnreachable;
+      for (const auto& [key, value] : _buckets[b]) new_last = std::min(new_last, key);
+      _last = new_last;
+      for (auto& entry : _buckets[b]) _buckets[Bucket(entry.first, _last)].push_back(std::move(entry));
+      _buckets[b].clear();
+    }
+    auto entry = std::move(_buckets[0].back());
+    _buckets[0].pop_back();
+    _size--;
+    return entry;
+  }
+  // Empties the heap but keeps the bucket memory for the next search.
+  void Clear() {
+    for (auto& bucket : _buckets) bucket.clear();
+    _last = 0;
+    _size = 0;
+  }
+};
+
+// What a search remembers beside the distances: nothing, one shortest path to every state, or
+// the DAG of all shortest paths.
+enum class Record { kDistance, kPath, kAllPaths };
+
+struct NoHeuristic {
+  constexpr Cost operator()(const State&) const { return 0; }
+};
+struct Exhaustive {
+  constexpr bool operator()(const State&) const { return false; }
+};
+
+// Single-source shortest paths over the (linear index, direction) states of a Grid of `size`
+// cells. States are numbered index * NDirs + dir at compile time, so distances and predecessors
+// live in GridStateArrays rather than hash maps, and a search is reset in O(1) for the next run.
+//
+// The graph is given as a callable `neighbours(State from, auto&& edge)` that calls
+// `edge(State to, Cost weight)` for every move out of `from`.
+template<u32 NDirs = 1, Record kRecord = Record::kDistance>
+class ShortestPaths {
+  GridStateArray<Cost, NDirs> _distance;
+  // kPath: key of the predecessor; kAllPaths: head of the predecessor list in _edges, 0 if none.
+  GridStateArray<u32, NDirs> _predecessor;
+  // kAllPaths: (predecessor key, next entry) lists; entry 0 is the end of every list.
+  std::vector<std::pair<u32, u32>> _edges;
+  RadixHeap<u32> _queue;
+  std::vector<u32> _fifo;
+
+  [[nodiscard]] static constexpr u32 Key(const State& s) {
+    return static_cast<u32>(s.index * NDirs + s.dir);
+  }
+  [[nodiscard]] static constexpr State FromKey(const u32 key) {
+    return {static_cast<i64>(key / NDirs), key % NDirs};
+  }
+
+  void Reset() {
+    _distance.Clear();
+    _predecessor.Clear();
+    _queue.Clear();
+    _fifo.clear();
+    if constexpr (kRecord == Record::kAllPaths) {
+      _edges.clear();
+      _edges.emplace_back(0, 0);
+    }
+  }
+  // Lowers the distance of `to` to `distance` if that's an improvement, and returns whether it was.
+  bool Relax(const u32 from, const State& to, const Cost distance) {
+    const Cost* old = _distance.Find(to.index, to.dir);
+    if (old != nullptr && *old < distance) return false;
+    if constexpr (kRecord == Record::kAllPaths) {
+      u32& head = _predecessor(to.index, to.dir);
+      if (old == nullptr || *old > distance) head = 0;
+      _edges.emplace_back(from, head);
+      head = static_cast<u32>(_edges.size() - 1);
+    }
+    if (old != nullptr && *old == distance) return false;
+    _distance(to.index, to.dir) = distance;
+    if constexpr (kRecord == Record::kPath) _predecessor(to.index, to.dir) = from;
+    return true;
+  }
+
+ public:
+  explicit ShortestPaths(const i64 size) : _distance(size), _predecessor(size) {}
+
+  // Dijkstra from `sources`, or A* if given a consistent `heuristic`. Stops once a state for
+  // which `stop` holds is settled and returns its distance, or kUnreachable if none is.
+  template<typename Neighbours, typename Stop = Exhaustive, typename Heuristic = NoHeuristic>
+  Cost Run(std::initializer_list<State> sources,
+           Neighbours&& neighbours,
+           Stop&& stop = {},
+           Heuristic&& heuristic = {}) {
+    Reset();
+    for (const State& source : sources) {
+      _distance(source.index, source.dir) = 0;
+      _queue.Push(heuristic(source), Key(source));
+    }
+    while (!_queue.Empty()) {
+      const auto [priority, key] = _queue.Pop();
+      const State state = FromKey(key);
+      const Cost distance = *_distance.Find(state.index, state.dir);
+      // Superseded by a shorter distance pushed later.
+      if (distance + heuristic(state) != priority) continue;
+      if (stop(state)) return distance;
+      neighbours(state, [&](const State& to, const Cost weight) {
+        if (Relax(key, to, distance + weight)) _queue.Push(distance + weight + heuristic(to), Key(to));
+      });
+    }
+    return kUnreachable;
+  }
+
+  // Breadth-first search from `sources` for graphs whose edges all weigh 1, with a plain FIFO.
+  template<typename Neighbours, typename Stop = Exhaustive>
+  Cost Bfs(std::initializer_list<State> sources, Neighbours&& neighbours, Stop&& stop = {}) {
+    Reset();
+    for (const State& source : sources) {
+      _distance(source.index, source.dir) = 0;
+      _fifo.push_back(Key(source));
+    }
+    for (u64 next = 0; next < _fifo.size(); next++) {
+      const u32 key = _fifo[next];
+      const State state = FromKey(key);
+      const Cost distance = *_distance.Find(state.index, state.dir);
+      if (stop(state)) return distance;
+      neighbours(state, [&](const State& to, [[maybe_unused]] const Cost weight) {
+        DCHECK(weight == 1) << "Bfs on a weighted edge.";
+        if (Relax(key, to, distance + 1)) _fifo.push_back(Key(to));
+      });
+    }
+    return kUnreachable;
+  }
+
+  // Distance of `state` in the last search, or kUnreachable if it wasn't reached.
+  [[nodiscard]] Cost Distance(const State& state) const {
+    const Cost* distance = _distance.Find(state.index, state.dir);
+    return distance != nullptr ? *distance : kUnreachable;
+  }
+  [[nodiscard]] Cost Distance(const i64 index, const Dir dir) const
+    requires(NDirs == 4)
+  {
+    return Distance({index, DirIndex(dir)});
+  }
+
+  // Calls `visit(State)` once for every state on the recorded shortest path(s) to `targets`,
+  // targets and sources included.
+  template<typename Visit>
+  void ForEachOnPaths(std::initializer_list<State> targets, Visit&& visit) const
+    requires(kRecord != Record::kDistance)
+  {
+    GridBitset<NDirs> seen(_distance.Size());
+    if constexpr (kRecord == Record::kPath) {
+      // Paths merge towards the sources: once a walk reaches a state seen before, the rest of it
+      // was visited too.
+      for (const State& target : targets) {
+        if (!seen.Insert(target.index, target.dir)) continue;
+        visit(target);
+        for (const u32* pred = _predecessor.Find(target.index, target.dir); pred != nullptr;) {
+          const State state = FromKey(*pred);
+          if (!seen.Insert(state.index, state.dir)) break;
+          visit(state);
+          pred = _predecessor.Find(state.index, state.dir);
+        }
+      }
+    } else {
+      std::vector<u32> stack;
+      for (const State& target : targets) {
+        if (seen.Insert(target.index, target.dir)) stack.push_back(Key(target));
+      }
+      while (!stack.empty()) {
+        const State state = FromKey(stack.back());
+        stack.pop_back();
+        visit(state);
+        const u32* head = _predecessor.Find(state.index, state.dir);
+        for (u32 e = head != nullptr ? *head : 0; e != 0; e = _edges[e].second) {
+          const State pred = FromKey(_edges[e].first);
+          if (seen.Insert(pred.index, pred.dir)) stack.push_back(_edges[e].first);
+        }
+      }
+    }
+  }
+};
+
+}  // namespace aoc::search
+
+#endif  // ADVENTOFCODE_AOC_SEARCH_HPP
@@ -1,31 +0,0 @@
-#include "aoc_tests.h"
-
-using test_2024_types = ::testing::Types<
-    TEST_YEAR_DAY(2024, 1),
-    TEST_YEAR_DAY(2024, 2),
-    TEST_YEAR_DAY(2024, 3),
-    TEST_YEAR_DAY(2024, 4),
-    TEST_YEAR_DAY(2024, 5),
-    TEST_YEAR_DAY(2024, 6),
-    TEST_YEAR_DAY(2024, 7),
-    TEST_YEAR_DAY(2024, 8),
-    TEST_YEAR_DAY(2024, 9),
-    TEST_YEAR_DAY(2024, 10),
-    TEST_YEAR_DAY(2024, 11),
-    TEST_YEAR_DAY(2024, 12),
-    TEST_YEAR_DAY(2024, 13),
-    TEST_YEAR_DAY(2024, 14),
-    TEST_YEAR_DAY(2024, 15),
-    TEST_YEAR_DAY(2024, 16),
-    TEST_YEAR_DAY(2024, 17),
-    TEST_YEAR_DAY(2024, 18),
-    TEST_YEAR_DAY(2024, 19),
-    TEST_YEAR_DAY(2024, 20),
-    TEST_YEAR_DAY(2024, 21),
-    TEST_YEAR_DAY(2024, 22),
-    TEST_YEAR_DAY(2024, 23),
-    TEST_YEAR_DAY(2024, 24),
-    TEST_YEAR_DAY(2024, 25)
->;
-
-INSTANTIATE_TYPED_TEST_SUITE_P(My, AoCTests, test_2024_types);
\ No newline at end of file
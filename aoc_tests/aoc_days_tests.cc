@@ -0,0 +1,310 @@
+#include "aoc_tests.h"
+
+TEST_P(AoCTests, ValidateAnswersTest) {
+    const aoc::RegisteredDay& registered = GetParam();
+    const auto expected = registered.expected();
+    if (std::get<0>(expected).empty() && std::get<1>(expected).empty()) {
+        GTEST_SKIP() << "No recorded answers for " << registered.year << "/" << registered.day << ".";
+    }
+    const auto result = registered.solve("", nullptr, nullptr);
+    EXPECT_EQ(std::get<0>(result), std::get<0>(expected));
+    EXPECT_EQ(std::get<1>(result), std::get<1>(expected));
+}
+
+INSTANTIATE_TEST_SUITE_P(My, AoCTests, testing::ValuesIn(aoc::kRegisteredDays), DayTestName);
+
+// The answers above need the puzzle inputs, which aren't checked in. These solve the examples of
+// rewritten days instead, or, where a solver relies on the shape of the real input, a small input
+// of that shape whose answers were worked out by hand.
+namespace {
+
+template<int YEAR, int DAY>
+std::tuple<std::string, std::string> SolveExample(std::string input) {
+    advent<YEAR, DAY> adv;
+    adv.SetInput(std::move(input));
+    return adv.solve();
+}
+
+}  // namespace
+
+#ifdef AOC_YEAR_2023
+
+TEST(ExamplesTest, Solves2023_08GhostPaths) {
+    // Part 2's example, with an AAA -> ZZZ path added since part 1 starts from AAA. Cycles are
+    // counted in whole rounds of instructions: 2 from 11A and AAA, 6 from 22A.
+    const auto [part1, part2] = SolveExample<2023, 8>(R"(LR
+
+11A = (11B, XXX)
+11B = (XXX, 11Z)
+11Z = (11B, XXX)
+22A = (22B, XXX)
+22B = (22C, 22C)
+22C = (22Z, 22Z)
+22Z = (22B, 22B)
+XXX = (XXX, XXX)
+AAA = (ZZZ, ZZZ)
+ZZZ = (ZZZ, ZZZ)
+)");
+    EXPECT_EQ(part1, "2");
+    EXPECT_EQ(part2, "6");
+}
+
+TEST(ExamplesTest, Solves2023_08RepeatingInstructions) {
+    const auto [part1, part2] = SolveExample<2023, 8>(R"(LLR
+
+AAA = (BBB, BBB)
+BBB = (AAA, ZZZ)
+ZZZ = (ZZZ, ZZZ)
+)");
+    EXPECT_EQ(part1, "6");
+    EXPECT_EQ(part2, "6");
+}
+
+TEST(ExamplesTest, Solves2023_17) {
+    const auto [part1, part2] = SolveExample<2023, 17>(R"(2413432311323
+3215453535623
+3255245654254
+3446585845452
+4546657867536
+1438598798454
+4457876987766
+3637877979653
+4654967986887
+4564679986453
+1224686865563
+2546548887735
+4322674655533
+)");
+    EXPECT_EQ(part1, "102");
+    EXPECT_EQ(part2, "94");
+}
+
+TEST(ExamplesTest, Solves2023_20) {
+    // Part 2 watches the four modules that feed rx's conjunction in the real input. Here they
+    // invert bits 10 to 13 of a ripple counter, so they first send a low pulse on presses 1024,
+    // 2048, 4096 and 8192. Part 1 also counts the pulses of the second example.
+    const auto [part1, part2] = SolveExample<2023, 20>(R"(broadcaster -> a, c0
+%a -> inv, con
+&inv -> b
+%b -> con
+&con -> output
+%c0 -> c1
+%c1 -> c2
+%c2 -> c3
+%c3 -> c4
+%c4 -> c5
+%c5 -> c6
+%c6 -> c7
+%c7 -> c8
+%c8 -> c9
+%c9 -> c10
+%c10 -> c11, nl
+%c11 -> c12, cr
+%c12 -> c13, jx
+%c13 -> vj
+&nl -> hub
+&cr -> hub
+&jx -> hub
+&vj -> hub
+&hub -> rx
+)");
+    EXPECT_EQ(part1, "23415000");
+    EXPECT_EQ(part2, "8192");
+}
+
+TEST(ExamplesTest, Solves2023_23) {
+    const auto [part1, part2] = SolveExample<2023, 23>(R"(#.#####################
+#.......#########...###
+#######.#########.#.###
+###.....#.>.>.###.#.###
+###v#####.#v#.###.#.###
+###.>...#.#.#.....#...#
+###v###.#.#.#########.#
+###...#.#.#.......#...#
+#####.#.#.#######.#.###
+#.....#.#.#.......#...#
+#.#####.#.#.#########v#
+#.#...#...#...###...>.#
+#.#.#v#######v###.###v#
+#...#.>.#...>.>.#.###.#
+#####v#.#.###v#.#.###.#
+#.....#...#...#.#.#...#
+#.#########.###.#.#.###
+#...###...#...#...#.###
+###.###.#.###v#####v###
+#...#...#.#.>.>.#.>.###
+#.###.###.#.###.#.#v###
+#.....###...###...#...#
+#####################.#
+)");
+    EXPECT_EQ(part1, "94");
+    EXPECT_EQ(part2, "154");
+}
+
+TEST(ExamplesTest, Solves2023_24) {
+    // The example has too few hailstones with a shared velocity to pin down the rock's velocity,
+    // so these were thrown at the rock 260e12, 310e12, 180e12 @ -37, 12, 61. 56 of their 66
+    // pairs cross inside part 1's test area.
+    const auto [part1, part2] = SolveExample<2023, 24>(R"(232724254919260, 295313060341140, 222487218298845 @ 15, 40, -20
+257539147759195, 305946831603380, 176091587617545 @ -20, 40, 88
+331729219377474, 330312699292736, 193330208910858 @ -150, -20, 40
+198388875967500, 296199108216720, 283999577366860 @ 88, 40, -150
+242313577145380, 365100009662470, 170816665056255 @ 15, -150, 88
+228438566385250, 350903617964716, 185302320847278 @ 88, -150, 40
+255723916225117, 350748563031238, 200374281515619 @ -20, -150, -20
+256492468719095, 294319271920660, 196712354926665 @ -20, 88, -20
+370607699939452, 235608980571696, 200555413263084 @ -150, 88, 40
+224222810101368, 290735359285352, 235729853495946 @ 15, 40, -20
+214379612472636, 452125053450634, 220356496658822 @ 15, -150, 15
+220224949353448, 307705285539622, 341394917046586 @ 15, 15, -150
+)");
+    EXPECT_EQ(part1, "56");
+    EXPECT_EQ(part2, "750000000000000");
+}
+
+TEST(ExamplesTest, Solves2023_25) {
+    const auto [part1, part2] = SolveExample<2023, 25>(R"(jqt: rhn xhk nvd
+rsh: frs pzl lsr
+xhk: hfx
+cmg: qnr nvd lhk bvb
+rhn: xhk bvb hfx
+bvb: xhk hfx
+pzl: lsr hfx nvd
+qnr: nvd
+ntq: jqt hfx bvb xhk
+nvd: lhk
+lsr: lhk
+rzs: qnr cmg lsr rsh
+frs: qnr lhk lsr
+)");
+    EXPECT_EQ(part1, "54");
+    EXPECT_EQ(part2, "0");
+}
+
+#endif  // AOC_YEAR_2023
+
+#ifdef AOC_YEAR_2024
+
+TEST(ExamplesTest, Solves2024_23) {
+    // The example, plus a triangle of t computers apart from it, whose component is too small
+    // to hold the largest clique.
+    const auto [part1, part2] = SolveExample<2024, 23>(R"(kh-tc
+qp-kh
+de-cg
+ka-co
+yn-aq
+qp-ub
+cg-tb
+vc-aq
+tb-ka
+wh-tc
+yn-cg
+kh-ub
+ta-co
+de-co
+tc-td
+tb-wq
+wh-td
+ta-ka
+td-qp
+aq-cg
+wq-ub
+ub-vc
+de-ta
+wq-aq
+wq-vc
+wh-yn
+ka-de
+kh-ta
+co-tc
+wh-qp
+tb-vc
+td-yn
+tx-ty
+ty-tz
+tz-tx
+)");
+    EXPECT_EQ(part1, "8");
+    EXPECT_EQ(part2, "co,de,ka,ta");
+}
+
+TEST(ExamplesTest, Solves2024_24) {
+    // The larger example; it isn't an adder, so part 2 is left to the next test.
+    const auto part1 = std::get<0>(SolveExample<2024, 24>(R"(x00: 1
+x01: 0
+x02: 1
+x03: 1
+x04: 0
+y00: 1
+y01: 1
+y02: 1
+y03: 1
+y04: 1
+
+ntg XOR fgs -> mjb
+y02 OR x01 -> tnw
+kwq OR kpj -> z05
+x00 OR x03 -> fst
+tgd XOR rvg -> z01
+vdt OR tnw -> bfw
+bfw AND frj -> z10
+ffh OR nrd -> bqk
+y00 AND y03 -> djm
+y03 OR y00 -> psh
+bqk OR frj -> z08
+tnw OR fst -> frj
+gnj AND tgd -> z11
+bfw XOR mjb -> z00
+x03 OR x00 -> vdt
+gnj AND wpb -> z02
+x04 AND y00 -> kjc
+djm OR pbm -> qhw
+nrd AND vdt -> hwm
+kjc AND fst -> rvg
+y04 OR y02 -> fgs
+y01 AND x02 -> pbm
+ntg OR kjc -> kwq
+psh XOR fgs -> tgd
+qhw XOR tgd -> z09
+pbm OR djm -> kpj
+x03 XOR y03 -> ffh
+x00 XOR y04 -> ntg
+bfw OR bqk -> z06
+nrd XOR fgs -> wpb
+frj XOR qhw -> z04
+bqk OR frj -> z07
+y03 OR x01 -> nrd
+hwm AND bqk -> z03
+tgd XOR rvg -> z12
+tnw OR pbm -> gnj
+)"));
+    EXPECT_EQ(part1, "2024");
+}
+
+TEST(ExamplesTest, Solves2024_24SwappedAdder) {
+    // A 3-bit ripple-carry adder with the outputs of z01 and b01 swapped: 5 + 3 comes out as 6.
+    const auto [part1, part2] = SolveExample<2024, 24>(R"(x00: 1
+x01: 0
+x02: 1
+y00: 1
+y01: 1
+y02: 0
+
+x00 XOR y00 -> z00
+x00 AND y00 -> c00
+x01 XOR y01 -> s01
+s01 XOR c00 -> b01
+x01 AND y01 -> a01
+s01 AND c00 -> z01
+a01 OR b01 -> c01
+x02 XOR y02 -> s02
+s02 XOR c01 -> z02
+x02 AND y02 -> a02
+s02 AND c01 -> b02
+a02 OR b02 -> z03
+)");
+    EXPECT_EQ(part1, "6");
+    EXPECT_EQ(part2, "b01,z01");
+}
+
+#endif  // AOC_YEAR_2024
@@ -0,0 +1,240 @@
+#include "aoc_tests.h"
+
+#include <aoc_graph.h>
+
+#include <random>
+
+namespace {
+
+using Arcs = std::vector<std::pair<u32, u32>>;
+
+std::vector<u32> Neighbors(const aoc::CsrGraph& graph, const u32 node) {
+    const auto neighbors = graph.Neighbors(node);
+    return {neighbors.begin(), neighbors.end()};
+}
+
+// `num_arcs` random arcs among `num_nodes` nodes.
+Arcs RandomArcs(const u32 num_nodes, const u32 num_arcs, const u64 seed) {
+    std::mt19937_64 rng(seed);
+    Arcs arcs;
+    for (u32 i = 0; i < num_arcs; i++) arcs.emplace_back(rng() % num_nodes, rng() % num_nodes);
+    return arcs;
+}
+
+// A FIFO breadth-first search, one level after the other.
+std::vector<u32> QueueBfs(const aoc::CsrGraph& graph, const u32 source) {
+    std::vector<u32> distances(graph.NumNodes(), aoc::CsrGraph::kUnreachable);
+    std::vector<u32> queue{source};
+    distances[source] = 0;
+    for (u64 head = 0; head < queue.size(); head++) {
+        for (const u32 next : graph.Neighbors(queue[head])) {
+            if (distances[next] != aoc::CsrGraph::kUnreachable) continue;
+            distances[next] = distances[queue[head]] + 1;
+            queue.push_back(next);
+        }
+    }
+    return distances;
+}
+
+}  // namespace
+
+TEST(GraphTest, InternerNumbersNamesInOrderOfAppearance) {
+    aoc::Interner interner;
+    // Short names of either case, and names that take the hash map: mixed case, digits, symbols,
+    // longer than three letters, empty.
+    const std::vector<std::string_view> names{
+        "aaa", "rx", "z", "ZZZ", "A", "a", "aB", "a1", "broadcaster", "", "zz{", "`a", "zzz"};
+    for (u32 i = 0; i < names.size(); i++) EXPECT_EQ(interner.Intern(names[i]), i) << names[i];
+    for (u32 i = 0; i < names.size(); i++) {
+        EXPECT_EQ(interner.Intern(names[i]), i) << names[i];
+        EXPECT_EQ(interner.Find(names[i]), i) << names[i];
+        EXPECT_EQ(interner.Name(i), names[i]);
+    }
+    EXPECT_EQ(interner.Size(), names.size());
+    EXPECT_EQ(interner.Names(), names);
+}
+
+TEST(GraphTest, InternerFindsOnlyInternedNames) {
+    aoc::Interner interner;
+    EXPECT_EQ(interner.Find("abc"), aoc::Interner::kNotFound);
+    EXPECT_EQ(interner.Find("ABC"), aoc::Interner::kNotFound);
+    EXPECT_EQ(interner.Find("abcd"), aoc::Interner::kNotFound);
+    interner.Intern("ab");
+    // A missing letter isn't an 'a': "ab", "aab" and "ba" are all different keys.
+    EXPECT_EQ(interner.Find("ab"), 0);
+    EXPECT_EQ(interner.Find("aab"), aoc::Interner::kNotFound);
+    EXPECT_EQ(interner.Find("ba"), aoc::Interner::kNotFound);
+    EXPECT_EQ(interner.Find("AB"), aoc::Interner::kNotFound);
+    EXPECT_EQ(interner.Intern("aab"), 1);
+    EXPECT_EQ(interner.Intern("AB"), 2);
+    EXPECT_EQ(interner.Size(), 3);
+}
+
+TEST(GraphTest, CsrGraphKeepsTheOrderOfEachNodesArcs) {
+    // Node 3 has no arcs, node 0 a self-loop and a repeated arc.
+    const Arcs arcs{{2, 1}, {0, 4}, {0, 0}, {2, 0}, {0, 4}, {4, 2}};
+    const aoc::CsrGraph graph(5, arcs);
+    EXPECT_EQ(graph.NumNodes(), 5);
+    EXPECT_EQ(graph.NumArcs(), 6);
+    EXPECT_FALSE(graph.IsSymmetric());
+    EXPECT_EQ(Neighbors(graph, 0), (std::vector<u32>{4, 0, 4}));
+    EXPECT_EQ(Neighbors(graph, 1), std::vector<u32>{});
+    EXPECT_EQ(Neighbors(graph, 2), (std::vector<u32>{1, 0}));
+    EXPECT_EQ(Neighbors(graph, 3), std::vector<u32>{});
+    EXPECT_EQ(Neighbors(graph, 4), std::vector<u32>{2});
+    EXPECT_EQ(graph.Degree(0), 3);
+    EXPECT_EQ(graph.Degree(3), 0);
+}
+
+TEST(GraphTest, CsrGraphUndirectedHasArcsBothWays) {
+    const Arcs edges{{0, 1}, {1, 2}, {3, 1}};
+    const auto graph = aoc::CsrGraph::Undirected(5, edges);
+    EXPECT_TRUE(graph.IsSymmetric());
+    EXPECT_EQ(graph.NumArcs(), 6);
+    EXPECT_EQ(Neighbors(graph, 0), std::vector<u32>{1});
+    EXPECT_EQ(Neighbors(graph, 1), (std::vector<u32>{0, 2, 3}));
+    EXPECT_EQ(Neighbors(graph, 2), std::vector<u32>{1});
+    EXPECT_EQ(Neighbors(graph, 3), std::vector<u32>{1});
+    EXPECT_EQ(Neighbors(graph, 4), std::vector<u32>{});
+}
+
+TEST(GraphTest, CsrGraphEmpty) {
+    const aoc::CsrGraph none;
+    EXPECT_EQ(none.NumNodes(), 0);
+    EXPECT_EQ(none.NumArcs(), 0);
+    const aoc::CsrGraph isolated(3, Arcs{});
+    EXPECT_EQ(isolated.NumNodes(), 3);
+    for (u32 node = 0; node < 3; node++) EXPECT_EQ(isolated.Degree(node), 0);
+}
+
+TEST(GraphTest, WeightedCsrGraphKeepsWeightsBesideTargets) {
+    using Graph = aoc::WeightedCsrGraph<i64>;
+    const std::vector<Graph::Arc> arcs{{1, 2, 7}, {0, 1, -3}, {1, 0, 5}, {0, 2, 9}};
+    const Graph graph(3, arcs);
+    EXPECT_EQ(Neighbors(graph, 0), (std::vector<u32>{1, 2}));
+    EXPECT_EQ(Neighbors(graph, 1), (std::vector<u32>{2, 0}));
+    const auto weights0 = graph.Weights(0), weights1 = graph.Weights(1);
+    EXPECT_EQ(std::vector<i64>(weights0.begin(), weights0.end()), (std::vector<i64>{-3, 9}));
+    EXPECT_EQ(std::vector<i64>(weights1.begin(), weights1.end()), (std::vector<i64>{7, 5}));
+    EXPECT_TRUE(graph.Weights(2).empty());
+
+    const auto undirected = Graph::Undirected(3, std::vector<Graph::Arc>{{0, 1, 4}, {2, 1, 6}});
+    EXPECT_TRUE(undirected.IsSymmetric());
+    EXPECT_EQ(Neighbors(undirected, 1), (std::vector<u32>{0, 2}));
+    const auto weights = undirected.Weights(1);
+    EXPECT_EQ(std::vector<i64>(weights.begin(), weights.end()), (std::vector<i64>{4, 6}));
+}
+
+TEST(GraphTest, SubgraphKeepsTheChosenArcs) {
+    const auto graph = aoc::CsrGraph::Undirected(4, Arcs{{0, 1}, {1, 2}, {2, 3}, {3, 0}});
+    // Cut the edge 1-2, both ways.
+    const auto cut = graph.Subgraph([](const u32 from, const u32 to) {
+        return std::min(from, to) != 1 || std::max(from, to) != 2;
+    });
+    EXPECT_TRUE(cut.IsSymmetric());
+    EXPECT_EQ(cut.NumNodes(), 4);
+    EXPECT_EQ(cut.NumArcs(), 6);
+    EXPECT_EQ(Neighbors(cut, 1), std::vector<u32>{0});
+    EXPECT_EQ(Neighbors(cut, 2), std::vector<u32>{3});
+
+    const aoc::CsrGraph directed(3, Arcs{{0, 1}, {1, 2}, {2, 0}});
+    const auto forward = directed.Subgraph([](const u32 from, const u32 to) { return from < to; });
+    EXPECT_FALSE(forward.IsSymmetric());
+    EXPECT_EQ(forward.NumArcs(), 2);
+    EXPECT_EQ(Neighbors(forward, 2), std::vector<u32>{});
+}
+
+TEST(GraphTest, BfsDistancesOnSmallGraphs) {
+    // A path, from its middle.
+    const auto path = aoc::CsrGraph::Undirected(5, Arcs{{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+    EXPECT_EQ(aoc::BfsDistances(path, 2), (std::vector<u32>{2, 1, 0, 1, 2}));
+    // A directed graph, with a node the source can't reach.
+    const aoc::CsrGraph directed(4, Arcs{{0, 1}, {1, 2}, {2, 0}, {3, 0}});
+    constexpr u32 kUnreachable = aoc::CsrGraph::kUnreachable;
+    EXPECT_EQ(aoc::BfsDistances(directed, 1), (std::vector<u32>{2, 0, 1, kUnreachable}));
+    // A star, from its centre and from a leaf, undirected and directed.
+    Arcs star;
+    for (u32 leaf = 1; leaf < 100; leaf++) star.emplace_back(0, leaf);
+    const auto undirected_star = aoc::CsrGraph::Undirected(100, star);
+    EXPECT_EQ(aoc::BfsDistances(undirected_star, 5), QueueBfs(undirected_star, 5));
+    const aoc::CsrGraph directed_star(100, star);
+    EXPECT_EQ(aoc::BfsDistances(directed_star, 0), QueueBfs(directed_star, 0));
+    EXPECT_EQ(aoc::BfsDistances(directed_star, 5), QueueBfs(directed_star, 5));
+}
+
+// Graphs big enough that the middle levels go bottom-up, the tail top-down again, and the large
+// levels are split into chunks over the pool.
+TEST(GraphTest, BfsDistancesMatchesAQueueOnRandomGraphs) {
+    aoc::parallel::ThreadPool pool(4);
+    for (const u32 num_nodes : {1'000, 100'000}) {
+        const Arcs arcs = RandomArcs(num_nodes, 4 * num_nodes, num_nodes);
+        const auto undirected = aoc::CsrGraph::Undirected(num_nodes, arcs);
+        const aoc::CsrGraph directed(num_nodes, arcs);
+        for (const u32 source : {0u, num_nodes / 2}) {
+            EXPECT_EQ(aoc::BfsDistances(pool, undirected, source), QueueBfs(undirected, source));
+            EXPECT_EQ(aoc::BfsDistances(pool, directed, source), QueueBfs(directed, source));
+            EXPECT_EQ(aoc::BfsDistances(undirected, source), QueueBfs(undirected, source));
+        }
+    }
+}
+
+TEST(GraphTest, ConnectedComponents) {
+    // {0, 2, 5}, {1}, {3, 4} and {6}, numbered by their smallest nodes.
+    const auto graph = aoc::CsrGraph::Undirected(7, Arcs{{5, 2}, {0, 5}, {4, 3}});
+    const aoc::Components components = aoc::ConnectedComponents(graph);
+    EXPECT_EQ(components.of, (std::vector<u32>{0, 1, 0, 2, 2, 0, 3}));
+    EXPECT_EQ(components.sizes, (std::vector<u32>{3, 1, 2, 1}));
+    // A directed graph's are the weakly connected ones.
+    const aoc::CsrGraph directed(4, Arcs{{3, 1}, {2, 1}});
+    EXPECT_EQ(aoc::ConnectedComponents(directed).of, (std::vector<u32>{0, 1, 1, 1}));
+    EXPECT_TRUE(aoc::ConnectedComponents(aoc::CsrGraph{}).sizes.empty());
+}
+
+TEST(GraphTest, ConnectedComponentsMatchesBfs) {
+    const u32 num_nodes = 10'000;
+    const auto graph = aoc::CsrGraph::Undirected(num_nodes, RandomArcs(num_nodes, num_nodes / 2, 1));
+    // One search from every node not labelled yet, in node order, numbers the components the same.
+    aoc::Components expected{std::vector<u32>(num_nodes, aoc::CsrGraph::kUnreachable), {}};
+    for (u32 node = 0; node < num_nodes; node++) {
+        if (expected.of[node] != aoc::CsrGraph::kUnreachable) continue;
+        const std::vector<u32> distances = QueueBfs(graph, node);
+        expected.sizes.push_back(0);
+        for (u32 other = node; other < num_nodes; other++) {
+            if (distances[other] == aoc::CsrGraph::kUnreachable) continue;
+            expected.of[other] = expected.sizes.size() - 1;
+            expected.sizes.back()++;
+        }
+    }
+    const aoc::Components components = aoc::ConnectedComponents(graph);
+    EXPECT_EQ(components.of, expected.of);
+    EXPECT_EQ(components.sizes, expected.sizes);
+}
+
+TEST(GraphTest, TopologicalOrder) {
+    // Kahn's algorithm from the sources in node order: 3 and 4 first.
+    const aoc::CsrGraph dag(6, Arcs{{3, 1}, {4, 0}, {4, 1}, {1, 2}, {0, 2}, {2, 5}});
+    EXPECT_EQ(aoc::TopologicalOrder(dag), (std::vector<u32>{3, 4, 0, 1, 2, 5}));
+    EXPECT_EQ(aoc::TopologicalOrder(aoc::CsrGraph{}), std::vector<u32>{});
+    // A cycle, a self-loop, and an undirected edge are all cycles.
+    EXPECT_EQ(aoc::TopologicalOrder(aoc::CsrGraph(4, Arcs{{0, 1}, {1, 2}, {2, 3}, {3, 1}})),
+              std::nullopt);
+    EXPECT_EQ(aoc::TopologicalOrder(aoc::CsrGraph(2, Arcs{{0, 1}, {1, 1}})), std::nullopt);
+    EXPECT_EQ(aoc::TopologicalOrder(aoc::CsrGraph::Undirected(2, Arcs{{0, 1}})), std::nullopt);
+}
+
+TEST(GraphTest, TopologicalOrderOfARandomDag) {
+    const u32 num_nodes = 5'000;
+    Arcs arcs = RandomArcs(num_nodes, 4 * num_nodes, 2);
+    // Arcs from lower to higher nodes can't form a cycle; one arc back makes one.
+    std::erase_if(arcs, [](const auto& arc) { return arc.first >= arc.second; });
+    const auto order = aoc::TopologicalOrder(aoc::CsrGraph(num_nodes, arcs));
+    ASSERT_TRUE(order.has_value());
+    ASSERT_EQ(order->size(), num_nodes);
+    std::vector<u32> position(num_nodes);
+    for (u32 i = 0; i < num_nodes; i++) position[(*order)[i]] = i;
+    for (const auto& [from, to] : arcs) EXPECT_LT(position[from], position[to]);
+
+    const auto [from, to] = arcs.front();
+    arcs.emplace_back(to, from);
+    EXPECT_EQ(aoc::TopologicalOrder(aoc::CsrGraph(num_nodes, arcs)), std::nullopt);
+}
@@ -0,0 +1,315 @@
+#include "aoc_tests.h"
+
+namespace {
+
+constexpr std::string_view kMap =
+    "#.#\n"
+    "..S\n"
+    "#..\n"
+    ".#.";
+
+}  // namespace
+
+TEST(GridTest, FillAndBorder) {
+    const aoc::Grid<int> grid(2, 3, 7, 1, -1);
+    EXPECT_EQ(grid.Height(), 2);
+    EXPECT_EQ(grid.Width(), 3);
+    EXPECT_EQ(grid.Border(), 1);
+    EXPECT_EQ(grid.Stride(), 5);
+    EXPECT_EQ(grid.Size(), 4 * 5);
+    for (i64 i = -1; i <= 2; i++) {
+        for (i64 j = -1; j <= 3; j++) {
+            const aoc::Pos pos{i, j};
+            EXPECT_EQ(grid[pos], grid.Contains(pos) ? 7 : -1) << pos.toString();
+            EXPECT_EQ(grid.ToPos(grid.Index(pos)), pos);
+        }
+    }
+    EXPECT_EQ(grid.Index(0, 0), 6);
+    EXPECT_EQ(grid.Find(7), 6);
+    EXPECT_EQ(grid.Find(-1), 0);
+    EXPECT_EQ(grid.Find(8), -1);
+}
+
+TEST(GridTest, OffsetsMatchTheDirections) {
+    const aoc::Grid<char> grid(5, 4, '.', 1, '#');
+    const i64 center = grid.Index(2, 2);
+    const auto offsets = grid.Offsets();
+    for (u32 d = 0; d < aoc::kAllDirs.size(); d++) {
+        const aoc::Dir dir = aoc::kAllDirs[d];
+        EXPECT_EQ(grid.Offset(dir), offsets[d]);
+        EXPECT_EQ(grid.ToPos(center + offsets[d]), aoc::Pos(2, 2) + aoc::MoveDir(dir));
+    }
+    const auto offsets8 = grid.Offsets8();
+    for (u32 d = 0; d < aoc::kAllDir8s.size(); d++) {
+        const aoc::Dir8 dir = aoc::kAllDir8s[d];
+        EXPECT_EQ(grid.Offset(dir), offsets8[d]);
+        EXPECT_EQ(grid.ToPos(center + offsets8[d]), aoc::Pos(2, 2) + aoc::MoveDir8(dir));
+    }
+    // The neighbours of a corner outside the map are in the border.
+    for (const i64 offset : offsets8) {
+        const i64 neighbour = grid.Index(0, 0) + offset;
+        EXPECT_EQ(grid[neighbour], grid.Contains(grid.ToPos(neighbour)) ? '.' : '#');
+    }
+}
+
+TEST(GridTest, ParsesAnInput) {
+    const aoc::Grid<int> grid(kMap, [](const char c) { return c == '#' ? 1 : 0; }, 1, 2);
+    EXPECT_EQ(grid.Height(), 4);
+    EXPECT_EQ(grid.Width(), 3);
+    EXPECT_EQ(fmt::format("{}", grid), "101\n000\n100\n010");
+    EXPECT_EQ(grid[grid.Index(-1, -1)], 2);
+    EXPECT_EQ(grid[grid.Index(4, 3)], 2);
+    EXPECT_EQ(std::vector<int>(grid.Row(3).begin(), grid.Row(3).end()), (std::vector<int>{0, 1, 0}));
+}
+
+TEST(GridTest, ViewsAnInputInPlace) {
+    const std::string input = std::string(kMap) + '\n';
+    const aoc::Grid<const char> grid(input);
+    EXPECT_EQ(grid.Height(), 4);
+    EXPECT_EQ(grid.Width(), 3);
+    // The '\n' at the end of each line is the eastern border.
+    EXPECT_EQ(grid.Stride(), 4);
+    EXPECT_EQ(grid.Size(), static_cast<i64>(input.size()));
+    EXPECT_EQ(&grid[0], input.data());
+    EXPECT_EQ(grid.ToPos(grid.Find('S')), aoc::Pos(1, 2));
+    EXPECT_EQ(grid[grid.Find('S') + grid.Offset(aoc::Dir::E)], '\n');
+    EXPECT_EQ(fmt::format("{}", grid), kMap);
+    // Copies view the same input.
+    const aoc::Grid<const char> copy = grid;
+    EXPECT_EQ(&copy[0], input.data());
+}
+
+TEST(GridTest, ViewsKeepTheLastRowsBorder) {
+    const std::string input = std::string(kMap) + '\n';
+    const aoc::Grid<const char> grid(input);
+    // East of every cell of the last row, the last column included, is still in the view.
+    for (i64 j = 0; j < grid.Width(); j++) {
+        const i64 east = grid.Index(3, j) + grid.Offset(aoc::Dir::E);
+        ASSERT_LT(east, grid.Size());
+        EXPECT_EQ(grid[east], j + 1 < grid.Width() ? kMap[3 * 4 + j + 1] : '\n');
+    }
+    EXPECT_EQ(grid.Index(3, grid.Width()), grid.Size() - 1);
+    // South of the last row is outside the map, and outside the view.
+    EXPECT_FALSE(grid.Contains(aoc::Pos(3, 0) + aoc::MoveDir(aoc::Dir::S)));
+}
+
+TEST(GridTest, CopiesOwnTheirCells) {
+    aoc::Grid<char> grid(kMap, [](const char c) { return c; });
+    aoc::Grid<char> copy = grid;
+    copy[aoc::Pos(0, 1)] = 'x';
+    EXPECT_EQ(grid[aoc::Pos(0, 1)], '.');
+    EXPECT_EQ(copy[aoc::Pos(0, 1)], 'x');
+    // Moved and assigned grids keep their cells.
+    aoc::Grid<char> moved = std::move(copy);
+    EXPECT_EQ(moved[aoc::Pos(0, 1)], 'x');
+    grid = moved;
+    moved[aoc::Pos(0, 1)] = 'y';
+    EXPECT_EQ(grid[aoc::Pos(0, 1)], 'x');
+    EXPECT_EQ(fmt::format("{}", grid), "#x#\n..S\n#..\n.#.");
+}
+
+TEST(GridDeathTest, RejectsRaggedInput) {
+    EXPECT_DEATH(aoc::Grid<const char>("ab\nc\n"), "Ragged grid input");
+    EXPECT_DEATH(aoc::Grid<const char>("ab\ncd"), "trailing");
+    EXPECT_DEATH(aoc::Grid<char>(std::string_view("ab\nabc"), [](const char c) { return c; }),
+                 "Ragged grid input");
+}
+
+TEST(DirTest, TablesMatchTheDirections) {
+    EXPECT_EQ(aoc::MoveDir(aoc::Dir::N), aoc::Pos(-1, 0));
+    EXPECT_EQ(aoc::MoveDir(aoc::Dir::E), aoc::Pos(0, 1));
+    EXPECT_EQ(aoc::MoveDir(aoc::Dir::S), aoc::Pos(1, 0));
+    EXPECT_EQ(aoc::MoveDir(aoc::Dir::W), aoc::Pos(0, -1));
+    for (u32 d = 0; d < aoc::kAllDirs.size(); d++) {
+        const aoc::Dir dir = aoc::kAllDirs[d];
+        EXPECT_EQ(aoc::DirIndex(dir), d);
+        EXPECT_EQ(aoc::ParseDir(aoc::ToUnderlying(dir)), dir);
+        EXPECT_EQ(fmt::format("{}", dir), std::string(1, aoc::ToUnderlying(dir)));
+        // Turning right goes clockwise, and every turn is undone by the other one.
+        const aoc::Pos move = aoc::MoveDir(dir);
+        EXPECT_EQ(aoc::MoveDir(aoc::TurnRight(dir)), aoc::Pos(move.j, -move.i));
+        EXPECT_EQ(aoc::MoveDir(aoc::TurnLeft(dir)), aoc::Pos(-move.j, move.i));
+        EXPECT_EQ(aoc::MoveDir(aoc::OppositeDir(dir)), move * -1);
+        EXPECT_EQ(aoc::TurnLeft(aoc::TurnRight(dir)), dir);
+        EXPECT_EQ(aoc::TurnRight(aoc::TurnRight(dir)), aoc::OppositeDir(dir));
+        // Dir and Dir8 share the characters of the four main directions.
+        EXPECT_EQ(aoc::MoveDir8(static_cast<aoc::Dir8>(dir)), move);
+    }
+    for (u32 d = 0; d < aoc::kAllDir8s.size(); d++) {
+        const aoc::Dir8 dir = aoc::kAllDir8s[d];
+        EXPECT_EQ(aoc::Dir8Index(dir), d);
+        // King's moves, each an eighth of a turn clockwise from the last. Rows grow downwards, so
+        // clockwise is a negative cross product.
+        const aoc::Pos move = aoc::MoveDir8(dir), next = aoc::MoveDir8(aoc::kAllDir8s[(d + 1) % 8]);
+        EXPECT_EQ(std::max(std::abs(move.i), std::abs(move.j)), 1);
+        EXPECT_EQ(std::abs(next.i - move.i) + std::abs(next.j - move.j), 1);
+        EXPECT_EQ(move.i * next.j - move.j * next.i, -1);
+    }
+}
+
+TEST(DirDeathTest, RejectsUnknownDirections) {
+    EXPECT_DEATH(aoc::ParseDir('x'), "Unknown Dir representation 'x'");
+}
+
+TEST(PackedPosTest, RoundTripsAndOrdersLikePos) {
+    const std::vector<aoc::Pos> positions{
+        {0, 0}, {-1, 0}, {0, -1}, {1, -1}, {-1, 1}, {32767, -32768}, {-32768, 32767}, {140, 7}};
+    for (const aoc::Pos& a : positions) {
+        const aoc::PackedPos packed(a);
+        EXPECT_EQ(packed.ToPos(), a);
+        EXPECT_EQ(packed.toString(), fmt::format("{},{}", a.i, a.j));
+        for (const aoc::Pos& b : positions) {
+            const aoc::PackedPos other(b);
+            EXPECT_EQ(packed == other, a == b);
+            EXPECT_EQ(packed < other, a < b);
+            // Bits() differ exactly when the positions do, which is all the hash relies on.
+            EXPECT_EQ(packed.Bits() == other.Bits(), a == b);
+        }
+    }
+    const aoc::PackedPos a(3, -4), b(-5, 6);
+    EXPECT_EQ((a + b).ToPos(), aoc::Pos(-2, 2));
+    EXPECT_EQ((a - b).ToPos(), aoc::Pos(8, -10));
+    EXPECT_EQ((a * 3).ToPos(), aoc::Pos(9, -12));
+    EXPECT_EQ(aoc::PackedPos(-1, -1).Bits(), 0xFFFFFFFFu);
+    EXPECT_EQ(aoc::PackedPos(1, 2).Bits(), 0x00010002u);
+}
+
+TEST(PackedPosTest, KeysHashSets) {
+    absl::flat_hash_set<aoc::PackedPos> set;
+    for (i16 i = -20; i < 20; i++) {
+        for (i16 j = -20; j < 20; j++) set.insert({i, j});
+    }
+    EXPECT_EQ(set.size(), 40 * 40);
+    EXPECT_TRUE(set.contains(aoc::PackedPos(aoc::Pos(-20, 19))));
+    EXPECT_FALSE(set.contains(aoc::PackedPos(20, 0)));
+}
+
+TEST(PackedPosDeathTest, RejectsPosOutOfRange) {
+    EXPECT_DEBUG_DEATH(aoc::PackedPos(aoc::Pos(32768, 0)), "doesn't fit");
+    EXPECT_DEBUG_DEATH(aoc::PackedPos(aoc::Pos(0, -32769)), "doesn't fit");
+}
+
+TEST(GridBitsetTest, InsertEraseAndCount) {
+    aoc::GridBitset<> set(200);
+    EXPECT_EQ(set.Count(), 0);
+    // Both ends and both sides of a word boundary.
+    for (const i64 index : {0, 63, 64, 199}) {
+        EXPECT_FALSE(set.Contains(index));
+        EXPECT_TRUE(set.Insert(index));
+        EXPECT_FALSE(set.Insert(index));
+        EXPECT_TRUE(set.Contains(index));
+    }
+    EXPECT_EQ(set.Count(), 4);
+    EXPECT_FALSE(set.Contains(1));
+    EXPECT_FALSE(set.Contains(65));
+    set.Erase(63);
+    set.Erase(63);
+    set.Erase(62);
+    EXPECT_EQ(set.Count(), 3);
+    EXPECT_FALSE(set.Contains(63));
+    EXPECT_TRUE(set.Contains(64));
+    set.Clear();
+    EXPECT_EQ(set.Count(), 0);
+    for (i64 index = 0; index < 200; index++) EXPECT_FALSE(set.Contains(index)) << index;
+    // A word first written after the Clear() doesn't bring back its old bits.
+    EXPECT_TRUE(set.Insert(65));
+    EXPECT_FALSE(set.Contains(64));
+    EXPECT_TRUE(set.Insert(64));
+}
+
+TEST(GridBitsetTest, KeysDirectionsApart) {
+    aoc::GridBitset<4> set(10);
+    EXPECT_TRUE(set.Insert(3, aoc::Dir::E));
+    EXPECT_TRUE(set.Insert(3, aoc::Dir::W));
+    EXPECT_FALSE(set.Insert(3, aoc::DirIndex(aoc::Dir::E)));
+    EXPECT_TRUE(set.Contains(3, aoc::Dir::E));
+    EXPECT_FALSE(set.Contains(3, aoc::Dir::N));
+    EXPECT_FALSE(set.Contains(2, aoc::Dir::E));
+    EXPECT_FALSE(set.Contains(4, aoc::Dir::E));
+    set.Erase(3, aoc::Dir::E);
+    EXPECT_FALSE(set.Contains(3, aoc::Dir::E));
+    EXPECT_TRUE(set.Contains(3, aoc::Dir::W));
+    EXPECT_EQ(set.Count(), 1);
+    // The last pair of the last cell.
+    EXPECT_TRUE(set.Insert(9, aoc::Dir::W));
+    EXPECT_EQ(set.Count(), 2);
+}
+
+TEST(GridBitsetTest, EpochsWrapAround) {
+    aoc::GridBitset<1, u8> set(128);
+    set.Insert(0);
+    set.Insert(100);
+    // Every epoch up to the wrap-around, where word 0 would read as written again.
+    for (int i = 0; i < 255; i++) {
+        set.Clear();
+        EXPECT_FALSE(set.Contains(0)) << "clear " << i;
+        set.Insert(100);
+    }
+    set.Clear();
+    EXPECT_EQ(set.Count(), 0);
+    EXPECT_FALSE(set.Contains(0));
+    EXPECT_FALSE(set.Contains(100));
+    set.Insert(1);
+    EXPECT_FALSE(set.Contains(0));
+    for (int i = 0; i < 1000; i++) {
+        set.Clear();
+        EXPECT_FALSE(set.Contains(1)) << "clear " << i;
+        EXPECT_TRUE(set.Insert(i % 128)) << "clear " << i;
+        EXPECT_EQ(set.Count(), 1);
+    }
+}
+
+TEST(GridStateArrayTest, ReadsDefaultUntilWritten) {
+    aoc::GridStateArray<std::string> array(5);
+    EXPECT_EQ(array.Size(), 5);
+    EXPECT_FALSE(array.Contains(2));
+    EXPECT_EQ(array.Find(2), nullptr);
+    array(2) = "two";
+    array(4) += "four";
+    EXPECT_TRUE(array.Contains(2));
+    ASSERT_NE(array.Find(2), nullptr);
+    EXPECT_EQ(*array.Find(2), "two");
+    EXPECT_EQ(*array.Find(4), "four");
+    EXPECT_EQ(array.Find(3), nullptr);
+    array.Clear();
+    EXPECT_FALSE(array.Contains(2));
+    EXPECT_EQ(array.Find(4), nullptr);
+    EXPECT_EQ(array.Size(), 5);
+    // Stale values are reset to T{} on first write.
+    EXPECT_EQ(array(2), "");
+    array(2) += "again";
+    EXPECT_EQ(*array.Find(2), "again");
+}
+
+TEST(GridStateArrayTest, KeysDirectionsApart) {
+    aoc::GridStateArray<int, 4> array(3);
+    EXPECT_EQ(array.Size(), 3);
+    array(1, aoc::Dir::N) = 10;
+    array(1, aoc::Dir::S) = 20;
+    EXPECT_EQ(*array.Find(1, aoc::Dir::N), 10);
+    EXPECT_EQ(*array.Find(1, aoc::DirIndex(aoc::Dir::S)), 20);
+    EXPECT_FALSE(array.Contains(1, aoc::Dir::E));
+    EXPECT_FALSE(array.Contains(0, aoc::Dir::S));
+    EXPECT_FALSE(array.Contains(2, aoc::Dir::N));
+    array(2, aoc::Dir::W) = 30;
+    EXPECT_EQ(*array.Find(2, aoc::Dir::W), 30);
+}
+
+TEST(GridStateArrayTest, EpochsWrapAround) {
+    aoc::GridStateArray<int, 1, u8> array(4);
+    array(0) = 7;
+    for (int i = 0; i < 255; i++) {
+        array.Clear();
+        EXPECT_EQ(array.Find(0), nullptr) << "clear " << i;
+        array(1) = i;
+    }
+    array.Clear();
+    EXPECT_FALSE(array.Contains(0));
+    EXPECT_FALSE(array.Contains(1));
+    EXPECT_EQ(array(0), 0);
+    for (int i = 0; i < 1000; i++) {
+        array(i % 4) = i;
+        array.Clear();
+        for (i64 index = 0; index < 4; index++) EXPECT_FALSE(array.Contains(index)) << "clear " << i;
+    }
+}
@@ -0,0 +1,173 @@
+#include "aoc_tests.h"
+
+#include <aoc_parallel.h>
+
+namespace {
+
+// "[begin,end)" for every chunk, folded left to right.
+std::string Ranges(aoc::parallel::ThreadPool& pool, const i64 n, const i64 grain) {
+    return aoc::parallel::ParallelReduce(
+        pool, n, grain, std::string(),
+        [](const i64 begin, const i64 end) { return fmt::format("[{},{})", begin, end); },
+        [](std::string a, const std::string& b) { return a + b; });
+}
+
+// Sum of the indices in [begin, end).
+i64 SumRange(const i64 begin, const i64 end) { return (begin + end - 1) * (end - begin) / 2; }
+
+i64 ParallelSum(aoc::parallel::ThreadPool& pool, const i64 n, const i64 grain) {
+    return aoc::parallel::ParallelReduce(pool, n, grain, i64{0}, SumRange, std::plus<>());
+}
+
+}  // namespace
+
+TEST(ThreadPoolTest, RunsEverySubmittedTask) {
+    aoc::parallel::ThreadPool pool(4);
+    EXPECT_EQ(pool.NumThreads(), 4);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 10'000; i++) pool.Submit([&] { count++; });
+    pool.Wait();
+    EXPECT_EQ(count, 10'000);
+    // Tasks submitted by tasks are waited for too.
+    count = 0;
+    for (int i = 0; i < 100; i++) {
+        pool.Submit([&] {
+            for (int j = 0; j < 10; j++) pool.Submit([&] { count++; });
+            count++;
+        });
+    }
+    pool.Wait();
+    EXPECT_EQ(count, 1100);
+    // Nothing left to wait for.
+    pool.Wait();
+}
+
+TEST(ThreadPoolTest, HasAtLeastOneThread) {
+    aoc::parallel::ThreadPool pool(0);
+    EXPECT_EQ(pool.NumThreads(), 1);
+    bool ran = false;
+    pool.Submit([&] { ran = true; });
+    pool.Wait();
+    EXPECT_TRUE(ran);
+    EXPECT_EQ(&aoc::parallel::DefaultPool(), &aoc::parallel::DefaultPool());
+}
+
+TEST(ThreadPoolDeathTest, RejectsWaitFromAWorker) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    EXPECT_DEATH(
+        {
+            aoc::parallel::ThreadPool pool(2);
+            pool.Submit([&] { pool.Wait(); });
+            pool.Wait();
+        },
+        "called from one of its own workers");
+}
+
+TEST(ForEachChunkTest, RunsEveryChunkOnce) {
+    for (const u32 threads : {1, 3, 8}) {
+        aoc::parallel::ThreadPool pool(threads);
+        for (const i64 num_chunks : {-1, 0, 1, 2, 7, 1000}) {
+            std::vector<std::atomic<int>> runs(std::max<i64>(num_chunks, 0));
+            aoc::parallel::ForEachChunk(pool, num_chunks, [&](const i64 chunk) { runs[chunk]++; });
+            for (i64 chunk = 0; chunk < num_chunks; chunk++) {
+                EXPECT_EQ(runs[chunk], 1) << threads << " threads, " << chunk << "/" << num_chunks;
+            }
+        }
+    }
+}
+
+TEST(ForEachChunkTest, SingleThreadPoolRunsOnTheCaller) {
+    aoc::parallel::ThreadPool pool(1);
+    const std::thread::id caller = std::this_thread::get_id();
+    aoc::parallel::ForEachChunk(pool, 100, [&](const i64) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+    });
+}
+
+TEST(ParallelForTest, CoversEveryIndexOnce) {
+    aoc::parallel::ThreadPool pool(4);
+    for (const i64 n : {0, 1, 7, 1000}) {
+        // A grain of 0 or less counts as 1.
+        for (const i64 grain : {-3, 0, 1, 3, 1000, 5000}) {
+            const i64 size = std::max<i64>(grain, 1);
+            std::vector<std::atomic<int>> hits(n);
+            std::atomic<int> chunks{0};
+            aoc::parallel::ParallelFor(pool, n, grain, [&](const i64 begin, const i64 end) {
+                EXPECT_EQ(begin % size, 0);
+                EXPECT_EQ(end, std::min(n, begin + size));
+                for (i64 i = begin; i < end; i++) hits[i]++;
+                chunks++;
+            });
+            for (i64 i = 0; i < n; i++) EXPECT_EQ(hits[i], 1) << "n " << n << ", grain " << grain;
+            EXPECT_EQ(chunks, (n + size - 1) / size);
+        }
+    }
+    // The same on the default pool.
+    std::vector<std::atomic<int>> hits(500);
+    aoc::parallel::ParallelFor(500, 7, [&](const i64 begin, const i64 end) {
+        for (i64 i = begin; i < end; i++) hits[i]++;
+    });
+    for (i64 i = 0; i < 500; i++) EXPECT_EQ(hits[i], 1) << i;
+}
+
+TEST(ParallelReduceTest, FoldsInIndexOrder) {
+    aoc::parallel::ThreadPool pool1(1), pool2(2), pool4(4), pool8(8);
+    EXPECT_EQ(Ranges(pool4, 10, 3), "[0,3)[3,6)[6,9)[9,10)");
+    for (const i64 grain : {1, 2, 5, 64}) {
+        const std::string expected = Ranges(pool1, 1000, grain);
+        EXPECT_EQ(Ranges(pool2, 1000, grain), expected);
+        EXPECT_EQ(Ranges(pool4, 1000, grain), expected);
+        EXPECT_EQ(Ranges(pool8, 1000, grain), expected);
+    }
+    // Nor is floating-point subtraction: the fold matches a sequential loop bit for bit.
+    double expected = 1e6;
+    for (i64 i = 0; i < 1000; i += 10) expected -= 1.0 / (i + 1);
+    for (aoc::parallel::ThreadPool* pool : {&pool1, &pool2, &pool4, &pool8}) {
+        const double result = aoc::parallel::ParallelReduce(
+            *pool, 1000, 10, 1e6, [](const i64 begin, i64) { return 1.0 / (begin + 1); },
+            [](const double a, const double b) { return a - b; });
+        EXPECT_EQ(result, expected) << pool->NumThreads() << " threads";
+    }
+}
+
+TEST(ParallelReduceTest, EmptyAndSingleChunks) {
+    aoc::parallel::ThreadPool pool(4);
+    bool called = false;
+    const auto chunk = [&](const i64, const i64) {
+        called = true;
+        return 1;
+    };
+    EXPECT_EQ(aoc::parallel::ParallelReduce(pool, 0, 10, 42, chunk, std::plus<>()), 42);
+    EXPECT_EQ(aoc::parallel::ParallelReduce(pool, -5, 10, 42, chunk, std::plus<>()), 42);
+    EXPECT_FALSE(called);
+    // A grain past n makes a single chunk.
+    EXPECT_EQ(Ranges(pool, 5, 100), "[0,5)");
+    EXPECT_EQ(Ranges(pool, 5, 5), "[0,5)");
+    EXPECT_EQ(Ranges(pool, 3, 0), "[0,1)[1,2)[2,3)");
+    // The same on the default pool.
+    EXPECT_EQ(aoc::parallel::ParallelReduce(100, 7, i64{0}, SumRange, std::plus<>()), 4950);
+}
+
+TEST(ParallelReduceTest, NestedInsideWorkers) {
+    // Every outer chunk runs an inner loop on the same, fully busy pool.
+    aoc::parallel::ThreadPool pool(4);
+    const i64 total = aoc::parallel::ParallelReduce(
+        pool, 64, 1, i64{0},
+        [&](const i64 begin, i64) {
+            const i64 inner = ParallelSum(pool, 1000, 10);
+            aoc::parallel::ParallelFor(pool, 100, 1, [&](const i64 b, const i64 e) {
+                EXPECT_EQ(ParallelSum(pool, 10, 1), 45);
+                EXPECT_EQ(e - b, 1);
+            });
+            return inner + begin;
+        },
+        std::plus<>());
+    EXPECT_EQ(total, 64 * 499'500 + 64 * 63 / 2);
+    // And from tasks submitted to the pool directly.
+    std::atomic<i64> from_tasks{0};
+    for (int t = 0; t < 8; t++) {
+        pool.Submit([&] { from_tasks += ParallelSum(pool, 1000, 3); });
+    }
+    pool.Wait();
+    EXPECT_EQ(from_tasks, 8 * 499'500);
+}
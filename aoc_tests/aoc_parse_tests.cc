@@ -0,0 +1,125 @@
+#include "aoc_tests.h"
+
+#include <random>
+
+namespace {
+
+template<std::integral T>
+std::vector<T> Scan(const std::string_view input, const char separator = ' ') {
+    std::vector<T> list;
+    aoc::util::FasterScanList(input, list, separator);
+    return list;
+}
+
+// The first eight bytes of `input`, loaded the way FasterScanList loads them.
+u64 Chunk(const std::string_view input) {
+    return aoc::util::LoadEightBytes(input.data(), input.data() + input.size());
+}
+
+}  // namespace
+
+TEST(ParseTest, CountLeadingDigitsStopsAtEveryNonDigit) {
+    for (int c = 0; c < 256; c++) {
+        const std::string input{static_cast<char>(c), '7'};
+        const u32 expected = (c >= '0' && c <= '9') ? 2 : 0;
+        EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk(input)), expected) << "byte " << c;
+    }
+    EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk("")), 0);
+    EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk("1234")), 4);
+    EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk("12345678")), 8);
+    EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk("123456789")), 8);
+    EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk("99/99")), 2);
+    EXPECT_EQ(aoc::util::CountLeadingDigits(Chunk("000:0")), 3);
+}
+
+TEST(ParseTest, ParseLeadingDigitsOfEveryLength) {
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("0"), 1), 0);
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("7 "), 1), 7);
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("42,"), 2), 42);
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("00123"), 5), 123);
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("1234567 9"), 7), 1234567);
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("99999999"), 8), 99999999);
+    EXPECT_EQ(aoc::util::ParseLeadingDigits(Chunk("123456789"), 8), 12345678);
+}
+
+TEST(ParseTest, NumbersOfOneToTwentyDigits) {
+    std::string input;
+    std::vector<u64> expected;
+    for (u32 digits = 1; digits <= 20; digits++) {
+        // All nines, then one and zeros, for every length.
+        const u64 nines = digits == 20 ? std::numeric_limits<u64>::max() : aoc::kTenPowers[digits] - 1;
+        const u64 power = aoc::kTenPowers[digits - 1];
+        input += fmt::format("{} {} ", nines, power);
+        expected.insert(expected.end(), {nines, power});
+    }
+    EXPECT_EQ(Scan<u64>(input), expected);
+}
+
+TEST(ParseTest, RandomNumbersRoundTrip) {
+    std::mt19937_64 rng(1);
+    std::string input;
+    std::vector<i64> expected;
+    for (int i = 0; i < 10000; i++) {
+        const i64 value = static_cast<i64>(rng()) >> (rng() % 64);
+        input += fmt::format("{}  ", value);
+        expected.push_back(value);
+    }
+    EXPECT_EQ(Scan<i64>(input), expected);
+}
+
+TEST(ParseTest, NegativeNumbers) {
+    EXPECT_EQ(Scan<i32>("-1 2 -30 -0"), (std::vector<i32>{-1, 2, -30, 0}));
+    EXPECT_EQ(Scan<i64>("-123456789012"), std::vector<i64>{-123456789012});
+}
+
+TEST(ParseTest, LimitsOfEveryType) {
+    EXPECT_EQ(Scan<i64>("-9223372036854775808 9223372036854775807"),
+              (std::vector<i64>{std::numeric_limits<i64>::min(), std::numeric_limits<i64>::max()}));
+    EXPECT_EQ(Scan<u64>("0 18446744073709551615"),
+              (std::vector<u64>{0, std::numeric_limits<u64>::max()}));
+    EXPECT_EQ(Scan<i128>("-170141183460469231731687303715884105728 "
+                         "170141183460469231731687303715884105727"),
+              (std::vector<i128>{std::numeric_limits<i128>::min(), std::numeric_limits<i128>::max()}));
+    EXPECT_EQ(Scan<u128>("340282366920938463463374607431768211455"),
+              std::vector<u128>{std::numeric_limits<u128>::max()});
+    EXPECT_EQ(Scan<u8>("0 255"), (std::vector<u8>{0, 255}));
+    EXPECT_EQ(Scan<i8>("-128 127"), (std::vector<i8>{-128, 127}));
+}
+
+TEST(ParseTest, SeparatorRunsAndEmptyInput) {
+    EXPECT_TRUE(Scan<i32>("").empty());
+    EXPECT_TRUE(Scan<i32>("   ").empty());
+    EXPECT_EQ(Scan<i32>("1"), std::vector<i32>{1});
+    EXPECT_EQ(Scan<i32>("  1    2 "), (std::vector<i32>{1, 2}));
+    EXPECT_EQ(Scan<i32>("3 4 "), (std::vector<i32>{3, 4}));
+}
+
+TEST(ParseTest, AppendsToTheList) {
+    std::vector<i32> list{5};
+    aoc::util::FasterScanList(std::string_view("6 7"), list);
+    EXPECT_EQ(list, (std::vector<i32>{5, 6, 7}));
+}
+
+// The separator of 2025/08's coordinates.
+TEST(ParseTest, CommaSeparator) {
+    EXPECT_EQ(Scan<i64>("162,817,812", ','), (std::vector<i64>{162, 817, 812}));
+    EXPECT_EQ(Scan<i64>("1,,2,", ','), (std::vector<i64>{1, 2}));
+}
+
+TEST(ParseDeathTest, RejectsMalformedNumbers) {
+    EXPECT_DEATH(Scan<i32>("-"), "Couldn't parse '-'");
+    EXPECT_DEATH(Scan<i32>("1 - 2"), "Couldn't parse '-'");
+    EXPECT_DEATH(Scan<u32>("-1"), "Couldn't parse");
+    EXPECT_DEATH(Scan<i32>("12a"), "Couldn't parse");
+    EXPECT_DEATH(Scan<i32>("1,2"), "Couldn't parse");
+}
+
+TEST(ParseDeathTest, RejectsOverflow) {
+    EXPECT_DEATH(Scan<i64>("9223372036854775808"), "Out of range");
+    EXPECT_DEATH(Scan<i64>("-9223372036854775809"), "Out of range");
+    EXPECT_DEATH(Scan<u64>("18446744073709551616"), "Out of range");
+    EXPECT_DEATH(Scan<u64>("100000000000000000000"), "Out of range");
+    EXPECT_DEATH(Scan<u128>("340282366920938463463374607431768211456"), "Out of range");
+    EXPECT_DEATH(Scan<i32>("2147483648"), "Out of range");
+    EXPECT_DEATH(Scan<u8>("256"), "Out of range");
+}
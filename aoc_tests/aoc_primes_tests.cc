@@ -0,0 +1,139 @@
+#include "aoc_tests.h"
+
+#include <aoc_primes.h>
+
+#include <random>
+
+namespace {
+
+using Factors = std::vector<std::pair<u64, u32>>;
+
+// Sieve of Eratosthenes over every number below `limit`.
+std::vector<u64> NaivePrimes(const u64 limit) {
+    std::vector<bool> composite(limit, false);
+    std::vector<u64> primes;
+    for (u64 n = 2; n < limit; n++) {
+        if (composite[n]) continue;
+        primes.push_back(n);
+        for (u64 m = n * n; m < limit; m += n) composite[m] = true;
+    }
+    return primes;
+}
+
+// Trial division by every number up to sqrt(n), so only for `n` below about 2^44.
+Factors NaiveFactorize(u64 n) {
+    Factors factors;
+    for (u64 d = 2; d * d <= n; d++) {
+        if (n % d != 0) continue;
+        factors.emplace_back(d, 0);
+        for (; n % d == 0; n /= d) factors.back().second++;
+    }
+    if (n > 1) factors.emplace_back(n, 1);
+    return factors;
+}
+
+bool NaiveIsPrime(const u64 n) {
+    const Factors factors = NaiveFactorize(n);
+    return factors.size() == 1 && factors[0].second == 1;
+}
+
+// The largest primes below 2^32, and the largest below 2^64.
+constexpr u64 kPrime32a = 4294967291;
+constexpr u64 kPrime32b = 4294967279;
+constexpr u64 kPrime64 = 18446744073709551557u;
+
+}  // namespace
+
+TEST(PrimesTest, SieveMatchesNaiveSieve) {
+    const std::vector<u64> naive = NaivePrimes(3'000'000);
+    // Below the wheel, around its period of 30, and around the segments of 32 KiB * 30 numbers.
+    for (const u64 limit : {0, 1, 2, 3, 4, 5, 7, 8, 29, 30, 31, 32, 1000, 983'039, 983'040, 983'041,
+                            1'966'081, 3'000'000}) {
+        const std::vector<u64> expected(naive.begin(), absl::c_lower_bound(naive, limit));
+        EXPECT_EQ(aoc::primes::SievePrimes(limit), expected) << "limit " << limit;
+        EXPECT_EQ(aoc::primes::Primes(limit), expected) << "limit " << limit;
+    }
+}
+
+TEST(PrimesTest, CachedSieveShrinksAndGrows) {
+    const std::vector<u64> naive = NaivePrimes(5'000'000);
+    for (const u64 limit : {5'000'000, 100, 4'999'999, 77}) {
+        const std::vector<u64> expected(naive.begin(), absl::c_lower_bound(naive, limit));
+        EXPECT_EQ(aoc::primes::Primes(limit), expected) << "limit " << limit;
+    }
+}
+
+TEST(PrimesTest, IsPrimeMatchesTrialDivision) {
+    for (u64 n = 0; n < 100'000; n++) EXPECT_EQ(aoc::primes::IsPrime(n), NaiveIsPrime(n)) << n;
+    // Past any sieve the other tests build, so these go through Miller-Rabin.
+    for (u64 n = (u64{1} << 40) - 2000; n < (u64{1} << 40); n++) {
+        EXPECT_EQ(aoc::primes::IsPrime(n), NaiveIsPrime(n)) << n;
+    }
+}
+
+TEST(PrimesTest, IsPrimeOnPseudoprimes) {
+    // Carmichael numbers, which fool every Fermat test with a base coprime to them.
+    for (const u64 n : {561, 1105, 1729, 2465, 2821, 6601, 8911, 41041, 825265}) {
+        EXPECT_FALSE(aoc::primes::IsPrime(n)) << n;
+        EXPECT_FALSE(NaiveIsPrime(n)) << n;
+    }
+    // Strong pseudoprimes: to bases 2, 3, 5 and 7; to every prime base up to 23; to 2 and 3.
+    EXPECT_FALSE(aoc::primes::IsPrime(3215031751));
+    EXPECT_FALSE(aoc::primes::IsPrime(3825123056546413051));
+    EXPECT_FALSE(aoc::primes::IsPrime(1373653));
+    // A square of a prime, and a square and a product of the primes just below 2^32.
+    EXPECT_FALSE(aoc::primes::IsPrime(1009 * 1009));
+    EXPECT_FALSE(aoc::primes::IsPrime(kPrime32a * kPrime32a));
+    EXPECT_FALSE(aoc::primes::IsPrime(kPrime32a * kPrime32b));
+    EXPECT_TRUE(aoc::primes::IsPrime(kPrime32a));
+    EXPECT_TRUE(aoc::primes::IsPrime(kPrime32b));
+    EXPECT_TRUE(aoc::primes::IsPrime(kPrime64));
+    EXPECT_FALSE(aoc::primes::IsPrime(kPrime64 + 2));
+    EXPECT_FALSE(aoc::primes::IsPrime(std::numeric_limits<u64>::max()));
+}
+
+TEST(PrimesTest, FactorizeSmallNumbers) {
+    EXPECT_EQ(aoc::primes::Factorize(0), Factors{});
+    EXPECT_EQ(aoc::primes::Factorize(1), Factors{});
+    EXPECT_EQ(aoc::primes::Factorize(2), (Factors{{2, 1}}));
+    EXPECT_EQ(aoc::primes::Factorize(1024), (Factors{{2, 10}}));
+    EXPECT_EQ(aoc::primes::Factorize(561), (Factors{{3, 1}, {11, 1}, {17, 1}}));
+    for (u64 n = 2; n < 20'000; n++) EXPECT_EQ(aoc::primes::Factorize(n), NaiveFactorize(n)) << n;
+}
+
+TEST(PrimesTest, FactorizeMatchesTrialDivision) {
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 200; i++) {
+        const u64 n = rng() >> (24 + rng() % 20);
+        EXPECT_EQ(aoc::primes::Factorize(n), NaiveFactorize(n)) << n;
+    }
+}
+
+TEST(PrimesTest, FactorizeHardNumbers) {
+    // Squares and cubes of primes just past the trial division, which Pollard's rho has to split.
+    EXPECT_EQ(aoc::primes::Factorize(1009 * 1009), (Factors{{1009, 2}}));
+    EXPECT_EQ(aoc::primes::Factorize(1009 * 1009 * 1009), (Factors{{1009, 3}}));
+    EXPECT_EQ(aoc::primes::Factorize(u64{1'000'003} * 1'000'003 * 2),
+              (Factors{{2, 1}, {1'000'003, 2}}));
+    EXPECT_EQ(aoc::primes::Factorize(kPrime32a * kPrime32a), (Factors{{kPrime32a, 2}}));
+    // Two primes near 2^32, the slowest case for rho.
+    EXPECT_EQ(aoc::primes::Factorize(kPrime32a * kPrime32b),
+              (Factors{{kPrime32b, 1}, {kPrime32a, 1}}));
+    EXPECT_EQ(aoc::primes::Factorize(3825123056546413051),
+              (Factors{{149491, 1}, {747451, 1}, {34233211, 1}}));
+    EXPECT_EQ(aoc::primes::Factorize(kPrime64), (Factors{{kPrime64, 1}}));
+    EXPECT_EQ(aoc::primes::Factorize(std::numeric_limits<u64>::max()),
+              (Factors{{3, 1}, {5, 1}, {17, 1}, {257, 1}, {641, 1}, {65537, 1}, {6700417, 1}}));
+}
+
+// The constants above, checked the slow way where that's quick enough.
+TEST(PrimesTest, TestConstants) {
+    EXPECT_TRUE(NaiveIsPrime(kPrime32a));
+    EXPECT_TRUE(NaiveIsPrime(kPrime32b));
+    EXPECT_TRUE(NaiveIsPrime(1009));
+    EXPECT_TRUE(NaiveIsPrime(1'000'003));
+    for (const u64 p : {149491, 747451, 34233211}) EXPECT_TRUE(NaiveIsPrime(p)) << p;
+    EXPECT_EQ(u64{149491} * 747451 * 34233211, 3825123056546413051u);
+    EXPECT_EQ(NaiveFactorize(3215031751), (Factors{{151, 1}, {751, 1}, {28351, 1}}));
+    EXPECT_EQ(NaiveFactorize(1373653), (Factors{{829, 1}, {1657, 1}}));
+}
@@ -0,0 +1,380 @@
+#include "aoc_tests.h"
+
+#include <aoc_search.h>
+
+#include <queue>
+#include <random>
+
+namespace {
+
+using aoc::search::Cost;
+using aoc::search::kUnreachable;
+using aoc::search::State;
+
+// Edges out of every state key, the way the searches number them.
+using Graph = std::vector<std::vector<std::pair<u32, Cost>>>;
+
+// A maze whose cells cost 1 to 9 to enter, with about one in five a wall (0), walled in by the
+// border.
+aoc::Grid<int> RandomMaze(const i64 height, const i64 width, const u32 seed) {
+    std::mt19937 rng(seed);
+    aoc::Grid<int> maze(height, width, 0, 1, 0);
+    for (i64 i = 0; i < height; i++) {
+        for (i64 j = 0; j < width; j++) maze[aoc::Pos(i, j)] = rng() % 5 == 0 ? 0 : 1 + rng() % 9;
+    }
+    return maze;
+}
+
+// Steps to the open neighbours of a cell, at the cost of entering them.
+auto Steps(const aoc::Grid<int>& maze) {
+    return [&maze](const State& from, auto&& edge) {
+        for (const i64 offset : maze.Offsets()) {
+            const i64 to = from.index + offset;
+            if (maze[to] > 0) edge(State{to}, static_cast<Cost>(maze[to]));
+        }
+    };
+}
+
+// The moves of a reindeer in 2024/16: a step ahead costs 1 and a quarter turn 1000.
+auto ReindeerMoves(const aoc::Grid<int>& maze) {
+    return [&maze](const State& from, auto&& edge) {
+        const aoc::Dir dir = aoc::kAllDirs[from.dir];
+        const i64 ahead = from.index + maze.Offset(dir);
+        if (maze[ahead] > 0) edge(State{ahead, from.dir}, 1);
+        edge(State{from.index, aoc::DirIndex(aoc::TurnLeft(dir))}, 1000);
+        edge(State{from.index, aoc::DirIndex(aoc::TurnRight(dir))}, 1000);
+    };
+}
+
+// Collects the edges out of every state of an open cell of `maze`.
+template<u32 NDirs, typename Neighbours>
+Graph ToGraph(const aoc::Grid<int>& maze, Neighbours&& neighbours) {
+    Graph graph(maze.Size() * NDirs);
+    for (i64 index = 0; index < maze.Size(); index++) {
+        if (maze[index] <= 0) continue;
+        for (u32 dir = 0; dir < NDirs; dir++) {
+            neighbours(State{index, dir}, [&](const State& to, const Cost weight) {
+                graph[index * NDirs + dir].emplace_back(to.index * NDirs + to.dir, weight);
+            });
+        }
+    }
+    return graph;
+}
+
+Graph Reversed(const Graph& graph) {
+    Graph reversed(graph.size());
+    for (u32 from = 0; from < graph.size(); from++) {
+        for (const auto& [to, weight] : graph[from]) reversed[to].emplace_back(from, weight);
+    }
+    return reversed;
+}
+
+// Dijkstra without a queue: settles the closest unsettled key in a linear scan, O(V^2).
+std::vector<Cost> NaiveDistances(const Graph& graph, const std::vector<u32>& sources) {
+    std::vector<Cost> distance(graph.size(), kUnreachable);
+    std::vector<bool> settled(graph.size(), false);
+    for (const u32 source : sources) distance[source] = 0;
+    while (true) {
+        u32 best = 0;
+        Cost best_distance = kUnreachable;
+        for (u32 key = 0; key < graph.size(); key++) {
+            if (settled[key] || distance[key] >= best_distance) continue;
+            best = key;
+            best_distance = distance[key];
+        }
+        if (best_distance == kUnreachable) return distance;
+        settled[best] = true;
+        for (const auto& [to, weight] : graph[best]) {
+            distance[to] = std::min(distance[to], best_distance + weight);
+        }
+    }
+}
+
+// Stops a search at the cell `index`.
+auto At(const i64 index) {
+    return [index](const State& state) { return state.index == index; };
+}
+
+// Some open cell of `maze`.
+i64 RandomOpenCell(const aoc::Grid<int>& maze, std::mt19937& rng) {
+    while (true) {
+        const i64 index = maze.Index(rng() % maze.Height(), rng() % maze.Width());
+        if (maze[index] > 0) return index;
+    }
+}
+
+}  // namespace
+
+TEST(RadixHeapTest, PopsInKeyOrder) {
+    std::mt19937 rng(1);
+    aoc::search::RadixHeap<int> heap;
+    using Entry = std::pair<Cost, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> expected;
+    Cost last = 0;
+    for (int i = 0; i < 100'000; i++) {
+        if (rng() % 3 != 0 || expected.empty()) {
+            // Mostly near the last popped key, sometimes anywhere up to the largest one.
+            const Cost key = last + (rng() % 10 != 0 ? rng() % 100 : rng() % (kUnreachable - last));
+            heap.Push(key, i);
+            expected.emplace(key, i);
+        } else {
+            const Cost key = heap.Pop().first;
+            // Equal keys may come out in any order, so only the keys have to match.
+            EXPECT_EQ(key, expected.top().first);
+            last = key;
+            expected.pop();
+        }
+        ASSERT_EQ(heap.Size(), static_cast<i64>(expected.size()));
+    }
+    std::vector<int> values;
+    while (!heap.Empty()) {
+        const auto [key, value] = heap.Pop();
+        EXPECT_EQ(key, expected.top().first);
+        expected.pop();
+        values.push_back(value);
+    }
+    EXPECT_TRUE(expected.empty());
+    // No value comes out twice.
+    EXPECT_EQ(values.size(), absl::flat_hash_set<int>(values.begin(), values.end()).size());
+}
+
+TEST(RadixHeapTest, PopsEveryValueOfTiedKeys) {
+    aoc::search::RadixHeap<int> heap;
+    for (int value = 0; value < 5; value++) heap.Push(7, value);
+    heap.Push(kUnreachable, 5);
+    heap.Push(0, 6);
+    EXPECT_EQ(heap.Pop(), (std::pair<Cost, int>(0, 6)));
+    std::vector<int> values;
+    for (int i = 0; i < 5; i++) {
+        const auto [key, value] = heap.Pop();
+        EXPECT_EQ(key, 7);
+        values.push_back(value);
+    }
+    absl::c_sort(values);
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(heap.Pop(), (std::pair<Cost, int>(kUnreachable, 5)));
+    EXPECT_TRUE(heap.Empty());
+}
+
+TEST(RadixHeapTest, ClearStartsOverFromZero) {
+    aoc::search::RadixHeap<int> heap;
+    heap.Push(1000, 1);
+    heap.Push(2000, 2);
+    EXPECT_EQ(heap.Pop().first, 1000);
+    heap.Clear();
+    EXPECT_TRUE(heap.Empty());
+    EXPECT_EQ(heap.Size(), 0);
+    // Below the last key popped before the Clear().
+    heap.Push(5, 3);
+    EXPECT_EQ(heap.Pop(), (std::pair<Cost, int>(5, 3)));
+    EXPECT_TRUE(heap.Empty());
+}
+
+TEST(RadixHeapDeathTest, RejectsKeysBelowTheLastPopped) {
+    aoc::search::RadixHeap<int> heap;
+    heap.Push(10, 0);
+    heap.Pop();
+    EXPECT_DEBUG_DEATH(heap.Push(9, 1), "below the last popped");
+}
+
+TEST(ShortestPathsTest, DijkstraMatchesNaiveDijkstra) {
+    std::mt19937 rng(1);
+    // One search for every maze, reset by each Run.
+    aoc::search::ShortestPaths<> search(RandomMaze(20, 30, 0).Size());
+    for (u32 seed = 0; seed < 20; seed++) {
+        const aoc::Grid<int> maze = RandomMaze(20, 30, seed);
+        const Graph graph = ToGraph<1>(maze, Steps(maze));
+        const i64 a = RandomOpenCell(maze, rng), b = RandomOpenCell(maze, rng);
+        // Exhaustive searches don't stop anywhere.
+        EXPECT_EQ(search.Run({{a}}, Steps(maze)), kUnreachable);
+        std::vector<Cost> expected = NaiveDistances(graph, {static_cast<u32>(a)});
+        for (i64 index = 0; index < maze.Size(); index++) {
+            ASSERT_EQ(search.Distance({index}), expected[index]) << seed << " at " << index;
+        }
+        search.Run({{a}, {b}}, Steps(maze));
+        expected = NaiveDistances(graph, {static_cast<u32>(a), static_cast<u32>(b)});
+        for (i64 index = 0; index < maze.Size(); index++) {
+            ASSERT_EQ(search.Distance({index}), expected[index]) << seed << " at " << index;
+        }
+    }
+}
+
+TEST(ShortestPathsTest, StopsAtATarget) {
+    std::mt19937 rng(2);
+    const aoc::Grid<int> maze = RandomMaze(30, 30, 1);
+    const Graph graph = ToGraph<1>(maze, Steps(maze));
+    aoc::search::ShortestPaths<> search(maze.Size());
+    for (int i = 0; i < 20; i++) {
+        const i64 source = RandomOpenCell(maze, rng), target = RandomOpenCell(maze, rng);
+        const Cost expected = NaiveDistances(graph, {static_cast<u32>(source)})[target];
+        const Cost distance = search.Run({{source}}, Steps(maze), At(target));
+        EXPECT_EQ(distance, expected);
+        EXPECT_EQ(search.Distance({target}), expected);
+    }
+    // A target walled in is never settled, and a source is settled first.
+    aoc::Grid<int> walled = maze;
+    const i64 target = walled.Index(15, 15);
+    for (const i64 offset : walled.Offsets()) walled[target + offset] = 0;
+    walled[target] = 1;
+    const i64 source = RandomOpenCell(walled, rng);
+    EXPECT_EQ(search.Run({{source}}, Steps(walled), At(target)), kUnreachable);
+    EXPECT_EQ(search.Distance({target}), kUnreachable);
+    EXPECT_EQ(search.Run({{source}}, Steps(walled), At(source)), 0);
+}
+
+TEST(ShortestPathsTest, AStarMatchesDijkstra) {
+    std::mt19937 rng(3);
+    const aoc::Grid<int> maze = RandomMaze(40, 40, 2);
+    const Graph graph = ToGraph<1>(maze, Steps(maze));
+    aoc::search::ShortestPaths<> search(maze.Size());
+    for (int i = 0; i < 20; i++) {
+        const i64 source = RandomOpenCell(maze, rng), target = RandomOpenCell(maze, rng);
+        const aoc::Pos goal = maze.ToPos(target);
+        // Every step costs at least 1, so the Manhattan distance is consistent.
+        const auto heuristic = [&](const State& state) {
+            const aoc::Pos pos = maze.ToPos(state.index);
+            return static_cast<Cost>(std::abs(goal.i - pos.i) + std::abs(goal.j - pos.j));
+        };
+        const Cost distance = search.Run({{source}}, Steps(maze), At(target), heuristic);
+        EXPECT_EQ(distance, NaiveDistances(graph, {static_cast<u32>(source)})[target]);
+    }
+}
+
+TEST(ShortestPathsTest, StatesWithDirections) {
+    const aoc::Grid<int> maze = RandomMaze(15, 15, 3);
+    const Graph graph = ToGraph<4>(maze, ReindeerMoves(maze));
+    const i64 start = maze.Index(14, 0);
+    aoc::search::ShortestPaths<4> search(maze.Size());
+    search.Run({{start, aoc::DirIndex(aoc::Dir::E)}}, ReindeerMoves(maze));
+    const std::vector<Cost> expected = NaiveDistances(graph, {static_cast<u32>(start * 4 + 1)});
+    for (i64 index = 0; index < maze.Size(); index++) {
+        for (u32 d = 0; d < aoc::kAllDirs.size(); d++) {
+            EXPECT_EQ(search.Distance({index, d}), expected[index * 4 + d]) << index << ' ' << d;
+            EXPECT_EQ(search.Distance(index, aoc::kAllDirs[d]), expected[index * 4 + d]);
+        }
+    }
+    EXPECT_EQ(search.Distance(start, aoc::Dir::E), 0);
+    EXPECT_EQ(search.Distance(start, aoc::Dir::S), 1000);
+    EXPECT_EQ(search.Distance(start, aoc::Dir::W), 2000);
+}
+
+TEST(ShortestPathsTest, BfsMatchesNaiveDijkstra) {
+    std::mt19937 rng(4);
+    // The maze without the costs: every open cell costs 1 to enter.
+    aoc::Grid<int> maze = RandomMaze(30, 40, 4);
+    for (i64 index = 0; index < maze.Size(); index++) maze[index] = std::min(maze[index], 1);
+    const Graph graph = ToGraph<1>(maze, Steps(maze));
+    aoc::search::ShortestPaths<> search(maze.Size());
+    for (int i = 0; i < 10; i++) {
+        const i64 a = RandomOpenCell(maze, rng), b = RandomOpenCell(maze, rng);
+        EXPECT_EQ(search.Bfs({{a}, {b}}, Steps(maze)), kUnreachable);
+        const std::vector<Cost> expected =
+            NaiveDistances(graph, {static_cast<u32>(a), static_cast<u32>(b)});
+        for (i64 index = 0; index < maze.Size(); index++) {
+            ASSERT_EQ(search.Distance({index}), expected[index]);
+        }
+        const Cost distance = search.Bfs({{a}}, Steps(maze), At(b));
+        EXPECT_EQ(distance, NaiveDistances(graph, {static_cast<u32>(a)})[b]);
+    }
+}
+
+TEST(ShortestPathsTest, ReusedSearchesForgetTheLastRun) {
+    // Two rooms with a wall between them.
+    aoc::Grid<int> maze(5, 11, 1, 1, 0);
+    for (i64 i = 0; i < 5; i++) maze[aoc::Pos(i, 5)] = 0;
+    const i64 left = maze.Index(2, 0), right = maze.Index(2, 10);
+    aoc::search::ShortestPaths<1, aoc::search::Record::kAllPaths> search(maze.Size());
+    search.Run({{left}}, Steps(maze));
+    EXPECT_EQ(search.Distance({maze.Index(4, 4)}), 6);
+    EXPECT_EQ(search.Distance({right}), kUnreachable);
+    search.Bfs({{right}}, Steps(maze));
+    EXPECT_EQ(search.Distance({maze.Index(4, 4)}), kUnreachable);
+    EXPECT_EQ(search.Distance({left}), kUnreachable);
+    EXPECT_EQ(search.Distance({maze.Index(0, 6)}), 6);
+    // The paths of the first run are gone too.
+    std::vector<i64> visited;
+    search.ForEachOnPaths({{left}}, [&](const State& state) { visited.push_back(state.index); });
+    EXPECT_EQ(visited, std::vector<i64>{left});
+}
+
+TEST(ShortestPathsTest, PathVisitsOneShortestPath) {
+    std::mt19937 rng(5);
+    const aoc::Grid<int> maze = RandomMaze(25, 25, 5);
+    const Graph graph = ToGraph<1>(maze, Steps(maze));
+    aoc::search::ShortestPaths<1, aoc::search::Record::kPath> search(maze.Size());
+    for (int i = 0; i < 20; i++) {
+        const i64 source = RandomOpenCell(maze, rng), target = RandomOpenCell(maze, rng);
+        search.Run({{source}}, Steps(maze));
+        if (search.Distance({target}) == kUnreachable) continue;
+        // From the target back to the source, one tight edge at a time.
+        std::vector<i64> path;
+        search.ForEachOnPaths({{target}}, [&](const State& state) { path.push_back(state.index); });
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), target);
+        EXPECT_EQ(path.back(), source);
+        for (u64 k = 0; k + 1 < path.size(); k++) {
+            EXPECT_EQ(search.Distance({path[k]}), search.Distance({path[k + 1]}) + maze[path[k]]);
+            EXPECT_EQ(absl::c_count(maze.Offsets(), path[k] - path[k + 1]), 1);
+        }
+        // More targets visit every state once, where their paths merge too.
+        const i64 other = RandomOpenCell(maze, rng);
+        absl::flat_hash_map<i64, int> visits;
+        search.ForEachOnPaths({{target}, {other}, {target}},
+                              [&](const State& state) { visits[state.index]++; });
+        for (const i64 index : path) EXPECT_EQ(visits[index], 1);
+        for (const auto& [index, count] : visits) EXPECT_EQ(count, 1) << index;
+    }
+}
+
+TEST(ShortestPathsTest, AllPathsVisitsEveryStateOnAShortestPath) {
+    std::mt19937 rng(6);
+    // Costs of 1 and 2 only, for plenty of ties.
+    aoc::Grid<int> maze = RandomMaze(25, 25, 6);
+    for (i64 index = 0; index < maze.Size(); index++) {
+        if (maze[index] > 0) maze[index] = 1 + maze[index] % 2;
+    }
+    const Graph graph = ToGraph<1>(maze, Steps(maze)), reversed = Reversed(graph);
+    aoc::search::ShortestPaths<1, aoc::search::Record::kAllPaths> search(maze.Size());
+    for (int i = 0; i < 20; i++) {
+        const i64 source = RandomOpenCell(maze, rng);
+        const i64 a = RandomOpenCell(maze, rng), b = RandomOpenCell(maze, rng);
+        search.Run({{source}}, Steps(maze));
+        const std::vector<Cost> from_source = NaiveDistances(graph, {static_cast<u32>(source)});
+        absl::flat_hash_map<i64, int> visits;
+        search.ForEachOnPaths({{a}, {b}}, [&](const State& state) { visits[state.index]++; });
+        // A state is on a shortest path to a target iff the distances through it add up.
+        std::vector<bool> on_path(maze.Size(), false);
+        for (const i64 target : {a, b}) {
+            on_path[target] = true;
+            if (from_source[target] == kUnreachable) continue;
+            const std::vector<Cost> to_target =
+                NaiveDistances(reversed, {static_cast<u32>(target)});
+            for (i64 index = 0; index < maze.Size(); index++) {
+                const Cost from = from_source[index], to = to_target[index];
+                if (from == kUnreachable || to == kUnreachable) continue;
+                if (from + to == from_source[target]) on_path[index] = true;
+            }
+        }
+        for (i64 index = 0; index < maze.Size(); index++) {
+            EXPECT_EQ(visits.contains(index), on_path[index]) << "index " << index;
+        }
+        for (const auto& [index, count] : visits) EXPECT_EQ(count, 1) << index;
+    }
+}
+
+TEST(ShortestPathsTest, AllPathsThroughAnOpenRoom) {
+    // Every cell of an open room is on a shortest path between opposite corners.
+    const aoc::Grid<int> room(6, 9, 1, 1, 0);
+    aoc::search::ShortestPaths<1, aoc::search::Record::kAllPaths> search(room.Size());
+    EXPECT_EQ(search.Run({{room.Index(0, 0)}}, Steps(room), At(room.Index(5, 8))), 13);
+    aoc::GridBitset<> visited(room.Size());
+    search.ForEachOnPaths({{room.Index(5, 8)}}, [&](const State& state) {
+        EXPECT_TRUE(visited.Insert(state.index)) << state.index;
+    });
+    EXPECT_EQ(visited.Count(), 6 * 9);
+    // Only the straight line between two cells of a row.
+    visited.Clear();
+    search.ForEachOnPaths({{room.Index(0, 5)}},
+                          [&](const State& state) { visited.Insert(state.index); });
+    EXPECT_EQ(visited.Count(), 6);
+}
@@ -2,27 +2,15 @@
 #define AOC_TESTS_H
 
 #include <aoc.h>
+#include <aoc_registry.h>
 #include <gtest/gtest.h>
 
-template <typename T>
-class AoCTests : public testing::Test {};
+// One test per registered day: solves the day's own input and checks the recorded answers.
+class AoCTests : public testing::TestWithParam<aoc::RegisteredDay> {};
 
-TYPED_TEST_SUITE_P(AoCTests);
-
-TYPED_TEST_P(AoCTests, ValidateAnswersTest) {
-    static constexpr std::size_t year = TypeParam::first_type::value;
-    static constexpr std::size_t day = TypeParam::second_type::value;
-    advent<year, day> adv;
-    adv.GetInput();
-    const auto result = adv.solve();
-    EXPECT_EQ(std::get<0>(result), adv.PartOne());
-    EXPECT_EQ(std::get<1>(result), adv.PartTwo());
+// "2023_07" for advent<2023, 7>.
+inline std::string DayTestName(const testing::TestParamInfo<aoc::RegisteredDay>& info) {
+    return fmt::format("{}_{:02d}", info.param.year, info.param.day);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(AoCTests, ValidateAnswersTest);
-
-#ifndef TEST_YEAR_DAY
-#define TEST_YEAR_DAY(year, day) std::pair<std::integral_constant<std::size_t, (year)>, std::integral_constant<std::size_t, (day)>>
-#endif // TEST_YEAR_DAY
-
 #endif // AOC_TESTS_H
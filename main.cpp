@@ -1,20 +1,238 @@
 #include "aoc_lib/aoc.h"
+#include "aoc_lib/aoc_parallel.h"
+#include "aoc_lib/aoc_registry.h"
 
-auto main() -> int {
-  constexpr int YEAR{2025};
-
-//  advent<YEAR, 1>().print();
-//  advent<YEAR, 2>().print();
-//  advent<YEAR, 3>().print();
-//  advent<YEAR, 4>().print();
-//  advent<YEAR, 5>().print();
-//  advent<YEAR, 6>().print();
-//  advent<YEAR, 7>().print();
-//  advent<YEAR, 8>().print();
-  advent<YEAR, 9>().print();
-//  advent<YEAR, 10>().print();
-//  advent<YEAR, 11>().print();
-//  advent<YEAR, 12>().print();
+#include <absl/container/btree_set.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/numbers.h>
+
+#include <filesystem>
+
+namespace {
+
+constexpr absl::string_view kDefaultCacheDir = ".aoc_cache";
+// Advent of Code days run from 1 to at most 25.
+constexpr int kLastDay = 25;
+
+using Clock = std::chrono::steady_clock;
+
+struct DayRun {
+  const aoc::RegisteredDay* registered;
+  // Input file to solve, the day's own input when empty.
+  std::string path;
+  std::tuple<std::string, std::string> result;
+  bool cached{false};
+  Clock::duration wall_time{};
+};
+
+void PrintUsage(const char* argv0) {
+  fmt::print(
+      stderr,
+      "Usage: {0} <year> [days] [-j threads] [--no-cache | --refresh-cache] [--cache-dir dir]\n"
+      "       {0} <year> <day> --batch <dir | manifest> [-j threads] [cache options]\n"
+      "  days: comma separated days and ranges, e.g. 1,3,5-9 (default: all registered days)\n"
+      "  --batch: solve every file in dir, or every path listed in manifest (one per line,\n"
+      "           relative to the manifest, '#' starts a comment), and print JSON lines\n"
+      "  --no-cache: neither read nor write cached answers\n"
+      "  --refresh-cache: solve every day again and overwrite its cached answers\n"
+      "  --cache-dir: where answers are cached (default: {1})\n",
+      argv0, kDefaultCacheDir);
+}
+
+// Parses "1,3,5-9" into the registered days of `year` it names, in day order.
+bool ParseDays(const int year, const absl::string_view spec, std::vector<DayRun>& runs) {
+  // Ordered, so the days that aren't compiled in are reported in day order.
+  absl::btree_set<int> days;
+  for (auto part : absl::StrSplit(spec, ',', absl::SkipWhitespace())) {
+    std::vector<absl::string_view> bounds = absl::StrSplit(part, '-');
+    int from, to;
+    if (bounds.size() > 2 || !absl::SimpleAtoi(bounds.front(), &from) ||
+        !absl::SimpleAtoi(bounds.back(), &to) || from < 1 || from > to || to > kLastDay) {
+      fmt::print(stderr, "Invalid day range '{}'.\n", part);
+      return false;
+    }
+    for (int day = from; day <= to; day++) days.insert(day);
+  }
+  for (const auto& registered : aoc::kRegisteredDays) {
+    if (registered.year == year && (spec.empty() || days.contains(registered.day))) {
+      runs.push_back({&registered});
+      days.erase(registered.day);
+    }
+  }
+  for (int day : days) fmt::print(stderr, "{}/{:02d} is not compiled in, skipping.\n", year, day);
+  return true;
+}
+
+// One run of `year`/`day` per input found at `batch`: every regular file of a directory in name
+// order, or every path listed in a manifest file.
+bool ParseBatch(
+    const int year, const absl::string_view day_spec, const std::string& batch,
+    std::vector<DayRun>& runs) {
+  int day;
+  if (!absl::SimpleAtoi(day_spec, &day)) {
+    fmt::print(stderr, "Batch mode takes a single day, got '{}'.\n", day_spec);
+    return false;
+  }
+  const auto registered = absl::c_find_if(aoc::kRegisteredDays, [year, day](const auto& r) {
+    return r.year == year && r.day == day;
+  });
+  if (registered == aoc::kRegisteredDays.end()) {
+    fmt::print(stderr, "{}/{:02d} is not compiled in.\n", year, day);
+    return false;
+  }
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  std::vector<std::string> paths;
+  if (fs::is_directory(batch, ec)) {
+    for (const auto& entry : fs::directory_iterator(batch, ec)) {
+      if (entry.is_regular_file()) paths.push_back(entry.path().string());
+    }
+    absl::c_sort(paths);
+  } else {
+    std::ifstream manifest(batch);
+    if (!manifest.is_open()) {
+      fmt::print(stderr, "Could not open batch '{}'.\n", batch);
+      return false;
+    }
+    const fs::path base = fs::path(batch).parent_path();
+    for (std::string line; std::getline(manifest, line);) {
+      absl::string_view path = absl::StripAsciiWhitespace(line);
+      if (path.empty() || path.starts_with('#')) continue;
+      paths.push_back((base / fs::path(path)).string());
+    }
+  }
+  for (auto& path : paths) {
+    // InputFile::Load CHECKs that the file opens, so one bad path would abort the whole batch.
+    if (!std::ifstream(path).is_open()) {
+      fmt::print(stderr, "Could not open input '{}', skipping.\n", path);
+      continue;
+    }
+    runs.push_back({&*registered, std::move(path)});
+  }
+  return true;
+}
+
+double Millis(const Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string JsonString(const absl::string_view str) {
+  std::string out{'"'};
+  for (char c : str) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  out.push_back('"');
+  return out;
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  int year = 0;
+  std::string days_spec;
+  std::string batch;
+  u32 threads = std::thread::hardware_concurrency();
+  bool use_cache = true;
+  auto cache_mode = aoc::ResultCache::Mode::kUse;
+  std::string cache_dir{kDefaultCacheDir};
+  std::vector<absl::string_view> positional;
+  for (int a = 1; a < argc; a++) {
+    absl::string_view arg = argv[a];
+    if (arg == "-j" && a + 1 < argc) {
+      if (!absl::SimpleAtoi(argv[++a], &threads)) {
+        PrintUsage(argv[0]);
+        return 1;
+      }
+      continue;
+    }
+    if (arg == "--batch" && a + 1 < argc) {
+      batch = argv[++a];
+      continue;
+    }
+    if (arg == "--no-cache") {
+      use_cache = false;
+      continue;
+    }
+    if (arg == "--refresh-cache") {
+      cache_mode = aoc::ResultCache::Mode::kRefresh;
+      continue;
+    }
+    if (arg == "--cache-dir" && a + 1 < argc) {
+      cache_dir = argv[++a];
+      continue;
+    }
+    positional.push_back(arg);
+  }
+  if (positional.empty() || positional.size() > 2 || !absl::SimpleAtoi(positional[0], &year) ||
+      (!batch.empty() && positional.size() != 2)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+  if (positional.size() == 2) days_spec = positional[1];
+
+  std::vector<DayRun> runs;
+  if (!(batch.empty() ? ParseDays(year, days_spec, runs)
+                      : ParseBatch(year, days_spec, batch, runs))) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+  if (runs.empty()) {
+    fmt::print(stderr, "Nothing to solve for {}.\n", year);
+    return 1;
+  }
+
+  std::optional<aoc::ResultCache> cache;
+  if (use_cache) cache.emplace(cache_dir, cache_mode);
+  const aoc::ResultCache* cache_ptr = cache ? &*cache : nullptr;
+
+  auto start = Clock::now();
+  {
+    aoc::parallel::ThreadPool pool(std::min<u32>(threads, runs.size()));
+    for (auto& run : runs) {
+      pool.Submit([&run, cache_ptr] {
+        auto day_start = Clock::now();
+        run.result = run.registered->solve(run.path, cache_ptr, &run.cached);
+        run.wall_time = Clock::now() - day_start;
+      });
+    }
+    pool.Wait();
+  }
+  auto total = Clock::now() - start;
+
+  if (!batch.empty()) {
+    for (const auto& run : runs) {
+      const auto& [part1, part2] = run.result;
+      fmt::print(
+          "{{\"year\":{},\"day\":{},\"input\":{},\"part1\":{},\"part2\":{},\"ms\":{:.3f},"
+          "\"cached\":{}}}\n",
+          run.registered->year, run.registered->day, JsonString(run.path), JsonString(part1),
+          JsonString(part2), Millis(run.wall_time), run.cached);
+    }
+    return 0;
+  }
+
+  Clock::duration sum{};
+  for (const auto& run : runs) {
+    const auto& [part1, part2] = run.result;
+    fmt::print(
+        "{}/{:02d} -> Part 1: {:20}\tPart 2: {:20}\t{:10.3f} ms{}\n", run.registered->year,
+        run.registered->day, part1, part2, Millis(run.wall_time), run.cached ? " (cached)" : "");
+    sum += run.wall_time;
+  }
+  fmt::print(
+      "Total wall time: {:.3f} ms, sum of per-day times: {:.3f} ms ({:.2f}x)\n", Millis(total),
+      Millis(sum), Millis(sum) / Millis(total));
 
   return 0;
-}
\ No newline at end of file
+}